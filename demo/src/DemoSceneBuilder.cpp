@@ -394,7 +394,8 @@ namespace
                                                                       VK_IMAGE_USAGE_SAMPLED_BIT,
                                                                       RenderEngine::TextureState{}.setImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
                                                                       .setPipelineStage(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)
-                                                                      .setAccessFlag(VK_ACCESS_2_SHADER_READ_BIT));
+                                                                      .setAccessFlag(VK_ACCESS_2_SHADER_READ_BIT),
+                                                                      RenderEngine::MemorySubsystem::Volume);
             // TODO remove this and do proper synchronization with render graph
             _device.getStagingArea().synchronizeStagingArea({});
             sync_object.waitFence();
@@ -412,7 +413,8 @@ namespace
                                                               VK_IMAGE_USAGE_SAMPLED_BIT,
                                                               RenderEngine::TextureState{}.setImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
                                                               .setPipelineStage(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)
-                                                              .setAccessFlag(VK_ACCESS_2_SHADER_READ_BIT));
+                                                              .setAccessFlag(VK_ACCESS_2_SHADER_READ_BIT),
+                                                              RenderEngine::MemorySubsystem::Volume);
             // TODO remove this and do proper synchronization with render graph
             _device.getStagingArea().synchronizeStagingArea({});
             sync_object.waitFence();
@@ -7,6 +7,7 @@
 
 #include<DeviceSelector.h>
 
+#include <algorithm>
 #include <format>
 
 void MultiWindowApplication::init()
@@ -30,6 +31,12 @@ void MultiWindowApplication::init()
     _window_3 = RenderEngine::RenderContext::context().getDevice(kSecondaryDeviceIndex).createWindow(std::format("Image Stream Renderer (on device {})", kSecondaryDeviceIndex), 3);
     _window_3->registerRenderers({ RenderEngine::ImageStreamRenderer::kRendererId });
 #endif
+    _update_scheduler = std::make_unique<RenderEngine::WindowUpdateScheduler>(RenderEngine::RenderContext::context().getJobSystem());
+    for (RenderEngine::Window* window : getWindows())
+    {
+        _update_scheduler->addWindow(*window);
+    }
+    _update_scheduler_gui_token = RenderEngine::RenderContext::context().getDebugger().addGuiCallback([this] { _update_scheduler->onGui(); });
 
 #if ENABLE_WINDOW_0
     auto& example_renderer_0 = _window_0->getRendererAs<RenderEngine::ExampleRenderer>(RenderEngine::ExampleRenderer::kRendererId);
@@ -60,6 +67,9 @@ void MultiWindowApplication::init()
 
         example_renderer_1.init(vertices, indices);
         example_renderer_1.getColorOffset().r = 1.f;
+        // Recorded on a worker thread while the UI renderer records its own commands. The renderer draws the color offset
+        // copied at the beginning of the frame, thus the UI callback below can change it meanwhile.
+        example_renderer_1.setParallelRecording(true);
         ui_renderer_1.setOnGui([&]
                                {
                                    float value = example_renderer_1.getColorOffset().r;
@@ -82,24 +92,28 @@ void MultiWindowApplication::run()
     {
         updateImageStream();
 
-        has_open_window = false;
+        // The windows of a device are submitted together, the devices are updated concurrently
+        _update_scheduler->update();
+        has_open_window = std::ranges::any_of(getWindows(), [](const RenderEngine::Window* window) { return window->isClosed() == false; });
+    }
+}
+
+std::vector<RenderEngine::Window*> MultiWindowApplication::getWindows() const
+{
+    std::vector<RenderEngine::Window*> result;
 #if ENABLE_WINDOW_0
-        _window_0->update();
-        has_open_window |= _window_0->isClosed() == false;
+    result.push_back(_window_0.get());
 #endif
 #if ENABLE_WINDOW_1
-        _window_1->update();
-        has_open_window |= _window_1->isClosed() == false;
+    result.push_back(_window_1.get());
 #endif
 #if ENABLE_WINDOW_2
-        _window_2->update();
-        has_open_window |= _window_2->isClosed() == false;
+    result.push_back(_window_2.get());
 #endif
 #if ENABLE_WINDOW_3
-        _window_3->update();
-        has_open_window |= _window_3->isClosed() == false;
+    result.push_back(_window_3.get());
 #endif
-    }
+    return result;
 }
 
 void MultiWindowApplication::initEngine()
@@ -166,7 +180,10 @@ void MultiWindowApplication::updateImageStream()
     {
         // TODO support Depth/Stencil buffer data
         // We assume the image has uint8_t data
-        (*_image_stream) << std::get<std::vector<uint8_t>>(_images[_current_image].getData());
+        const auto& image_data = std::get<std::vector<uint8_t>>(_images[_current_image].getData());
+        std::vector<uint8_t> frame = _image_stream->acquireBuffer(image_data.size());
+        std::ranges::copy(image_data, frame.begin());
+        (*_image_stream) << std::move(frame);
         _last_image_update = now;
         _current_image = (_current_image + 1) % _images.size();
     }
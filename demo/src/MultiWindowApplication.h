@@ -9,6 +9,10 @@
 #include <render_engine/RendererFactory.h>
 #include <render_engine/renderers/ExampleRenderer.h>
 #include <render_engine/renderers/UIRenderer.h>
+#include <render_engine/window/WindowUpdateScheduler.h>
+
+#include <optional>
+#include <vector>
 
 #define ENABLE_WINDOW_0 true
 #define ENABLE_WINDOW_1 true
@@ -29,10 +33,13 @@ private:
     void initEngine();
     void initImages();
     void updateImageStream();
+    std::vector<RenderEngine::Window*> getWindows() const;
     std::unique_ptr<RenderEngine::Window> _window_0;
     std::unique_ptr<RenderEngine::Window> _window_1;
     std::unique_ptr<RenderEngine::Window> _window_2;
     std::unique_ptr<RenderEngine::Window> _window_3;
+    std::unique_ptr<RenderEngine::WindowUpdateScheduler> _update_scheduler;
+    std::optional<RenderEngine::Debugger::GuiCallbackToken> _update_scheduler_gui_token;
     std::unique_ptr<RenderEngine::ImageStream> _image_stream;
     std::vector<RenderEngine::Image> _images;
     size_t _current_image{ 0 };
@@ -1,10 +1,17 @@
 #include "OffScreenTestApplication.h"
 
+#include <render_engine/CommandContext.h>
 #include <render_engine/Device.h>
 #include <render_engine/RenderContext.h>
+#include <render_engine/RenderGraph.h>
 #include <render_engine/renderers/ForwardRenderer.h>
+#include <render_engine/resources/Buffer.h>
+#include <render_engine/synchronization/SyncObject.h>
+#include <render_engine/TransferEngine.h>
 
 #include <DeviceSelector.h>
+
+#include <cassert>
 namespace
 {
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -16,6 +23,7 @@ void OffScreenTestApplication::init()
 
     initializeRenderers();
     createWindow();
+    runRenderGraph();
 
     createScene();
 
@@ -35,10 +43,12 @@ void OffScreenTestApplication::init()
 void OffScreenTestApplication::run()
 {
     auto image_description = _window->getImageStream().getImageDescription();
+    // Kept between the frames: the image stream reuses the buffer of the previous frame
+    std::vector<uint8_t> data;
     while (_window->isClosed() == false)
     {
         _window->update();
-        std::vector<uint8_t> data;
+        data.clear();
         _window->getImageStream() >> data;
         if (data.empty() == false && _save_output)
         {
@@ -108,3 +118,74 @@ void OffScreenTestApplication::createWindow()
 
 }
 
+void OffScreenTestApplication::runRenderGraph()
+{
+    using namespace RenderEngine;
+
+    Device& device = _window->getDevice();
+    LogicalDevice& logical_device = device.getLogicalDevice();
+    auto create_buffer = [&]
+        {
+            return std::make_unique<Buffer>(device.getPhysicalDevice(),
+                                            logical_device,
+                                            device.getMemoryAllocator(),
+                                            BufferInfo{ .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                        .size = 4096,
+                                                        .memory_properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT });
+        };
+    std::unique_ptr<Buffer> cleared_buffer = create_buffer();
+    std::unique_ptr<Buffer> output_buffer = create_buffer();
+    std::unique_ptr<Buffer> unused_buffer = create_buffer();
+
+    // The clear runs on the transfer queue and the copy on the graphics queue, the graph transfers the ownership
+    std::unique_ptr<TransferEngine> transfer_engine = device.createTransferEngine();
+    CommandContext& transfer_context = transfer_engine->getTransferContext();
+    CommandContext& graphics_context = _window->getRenderEngine().getCommandContext();
+
+    const BufferState transfer_read = BufferState{}
+        .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
+        .setAccessFlag(VK_ACCESS_2_TRANSFER_READ_BIT);
+    const BufferState transfer_write = BufferState{}
+        .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
+        .setAccessFlag(VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    auto copy_buffer = [&](VkCommandBuffer command_buffer, const Buffer& source, const Buffer& destination)
+        {
+            VkBufferCopy region{};
+            region.size = destination.getDeviceSize();
+            logical_device->vkCmdCopyBuffer(command_buffer, source.getBuffer(), destination.getBuffer(), 1, &region);
+        };
+
+    RenderGraph render_graph(logical_device);
+    render_graph.addTask("Clear",
+                         transfer_context,
+                         [&](RenderGraph::TaskBuilder& builder) { builder.write(*cleared_buffer, transfer_write.clone()); },
+                         [&](VkCommandBuffer command_buffer)
+                         {
+                             logical_device->vkCmdFillBuffer(command_buffer, cleared_buffer->getBuffer(), 0, VK_WHOLE_SIZE, 0);
+                         });
+    render_graph.addTask("Copy",
+                         graphics_context,
+                         [&](RenderGraph::TaskBuilder& builder)
+                         {
+                             builder.read(*cleared_buffer, transfer_read.clone()).write(*output_buffer, transfer_write.clone());
+                         },
+                         [&](VkCommandBuffer command_buffer) { copy_buffer(command_buffer, *cleared_buffer, *output_buffer); });
+    const RenderGraph::TaskId unused_task = render_graph.addTask("Unused",
+                                                                 transfer_context,
+                                                                 [&](RenderGraph::TaskBuilder& builder)
+                                                                 {
+                                                                     builder.read(*output_buffer, transfer_read.clone()).write(*unused_buffer, transfer_write.clone());
+                                                                 },
+                                                                 [&](VkCommandBuffer command_buffer) { copy_buffer(command_buffer, *output_buffer, *unused_buffer); });
+    render_graph.markAsOutput(*output_buffer);
+    render_graph.compile();
+    assert(render_graph.isCulled(unused_task) && "Nothing uses the result of the unused task");
+
+    // The second execution is recompiled and not waited separately: its clear has to wait for the copy of the first one.
+    // A wrong timeline value would never be signaled and the fence would hang.
+    SyncObject sync_object = SyncObject::CreateWithFence(logical_device, 0);
+    render_graph.execute(SyncOperations{});
+    render_graph.compile();
+    render_graph.execute(SyncOperations{ sync_object.getPrimitives().getFence() });
+    sync_object.waitFence();
+}
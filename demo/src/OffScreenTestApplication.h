@@ -26,6 +26,8 @@ private:
 
     void createWindow();
 
+    void runRenderGraph();
+
     Assets::AssetDatabase _assets;
 
     std::unique_ptr<RenderEngine::OffScreenWindow> _window;
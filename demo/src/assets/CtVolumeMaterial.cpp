@@ -1,6 +1,7 @@
 #include <assets/CtVolumeMaterial.h>
 
 #include <render_engine/assets/Mesh.h>
+#include <render_engine/RenderContext.h>
 #include <render_engine/resources/PushConstantsUpdater.h>
 
 
@@ -120,35 +121,37 @@ namespace Assets
     {
         auto segmentation_callback = [&](uint32_t width, uint32_t height, uint32_t depth, RenderEngine::Image::DataAccessor3D& accessor)
             {
-                for (uint32_t s = 0; s < depth; ++s)
-                {
-                    for (uint32_t v = 0; v < height; ++v)
+                // The slices are written independently
+                auto segment_slice = [&](uint32_t s)
                     {
-                        for (uint32_t u = 0; u < width; ++u)
+                        for (uint32_t v = 0; v < height; ++v)
                         {
-                            glm::vec4 intensity = accessor.getPixel(u, v, s);
-                            glm::vec4 color(0.0f, 0.0f, 0.0f, 0.0f);
-
-                            // skip no gray scale values
-                            if (intensity.r != intensity.g
-                                || intensity.r != intensity.b)
+                            for (uint32_t u = 0; u < width; ++u)
                             {
-                                accessor.setPixel(u, v, s, color);
-                                continue;
-                            }
+                                glm::vec4 intensity = accessor.getPixel(u, v, s);
+                                glm::vec4 color(0.0f, 0.0f, 0.0f, 0.0f);
 
-                            for (const auto& segmentation : _segmentations)
-                            {
+                                // skip no gray scale values
+                                if (intensity.r != intensity.g
+                                    || intensity.r != intensity.b)
+                                {
+                                    accessor.setPixel(u, v, s, color);
+                                    continue;
+                                }
 
-                                if (intensity.r > segmentation.threshold)
+                                for (const auto& segmentation : _segmentations)
                                 {
-                                    color = segmentation.color * 255.0f;
+
+                                    if (intensity.r > segmentation.threshold)
+                                    {
+                                        color = segmentation.color * 255.0f;
+                                    }
                                 }
+                                accessor.setPixel(u, v, s, color);
                             }
-                            accessor.setPixel(u, v, s, color);
                         }
-                    }
-                }
+                    };
+                RenderEngine::RenderContext::context().getJobSystem().parallelFor(depth, segment_slice);
             };
         image->processData(RenderEngine::ImageProcessor{ std::move(segmentation_callback) });
     }
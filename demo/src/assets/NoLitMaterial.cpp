@@ -74,14 +74,14 @@ namespace Assets
                 }
             };
 
-        auto on_draw = [material_constants = &result->_material_constants, scene](MaterialInstance::UpdateContext& update_context, const MeshInstance* mesh)
+        auto on_draw = [scene](MaterialInstance::UpdateContext& update_context, const MeshInstance* mesh)
             {
                 auto model = scene->getNodeLookup().findMesh(mesh->getId())->getTransformation().calculateTransformation();
                 auto view = scene->getActiveCamera()->getView();
-                material_constants->vertex_values.model_view = view * model;
+                const glm::mat4 model_view = view * model;
 
                 {
-                    const std::span<const uint8_t> data_view(reinterpret_cast<const uint8_t*>(&material_constants->vertex_values.model_view), sizeof(material_constants->vertex_values.model_view));
+                    const std::span<const uint8_t> data_view(reinterpret_cast<const uint8_t*>(&model_view), sizeof(model_view));
                     update_context.getPushConstantUpdater().update(VK_SHADER_STAGE_VERTEX_BIT, offsetof(VertexPushConstants, model_view), data_view);
                 }
             };
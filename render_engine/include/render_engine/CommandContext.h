@@ -6,10 +6,14 @@
 #include <render_engine/LogicalDevice.h>
 
 #include <cassert>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <vector>
 namespace RenderEngine
 {
+    class SyncOperations;
+
     class CommandContext : public std::enable_shared_from_this<CommandContext>
     {
         struct CreationToken
@@ -20,6 +24,13 @@ namespace RenderEngine
             SingleSubmit = 0,
             MultipleSubmit
         };
+
+        struct CommandBufferStatistics
+        {
+            uint64_t allocated_count{ 0 };
+            uint64_t in_flight_count{ 0 };
+            uint64_t recycled_count{ 0 };
+        };
         static std::shared_ptr<CommandContext> create(LogicalDevice& logical_device,
                                                       uint32_t queue_family_index,
                                                       DeviceLookup::QueueFamilyInfo queue_family_info)
@@ -41,8 +52,35 @@ namespace RenderEngine
         ~CommandContext();
         VkQueue getQueue() const;
         uint32_t getQueueFamilyIndex() const { return _queue_family_index; }
-        VkCommandBuffer createCommandBuffer(Usage usage) const;
-        std::vector<VkCommandBuffer> createCommandBuffers(uint32_t count, Usage usage) const;
+        /**
+        * SingleSubmit command buffers are taken from a pool of the context. They have to be submitted with submit().
+        * When their submission is finished they are given back to the pool and can be returned again by this function.
+        */
+        VkCommandBuffer createCommandBuffer(Usage usage);
+        std::vector<VkCommandBuffer> createCommandBuffers(uint32_t count, Usage usage);
+        /**
+        * Secondary command buffers are allocated like the MultipleSubmit ones, they can be reset and recorded again.
+        */
+        std::vector<VkCommandBuffer> createSecondaryCommandBuffers(uint32_t count);
+
+        /**
+        * Submits a SingleSubmit command buffer. On top of the sync operations it signals the timeline semaphore
+        * of the context which tells when the command buffer can be recycled.
+        */
+        void submit(VkCommandBuffer command_buffer, const SyncOperations& sync_operations);
+        /**
+        * Gives back a SingleSubmit command buffer which is not going to be submitted, e.g. because its recording failed.
+        * Every acquired command buffer has to be either submitted or abandoned, otherwise the transient pool is never reset.
+        */
+        void abandon(VkCommandBuffer command_buffer);
+
+        /**
+        * Gives back the finished command buffers to the pool. When no command buffer is in use the whole transient pool is reset.
+        * It is expected to be called once per frame.
+        */
+        void recycleCommandBuffers();
+
+        const CommandBufferStatistics& getCommandBufferStatistics() const { return _command_buffer_statistics; }
 
         std::shared_ptr<CommandContext> clone() const;
 
@@ -72,11 +110,26 @@ namespace RenderEngine
             return VK_NULL_HANDLE;
         }
 
+        struct InFlightCommandBuffer
+        {
+            VkCommandBuffer command_buffer{ VK_NULL_HANDLE };
+            uint64_t finish_value{ 0 };
+        };
+
+        VkCommandBuffer acquireSingleSubmitCommandBuffer();
+
         LogicalDevice* _logical_device{ nullptr };
         uint32_t _queue_family_index{ 0 };
         VkQueue _queue{ VK_NULL_HANDLE };
         VkCommandPool _transient_command_pool{ VK_NULL_HANDLE };
         VkCommandPool _command_pool{ VK_NULL_HANDLE };
         DeviceLookup::QueueFamilyInfo _queue_family_info;
+
+        VkSemaphore _submit_timeline{ VK_NULL_HANDLE };
+        uint64_t _submit_counter{ 0 };
+        std::vector<VkCommandBuffer> _free_command_buffers;
+        std::vector<VkCommandBuffer> _recording_command_buffers;
+        std::deque<InFlightCommandBuffer> _in_flight_command_buffers;
+        CommandBufferStatistics _command_buffer_statistics;
     };
 }
@@ -1,19 +1,26 @@
 #pragma once
 
+#include <render_engine/assets/Image.h>
+#include <render_engine/memory/StagingRingBuffer.h>
+#include <render_engine/synchronization/ResourceStates.h>
 #include <render_engine/synchronization/SyncOperations.h>
+#include <render_engine/synchronization/SyncPrimitives.h>
 
 #include <future>
+#include <memory>
 #include <span>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 namespace RenderEngine
 {
     class Buffer;
     class Texture;
-    struct TextureState;
-    struct BufferState;
-    class Image;
     class UploadTask;
     class DownloadTask;
+    class DataTransferBatch;
+    class DeviceMemoryAllocator;
+    class LogicalDevice;
     class CommandContext;
     class SyncOperations;
     class TransferEngine;
@@ -23,11 +30,32 @@ namespace RenderEngine
     public:
         static const std::string kDataTransferFinishSemaphoreName;
 
+        DataTransferScheduler(VkPhysicalDevice physical_device,
+                              LogicalDevice& logical_device,
+                              DeviceMemoryAllocator& memory_allocator,
+                              VkDeviceSize upload_ring_size,
+                              VkDeviceSize download_ring_size);
         ~DataTransferScheduler();
 
+        DataTransferScheduler(DataTransferScheduler&&) = delete;
+        DataTransferScheduler(const DataTransferScheduler&) = delete;
+
+        DataTransferScheduler& operator=(DataTransferScheduler&&) = delete;
+        DataTransferScheduler& operator=(const DataTransferScheduler&) = delete;
+
         // TODO: Remove final parameter. RenderGraph should be control that dependency
         std::weak_ptr<UploadTask> upload(Texture* texture,
-                                         Image image,
+                                         const Image& image,
+                                         CommandContext& dst_context,
+                                         TextureState final_state,
+                                         SyncOperations sync_operations = {});
+        /**
+        * Uploads only the given regions of a 2D image. The regions must not overlap.
+        * When the texture has a pending upload the whole image is uploaded instead.
+        */
+        std::weak_ptr<UploadTask> upload(Texture* texture,
+                                         const Image& image,
+                                         std::span<const VkRect2D> regions,
                                          CommandContext& dst_context,
                                          TextureState final_state,
                                          SyncOperations sync_operations = {});
@@ -55,21 +83,60 @@ namespace RenderEngine
         std::weak_ptr<DownloadTask> download(Texture* texture,
                                              SyncOperations sync_operations = {});
 
+        /**
+        * Executes every scheduled upload and download in one batch. The copies are recorded into one transfer command buffer,
+        * queue family ownership transfers are merged per queue family and all the tasks finish on the same timeline value.
+        */
         void executeJobs(SyncOperations sync_operations, TransferEngine& transfer_engine);
+
+        StagingRingBuffer::Statistics getUploadStagingStatistics() const { return _upload_ring->getStatistics(); }
+        StagingRingBuffer::Statistics getDownloadStagingStatistics() const { return _download_ring->getStatistics(); }
     private:
-        /* TODO: Batch upload/download
-        * Instead of storing the tasks it would be enough to store the input parameters.
-        * And than execute the data transfer in one submit for multiple texture/buffer.
-        * It results that multiple texture gonna have a reference to only one task. But it shouldn't be an issue.
-        */
-        template<typename T>
+        struct TextureUploadJob
+        {
+            StagingRingBuffer::Allocation staging_memory;
+            std::vector<VkBufferImageCopy> copy_regions;
+            CommandContext* dst_context{ nullptr };
+            TextureState final_state;
+            SyncOperations sync_operations;
+            std::shared_ptr<UploadTask> task;
+        };
+        struct BufferUploadJob
+        {
+            std::vector<uint8_t> data;
+            CommandContext* dst_context{ nullptr };
+            BufferState final_state;
+            std::shared_ptr<UploadTask> task;
+        };
+        struct DownloadJob
+        {
+            SyncOperations sync_operations;
+            std::shared_ptr<DownloadTask> task;
+        };
+
+        template<typename T, typename UploadJob>
         struct StagingAera
         {
-            std::unordered_map<T*, std::shared_ptr<UploadTask>> uploads;
-            std::unordered_map<T*, std::shared_ptr<DownloadTask>> downloads;
+            std::unordered_map<T*, UploadJob> uploads;
+            std::unordered_map<T*, DownloadJob> downloads;
         };
 
-        StagingAera<Buffer> _buffers_staging_area;
-        StagingAera<Texture> _textures_staging_area;
+        StagingAera<Buffer, BufferUploadJob> _buffers_staging_area;
+        StagingAera<Texture, TextureUploadJob> _textures_staging_area;
+
+        std::weak_ptr<UploadTask> scheduleTextureUpload(Texture* texture,
+                                                        const Image& image,
+                                                        std::span<const VkBufferImageCopy> regions,
+                                                        CommandContext& dst_context,
+                                                        TextureState final_state,
+                                                        SyncOperations sync_operations);
+        void releaseFinishedBatches();
+
+        std::shared_ptr<StagingRingBuffer> _upload_ring;
+        std::shared_ptr<StagingRingBuffer> _download_ring;
+        std::vector<std::shared_ptr<DataTransferBatch>> _ongoing_batches;
+        std::shared_ptr<SyncPrimitives> _transfer_timeline;
+        SemaphoreId _transfer_semaphore;
+        uint64_t _transfer_timeline_value{ 0 };
     };
 }
\ No newline at end of file
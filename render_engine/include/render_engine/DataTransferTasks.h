@@ -1,10 +1,13 @@
 #pragma once
 
-#include <render_engine/synchronization/SyncObject.h>
+#include <render_engine/memory/StagingRingBuffer.h>
 #include <render_engine/synchronization/SyncOperations.h>
-#include <render_engine/TransferEngine.h>
+#include <render_engine/synchronization/SyncPrimitives.h>
 
-#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace RenderEngine
@@ -17,47 +20,66 @@ namespace RenderEngine
         StartToken() = default;
         friend class DataTransferScheduler;
     };
+
+    /**
+    * Result of one DataTransferScheduler::executeJobs call.
+    *
+    * All the tasks that were executed together share this object. The batch is finished when the data transfer timeline
+    * semaphore of the scheduler reaches the finish value. The staging memory of the uploads is given back to the staging ring by the
+    * scheduler after the batch is finished.
+    */
+    class DataTransferBatch
+    {
+    public:
+        DataTransferBatch(std::shared_ptr<SyncPrimitives> transfer_timeline, SemaphoreId transfer_semaphore, uint64_t finish_value);
+        ~DataTransferBatch();
+
+        DataTransferBatch(DataTransferBatch&&) = delete;
+        DataTransferBatch(const DataTransferBatch&) = delete;
+
+        DataTransferBatch& operator=(DataTransferBatch&&) = delete;
+        DataTransferBatch& operator=(const DataTransferBatch&) = delete;
+
+        void storeStagingMemory(StagingRingBuffer::Allocation staging_memory);
+        void releaseStagingMemory();
+
+        SyncOperations getSyncOperations() const;
+        bool isFinished();
+        void wait();
+    private:
+        std::shared_ptr<SyncPrimitives> _transfer_timeline;
+        SemaphoreId _transfer_semaphore;
+        uint64_t _finish_value{ 0 };
+        // Finished downloads can be waited from a readback thread
+        std::atomic<bool> _finished{ false };
+        SyncOperations _sync_operations;
+        std::vector<StagingRingBuffer::Allocation> _staging_memory;
+    };
+
     class UploadTask
     {
     public:
-        class Storage
-        {
-        public:
-            void storeStagingData(VkBuffer buffer, VkDeviceMemory memory, LogicalDevice* logical_device);
-            ~Storage();
-        private:
-            VkBuffer _staging_buffer{ VK_NULL_HANDLE };
-            VkDeviceMemory _staging_memory{ VK_NULL_HANDLE };
-            LogicalDevice* _logical_device{ nullptr };
-        };
-        explicit UploadTask(std::function<std::vector<SyncObject>(SyncOperations sync_operations, TransferEngine& transfer_engine, Storage&)>&& task)
-            : _task(std::move(task))
-        {}
+        UploadTask() = default;
 
         UploadTask(UploadTask&&) = default;
-        UploadTask(const UploadTask&) = default;
+        UploadTask(const UploadTask&) = delete;
 
         UploadTask& operator=(UploadTask&&) = default;
-        UploadTask& operator=(const UploadTask&) = default;
+        UploadTask& operator=(const UploadTask&) = delete;
 
         bool isStarted() const;
         SyncOperations getSyncOperations() const;
-        void start(StartToken, SyncOperations in_operations, TransferEngine& transfer_engine);
+        void start(StartToken, std::shared_ptr<DataTransferBatch> batch);
         bool isFinished();
     private:
-        std::function<std::vector<SyncObject>(SyncOperations sync_operations, TransferEngine& transfer_engine, Storage&)> _task;
-        bool _started{ false };
-        std::vector<SyncObject> _transfer_objects;
-        Storage _storage;
+        std::shared_ptr<DataTransferBatch> _batch;
     };
 
     class DownloadTask
     {
     public:
-        DownloadTask(std::function<std::vector<SyncObject>(SyncOperations sync_operations, TransferEngine& transfer_engine)>&& task,
-                     Texture* texture)
-            : _task(std::move(task))
-            , _texture(texture)
+        explicit DownloadTask(Texture* texture)
+            : _texture(texture)
         {}
 
         DownloadTask(DownloadTask&&) = default;
@@ -69,14 +91,19 @@ namespace RenderEngine
 
         bool isStarted() const;
         Image getImage();
+        /**
+        * Waits for the download and copies the image directly into the destination without any host allocation.
+        * destination_row_pitch is the distance of the rows in bytes in the destination. Zero means tightly packed rows.
+        */
+        void getInto(std::span<uint8_t> destination, size_t destination_row_pitch = 0);
+        size_t getSizeInBytes() const;
         SyncOperations getSyncOperations() const;
-        void start(StartToken, SyncOperations in_operations, TransferEngine& transfer_engine);
+        void start(StartToken, std::shared_ptr<DataTransferBatch> batch, StagingRingBuffer::Allocation staging_memory);
 
     private:
-        std::function<std::vector<SyncObject>(SyncOperations sync_operations, TransferEngine& transfer_engine)> _task;
-        bool _started{ false };
-        std::vector<SyncObject> _transfer_objects;
+        std::shared_ptr<DataTransferBatch> _batch;
+        StagingRingBuffer::Allocation _staging_memory;
         Texture* _texture{ nullptr };
     };
 
-}
\ No newline at end of file
+}
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <format>
 #include <functional>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace RenderEngine
@@ -10,22 +12,33 @@ namespace RenderEngine
     class Debugger
     {
     public:
+        /**
+        * The callback is removed from the debugger when the token is destroyed.
+        */
         class GuiCallbackToken
         {
         public:
-            GuiCallbackToken(Debugger& debugger, std::function<void()> callback)
-                : _debugger(debugger)
-                , _callback(callback)
+            GuiCallbackToken(Debugger& debugger, uint64_t callback_id)
+                : _debugger(&debugger)
+                , _callback_id(callback_id)
             {}
             GuiCallbackToken(const GuiCallbackToken&) = delete;
-            GuiCallbackToken(GuiCallbackToken&&) = default;
+            GuiCallbackToken(GuiCallbackToken&& o) noexcept
+                : _debugger(std::exchange(o._debugger, nullptr))
+                , _callback_id(o._callback_id)
+            {}
 
             GuiCallbackToken& operator=(const GuiCallbackToken&) = delete;
-            GuiCallbackToken& operator=(GuiCallbackToken&&) = default;
+            GuiCallbackToken& operator=(GuiCallbackToken&& o) noexcept
+            {
+                std::swap(_debugger, o._debugger);
+                std::swap(_callback_id, o._callback_id);
+                return *this;
+            }
             ~GuiCallbackToken();
         private:
-            Debugger& _debugger;
-            std::function<void()>& _callback;
+            Debugger* _debugger{ nullptr };
+            uint64_t _callback_id{ 0 };
         };
 
         Debugger() = default;
@@ -46,7 +59,13 @@ namespace RenderEngine
 
         void callGuiCallbacks() const;
     private:
-        void removeCallback(std::function<void()>& callback);
-        std::vector<std::function<void()>> _on_gui_callbacks;
+        struct GuiCallback
+        {
+            uint64_t id{ 0 };
+            std::function<void()> callback;
+        };
+        void removeCallback(uint64_t callback_id);
+        std::vector<GuiCallback> _on_gui_callbacks;
+        uint64_t _next_callback_id{ 0 };
     };
 }
\ No newline at end of file
@@ -24,6 +24,10 @@ namespace RenderEngine
     class TransferEngine;
     class TextureFactory;
     class DataTransferScheduler;
+    class FrameScheduler;
+    class DeviceMemoryAllocator;
+    class MemoryTracker;
+    class TransientResourcePool;
     class LogicalDevice;
     class SyncOperations;
 
@@ -79,7 +83,8 @@ namespace RenderEngine
             StagingArea(std::unique_ptr<TransferEngine> transfer_engine,
                         std::set<uint32_t> queue_family_indexes,
                         VkPhysicalDevice physical_device,
-                        LogicalDevice& logical_device);
+                        LogicalDevice& logical_device,
+                        DeviceMemoryAllocator& memory_allocator);
 
             ~StagingArea();
             DataTransferScheduler& getScheduler() { return *_scheduler; }
@@ -107,7 +112,7 @@ namespace RenderEngine
 
         ~Device();
         std::unique_ptr<Window> createWindow(std::string_view name, uint32_t back_buffer_size);
-        std::unique_ptr<OffScreenWindow> createOffScreenWindow(uint32_t back_buffer_size);
+        std::unique_ptr<OffScreenWindow> createOffScreenWindow(uint32_t back_buffer_size, uint32_t readback_frames_in_flight = 2);
         std::unique_ptr<RenderEngine> createRenderEngine(uint32_t back_buffer_size);
         std::unique_ptr<TransferEngine> createTransferEngine();
 
@@ -117,6 +122,9 @@ namespace RenderEngine
 
         CudaCompute::CudaDevice& getCudaDevice() const { return *_cuda_device; }
         TextureFactory& getTextureFactory() { return _staging_area.getTextureFactory(); }
+        DeviceMemoryAllocator& getMemoryAllocator() { return *_memory_allocator; }
+        MemoryTracker& getMemoryTracker() { return *_memory_tracker; }
+        TransientResourcePool& getTransientResourcePool() { return *_transient_resource_pool; }
 
         bool hasCudaDevice() const { return _cuda_device != nullptr; }
 
@@ -124,6 +132,7 @@ namespace RenderEngine
 
         void synchronizeStagingArea(SyncOperations syncOperations);
         StagingArea& getStagingArea() { return _staging_area; }
+        FrameScheduler& getFrameScheduler() { return *_frame_scheduler; }
     private:
         void destroy() noexcept;
 
@@ -135,7 +144,12 @@ namespace RenderEngine
         uint32_t _queue_family_transfer = 0;
         std::unique_ptr<CudaCompute::CudaDevice> _cuda_device;
         DeviceLookup::DeviceInfo _device_info;
+        // Destroyed after every resource of the device
+        std::unique_ptr<DeviceMemoryAllocator> _memory_allocator;
         StagingArea _staging_area;
+        std::unique_ptr<TransientResourcePool> _transient_resource_pool;
+        std::unique_ptr<MemoryTracker> _memory_tracker;
+        std::unique_ptr<FrameScheduler> _frame_scheduler;
 
     };
 }
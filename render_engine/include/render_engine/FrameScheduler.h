@@ -0,0 +1,90 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/synchronization/SyncOperations.h>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace RenderEngine
+{
+    class Device;
+
+    /**
+    * Collects the draw submissions of the windows of a device and submits them together. While a batch is open the
+    * submissions are held back, submitting the last batch flushes the staging area once and submits every collected
+    * frame with one vkQueueSubmit2 per queue. Outside of a batch every submission is flushed immediately.
+    *
+    * A window must be updated at most once in a batch: its next frame waits for the fence of the previous one.
+    *
+    * A flush without any submission since the previous one does nothing. When a queue fails to submit, the other queues
+    * are still submitted and their callbacks are called, then the error is rethrown. The frames of the failed queue are
+    * dropped and their fences are never signaled, thus the failure is fatal for the windows of that queue.
+    */
+    class FrameScheduler
+    {
+    public:
+        struct Submission
+        {
+            VkQueue queue{ VK_NULL_HANDLE };
+            std::vector<VkCommandBufferSubmitInfo> command_buffers;
+            SyncOperations sync_operations;
+            // Called after the flush submitted the command buffers, e.g. to present the image
+            std::function<void()> on_submitted;
+        };
+
+        /**
+        * A batch is closed by submit, which flushes when it was the last open batch and can throw. Destroying an open
+        * batch, e.g. while unwinding, only releases it: its submissions are flushed by the next flush.
+        */
+        class Batch
+        {
+        public:
+            friend class FrameScheduler;
+
+            ~Batch();
+
+            void submit();
+
+            Batch(Batch&& o) noexcept;
+            Batch(const Batch&) = delete;
+
+            Batch& operator=(Batch&&) = delete;
+            Batch& operator=(const Batch&) = delete;
+        private:
+            explicit Batch(FrameScheduler& scheduler)
+                : _scheduler(&scheduler)
+            {}
+            FrameScheduler* _scheduler{ nullptr };
+        };
+
+        explicit FrameScheduler(Device& device);
+        ~FrameScheduler();
+
+        FrameScheduler(FrameScheduler&&) = delete;
+        FrameScheduler(const FrameScheduler&) = delete;
+
+        FrameScheduler& operator=(FrameScheduler&&) = delete;
+        FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+        [[nodiscard]]
+        Batch createBatch();
+        /**
+        * A submission without command buffers is not submitted, but it still flushes the staging area.
+        */
+        void submit(Submission&& submission);
+        void flush();
+    private:
+        void endBatch(bool flush);
+        void flushLocked(std::unique_lock<std::mutex>& lock);
+
+        Device& _device;
+        std::vector<Submission> _submissions;
+        uint32_t _open_batch_count{ 0 };
+        // Set by every submission, including the ones without command buffers that only flush the staging area
+        bool _staging_area_flush_requested{ false };
+        std::mutex _mutex;
+    };
+}
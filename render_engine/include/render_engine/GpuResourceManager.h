@@ -7,6 +7,9 @@
 #include <stdexcept>
 
 #include <render_engine/LogicalDevice.h>
+#include <render_engine/memory/DeviceMemoryAllocator.h>
+#include <render_engine/memory/UniformRingBuffer.h>
+#include <render_engine/resources/DescriptorAllocator.h>
 
 namespace RenderEngine
 {
@@ -18,24 +21,33 @@ namespace RenderEngine
     public:
         GpuResourceManager(VkPhysicalDevice physical_device,
                            LogicalDevice& logical_device,
-                           uint32_t back_buffer_size,
-                           uint32_t max_num_of_resources);
+                           DeviceMemoryAllocator& memory_allocator,
+                           uint32_t back_buffer_size);
 
         GpuResourceManager(const GpuResourceManager&) = delete;
         GpuResourceManager(GpuResourceManager&&) = delete;
         GpuResourceManager operator=(const GpuResourceManager&) = delete;
         GpuResourceManager operator=(GpuResourceManager&&) = delete;
         ~GpuResourceManager();
-        std::unique_ptr<Buffer> createAttributeBuffer(VkBufferUsageFlags usage, VkDeviceSize size);
-        std::unique_ptr<CoherentBuffer> createUniformBuffer(VkDeviceSize size);
-        VkDescriptorPool getDescriptorPool() { return _descriptor_pool; }
+        /**
+        * Must be called when the previous frame of the back buffer is finished on the GPU.
+        */
+        void onFrameBegin(uint32_t back_buffer_index);
+        std::unique_ptr<Buffer> createAttributeBuffer(VkBufferUsageFlags usage,
+                                                      VkDeviceSize size,
+                                                      MemorySubsystem subsystem = MemorySubsystem::Renderer);
+        std::unique_ptr<CoherentBuffer> createUniformBuffer(VkDeviceSize size, MemorySubsystem subsystem = MemorySubsystem::Renderer);
+        DescriptorAllocator& getDescriptorAllocator() { return _descriptor_allocator; }
+        UniformRingBuffer& getUniformRingBuffer() { return _uniform_ring_buffer; }
         LogicalDevice& getLogicalDevice() const { return _logical_device; }
         VkPhysicalDevice getPhysicalDevice() const { return _physical_device; }
         uint32_t getBackBufferSize() const { return _back_buffer_size; }
     private:
         VkPhysicalDevice _physical_device{ VK_NULL_HANDLE };
         LogicalDevice& _logical_device;
-        VkDescriptorPool _descriptor_pool{ VK_NULL_HANDLE };
+        DeviceMemoryAllocator& _memory_allocator;
         uint32_t _back_buffer_size{ 1 };
+        DescriptorAllocator _descriptor_allocator;
+        UniformRingBuffer _uniform_ring_buffer;
     };
 }
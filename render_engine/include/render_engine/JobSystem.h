@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace RenderEngine
+{
+    /**
+    * Worker threads executing jobs for the engine and the application.
+    *
+    * Every worker has its own deque. The jobs submitted by a worker are pushed to its deque and taken back in LIFO order,
+    * the jobs submitted by other threads go to a shared queue. An idle worker steals the oldest job of the other workers.
+    *
+    * Jobs are grouped by counters. A job can wait for a counter before it starts, a thread can wait for a counter while
+    * it executes other jobs, thus waiting inside a job doesn't block a worker.
+    */
+    class JobSystem
+    {
+    public:
+        using Job = std::function<void()>;
+
+        struct InitializationInfo
+        {
+            // 0 uses every core except the one of the calling thread
+            uint32_t worker_thread_count{ 0 };
+            // Worker i runs only on core i + 1 (modulo the core count), core 0 is left for the calling thread
+            bool pin_worker_threads{ false };
+            // Called on the worker thread when it starts executing jobs (busy) and when it runs out of them (idle)
+            std::function<void(uint32_t worker_index, bool busy)> on_worker_state_changed;
+        };
+
+        struct WorkerStatistics
+        {
+            uint64_t executed_job_count{ 0 };
+            // Jobs taken from the deque of another worker
+            uint64_t stolen_job_count{ 0 };
+            std::chrono::nanoseconds busy_time{ 0 };
+            std::chrono::nanoseconds idle_time{ 0 };
+        };
+
+        /**
+        * Number of the unfinished jobs submitted with it. It must outlive its jobs, e.g. by waiting for it.
+        */
+        class Counter
+        {
+        public:
+            friend class JobSystem;
+
+            Counter() = default;
+
+            Counter(Counter&&) = delete;
+            Counter(const Counter&) = delete;
+
+            Counter& operator=(Counter&&) = delete;
+            Counter& operator=(const Counter&) = delete;
+
+            bool isDone() const { return _value.load() == 0; }
+        private:
+            struct PendingJob
+            {
+                Job job;
+                Counter* counter{ nullptr };
+            };
+            std::atomic<uint32_t> _value{ 0 };
+            std::mutex _mutex;
+            // Jobs waiting for the counter to reach zero
+            std::vector<PendingJob> _dependents;
+            std::exception_ptr _error;
+        };
+
+        explicit JobSystem(InitializationInfo info);
+        ~JobSystem();
+
+        JobSystem(JobSystem&&) = delete;
+        JobSystem(const JobSystem&) = delete;
+
+        JobSystem& operator=(JobSystem&&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+        * The job is counted by counter until it is finished. When dependency is given the job starts only after the
+        * dependency reached zero. The first exception of a job without counter is rethrown by the next wait of any thread.
+        */
+        void submit(Job job, Counter* counter = nullptr, Counter* dependency = nullptr);
+        /**
+        * Executes jobs until the counter reaches zero, it sleeps while there is no job to take. The first exception of the
+        * counted jobs is rethrown, when they didn't throw the kept exception of a job without counter is rethrown.
+        */
+        void wait(Counter& counter);
+        /**
+        * Calls body for every index in [0, count) in jobs of batch_size indexes and waits for them.
+        */
+        void parallelFor(uint32_t count, const std::function<void(uint32_t)>& body, uint32_t batch_size = 1);
+
+        uint32_t getWorkerCount() const { return static_cast<uint32_t>(_workers.size()); }
+        std::vector<WorkerStatistics> getStatistics() const;
+
+        void onGui() const;
+    private:
+        using PendingJob = Counter::PendingJob;
+        // Aligned to avoid false sharing between the workers
+        struct alignas(64) Worker
+        {
+            std::mutex mutex;
+            std::deque<PendingJob> jobs;
+            std::atomic<uint64_t> executed_job_count{ 0 };
+            std::atomic<uint64_t> stolen_job_count{ 0 };
+            std::atomic<int64_t> busy_nanoseconds{ 0 };
+            std::atomic<int64_t> idle_nanoseconds{ 0 };
+            std::thread thread;
+        };
+        static constexpr uint32_t kNotWorker = ~0u;
+
+        void push(PendingJob pending_job);
+        std::optional<PendingJob> take(uint32_t worker_index);
+        void execute(PendingJob& pending_job);
+        void finish(Counter& counter, std::exception_ptr error);
+        void run(uint32_t worker_index);
+        uint32_t getCurrentWorkerIndex() const;
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        std::function<void(uint32_t, bool)> _on_worker_state_changed;
+
+        std::mutex _shared_mutex;
+        std::deque<PendingJob> _shared_jobs;
+
+        // Guards the sleep of the idle workers and of the threads waiting for a counter
+        std::mutex _wake_mutex;
+        std::condition_variable _wake;
+        std::atomic<uint64_t> _queued_job_count{ 0 };
+        bool _stop{ false };
+
+        std::mutex _uncounted_error_mutex;
+        // First exception of the jobs without counter since the last wait that rethrew it
+        std::exception_ptr _uncounted_error;
+    };
+}
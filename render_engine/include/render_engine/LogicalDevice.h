@@ -3,6 +3,9 @@
 #include <volk.h>
 
 #include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace RenderEngine
 {
@@ -25,13 +28,32 @@ namespace RenderEngine
             using std::swap;
             swap(_api, o._api);
             swap(_logical_device, o._logical_device);
+            swap(_queue_locks, o._queue_locks);
             return *this;
         }
 
         VolkDeviceTable* operator->() { return &_api; }
         VkDevice operator*() { return _logical_device; }
+
+        /**
+        * The host access of a queue must be externally synchronized. Every submit and present holds the lock of its queue,
+        * thus the windows of the device can be updated from different threads.
+        */
+        [[nodiscard]]
+        std::unique_lock<std::mutex> lockQueue(VkQueue queue);
+        /**
+        * vkDeviceWaitIdle holding the lock of every queue.
+        */
+        void waitIdle();
     private:
+        struct QueueLocks
+        {
+            std::mutex mutex;
+            std::unordered_map<VkQueue, std::unique_ptr<std::mutex>> queue_mutexes;
+        };
         VkDevice _logical_device{ VK_NULL_HANDLE };
         VolkDeviceTable _api{ };
+        // Kept on the heap, the device is movable
+        std::unique_ptr<QueueLocks> _queue_locks{ std::make_unique<QueueLocks>() };
     };
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <volk.h>
@@ -9,6 +10,7 @@
 #include <render_engine/DeviceLookup.h>
 #include <render_engine/RendererFactory.h>
 #include <render_engine/synchronization/SyncObject.h>
+#include <render_engine/JobSystem.h>
 
 #include <variant>
 
@@ -37,6 +39,7 @@ namespace RenderEngine
             std::vector<std::string> device_extensions;
             VkApplicationInfo app_info{};
             bool enable_validation_layers{ true };
+            JobSystem::InitializationInfo job_system;
         };
         // TODO replace ids to generated UUID
         static constexpr uint32_t kEngineReservedIdStart = UINT_MAX - 1'000'000;
@@ -57,9 +60,15 @@ namespace RenderEngine
 
         [[deprecated("This object is a sign of ownership problem. It's not nice but sometimes a you need a shortcut. "
                      "This is a visible short cut and the goal is that whenever it is used let's remove it soon.")]]
-        void addGarbage(Garbage garbage) { _garbage.emplace_back(std::move(garbage)); }
+        void addGarbage(Garbage garbage)
+        {
+            std::unique_lock lock(_garbage_mutex);
+            _garbage.emplace_back(std::move(garbage));
+        }
+        // Called by every window update, the windows can be updated concurrently
         void clearGarbage();
         Debugger& getDebugger() { return _debugger; }
+        JobSystem& getJobSystem() { return *_job_system; }
     private:
         struct GarbageData
         {
@@ -87,6 +96,9 @@ namespace RenderEngine
         bool _initialized{ false };
         uint32_t _engine_id_counter{ kEngineReservedIdStart };
         std::vector<GarbageData> _garbage;
+        std::mutex _garbage_mutex;
         Debugger _debugger{};
+        std::vector<Debugger::GuiCallbackToken> _debugger_gui_tokens;
+        std::unique_ptr<JobSystem> _job_system;
     };
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <render_engine/CommandContext.h>
 #include <render_engine/Device.h>
+#include <render_engine/FrameScheduler.h>
 #include <render_engine/GpuResourceManager.h>
 #include <render_engine/synchronization/SyncOperations.h>
 #include <render_engine/TransferEngine.h>
@@ -11,7 +12,11 @@
 #include <unordered_map>
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <ranges>
+#include <span>
+#include <vector>
 
 namespace RenderEngine
 {
@@ -25,56 +30,62 @@ namespace RenderEngine
 
         void onFrameBegin(const std::ranges::input_range auto& renderers, uint32_t image_index)
         {
+            _gpu_resource_manager.onFrameBegin(image_index);
             for (auto* renderer : renderers)
             {
                 renderer->onFrameBegin(image_index);
             }
         }
+        /**
+        * Records the draw calls and hands them over to the frame scheduler of the device. on_submitted is called when
+        * the command buffers are submitted, which is deferred while a frame batch of the device is open.
+        * Returns whether any command buffer was recorded.
+        */
         [[nodiscard]]
         bool render(const SyncOperations& sync_operations,
                     const std::ranges::input_range auto& renderers,
-                    uint32_t image_index)
+                    uint32_t image_index,
+                    std::function<void()> on_submitted = {})
         {
-            std::vector<VkCommandBufferSubmitInfo> command_buffer_infos = executeDrawCalls(renderers, image_index);
-            // TODO: Do not synchronize per window draw rather once per all widnow draw. Currently it is necessary to start the uploads properly.
-            _device.getStagingArea().synchronizeStagingArea({});
+            _command_context->recycleCommandBuffers();
+            _transfer_engine.getTransferContext().recycleCommandBuffers();
 
-            auto all_sync_operations = collectSynchronizationOperations(renderers, sync_operations, image_index);
+            std::vector<VkCommandBufferSubmitInfo> command_buffer_infos = executeDrawCalls(renderers, image_index);
+            const bool recorded = command_buffer_infos.empty() == false;
 
-            if (command_buffer_infos.empty() == false)
-            {
-                submitDrawCalls(command_buffer_infos, all_sync_operations);
-                return true;
-            }
-            return false;
+            _device.getFrameScheduler().submit({ .queue = _command_context->getQueue(),
+                                                 .command_buffers = std::move(command_buffer_infos),
+                                                 .sync_operations = collectSynchronizationOperations(renderers, sync_operations, image_index),
+                                                 .on_submitted = recorded ? std::move(on_submitted) : std::function<void()>{} });
+            return recorded;
         }
 
         GpuResourceManager& getGpuResourceManager() { return _gpu_resource_manager; }
         uint32_t getBackBufferSize() const { return _gpu_resource_manager.getBackBufferSize(); }
         TransferEngine& getTransferEngine() { return _transfer_engine; }
         CommandContext& getCommandContext() { return *_command_context; }
+        /**
+        * Time spent recording the draw calls of the last frame on the calling thread, including the wait for the
+        * renderers recording in parallel.
+        */
+        std::chrono::microseconds getLastRecordingTime() const { return _last_recording_time; }
     private:
         std::vector<VkCommandBufferSubmitInfo> executeDrawCalls(const std::ranges::input_range auto& renderers,
                                                                 uint32_t image_index)
         {
-            std::vector<VkCommandBufferSubmitInfo> command_buffers;
+            std::vector<AbstractRenderer*> renderer_list;
             for (AbstractRenderer* drawer : renderers)
             {
-                drawer->draw(image_index);
-                auto current_command_buffers = drawer->getCommandBuffers(image_index);
-                std::ranges::transform(current_command_buffers,
-                                       std::back_inserter(command_buffers),
-                                       [](const auto& command_buffer)
-                                       {
-                                           return VkCommandBufferSubmitInfo{
-                                                               .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
-                                                               .pNext = VK_NULL_HANDLE,
-                                                               .commandBuffer = command_buffer,
-                                                               .deviceMask = 0 };
-                                       });
+                renderer_list.push_back(drawer);
             }
-            return command_buffers;
+            return recordDrawCalls(renderer_list, image_index);
         }
+        /**
+        * The renderers recording in parallel are drawn by the job system of the render context while the rest is drawn
+        * on the calling thread. The command buffers are collected in the order of the renderers.
+        */
+        std::vector<VkCommandBufferSubmitInfo> recordDrawCalls(std::span<AbstractRenderer* const> renderers,
+                                                               uint32_t image_index);
 
         SyncOperations collectSynchronizationOperations(const std::ranges::input_range auto& renderers,
                                                         const SyncOperations& sync_operations,
@@ -83,20 +94,16 @@ namespace RenderEngine
             SyncOperations result = sync_operations;
             for (AbstractRenderer* drawer : renderers)
             {
-                auto renderer_sync_operations = drawer->getSyncOperations(image_index);
-                result = result.createUnionWith(renderer_sync_operations);
+                result.unionWith(drawer->getSyncOperations(image_index));
             }
             return result;
         }
 
-        void submitDrawCalls(const std::vector<VkCommandBufferSubmitInfo>& command_buffers,
-                             const SyncOperations& sync_operations);
-
-
         Device& _device;
         GpuResourceManager _gpu_resource_manager;
         // TODO make borrow_ptr
         std::shared_ptr<CommandContext> _command_context;
         TransferEngine _transfer_engine;
+        std::chrono::microseconds _last_recording_time{ 0 };
     };
 }
\ No newline at end of file
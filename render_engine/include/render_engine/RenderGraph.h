@@ -0,0 +1,186 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/CommandContext.h>
+#include <render_engine/synchronization/ResourceStates.h>
+#include <render_engine/synchronization/SyncOperations.h>
+#include <render_engine/synchronization/SyncPrimitives.h>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace RenderEngine
+{
+    class Buffer;
+    class Texture;
+
+    /**
+    * Graph of tasks that record commands on command contexts. Render, compute and data transfer tasks differ only in the
+    * command context they are recorded on.
+    *
+    * The tasks declare the resources they read and write together with the state they need them in. The order of the
+    * declarations defines the dependencies. The graph culls the tasks which don't contribute to an output or a side effect,
+    * orders the rest topologically and groups the consecutive tasks of a command context into one submission.
+    * The barriers and the queue family ownership transfers are recorded by ResourceStateMachine. The submissions on
+    * different queues are synchronized with one timeline semaphore per queue.
+    *
+    * The dependencies between consecutive executions are also synchronized, thus a resource can be used on different
+    * queue families every execution. Before the first execution the resources must be owned by the queue family of their
+    * first task or by none.
+    */
+    class RenderGraph
+    {
+        struct Task;
+    public:
+        struct TaskId
+        {
+            static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+            uint32_t index{ kInvalidIndex };
+
+            bool isValid() const { return index != kInvalidIndex; }
+            auto operator<=>(const TaskId&) const = default;
+        };
+
+        class TaskBuilder
+        {
+        public:
+            friend class RenderGraph;
+
+            TaskBuilder& read(Texture& texture, TextureState state);
+            TaskBuilder& write(Texture& texture, TextureState state);
+            TaskBuilder& read(Buffer& buffer, BufferState state);
+            TaskBuilder& write(Buffer& buffer, BufferState state);
+            /**
+            * Semaphore operations of the task outside of the graph, e.g. waiting for an upload.
+            */
+            TaskBuilder& addSyncOperations(const SyncOperations& sync_operations);
+            /**
+            * The task is never culled, e.g. when it is read back by the host.
+            */
+            TaskBuilder& setSideEffect();
+        private:
+            TaskBuilder(Task& task, CommandContext& command_context)
+                : _task(task)
+                , _command_context(command_context)
+            {}
+            Task& _task;
+            CommandContext& _command_context;
+        };
+
+        using SetupCallback = std::function<void(TaskBuilder&)>;
+        using RecordCallback = std::function<void(VkCommandBuffer)>;
+
+        explicit RenderGraph(LogicalDevice& logical_device);
+        ~RenderGraph();
+
+        RenderGraph(RenderGraph&&) = delete;
+        RenderGraph(const RenderGraph&) = delete;
+
+        RenderGraph& operator=(RenderGraph&&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        TaskId addTask(std::string name,
+                       CommandContext& command_context,
+                       const SetupCallback& setup,
+                       RecordCallback record);
+        /**
+        * The tasks writing an output and their dependencies are not culled.
+        */
+        void markAsOutput(const Texture& texture);
+        void markAsOutput(const Buffer& buffer);
+
+        void compile();
+        /**
+        * Records and submits the tasks. The wait operations of external_operations are added to the first submission,
+        * the signal operations and the fence to the last one.
+        */
+        void execute(const SyncOperations& external_operations);
+
+        bool isCulled(TaskId task_id) const;
+        std::span<const TaskId> getExecutionOrder() const { return _execution_order; }
+        const std::string& getTaskName(TaskId task_id) const;
+    private:
+        struct TextureAccess
+        {
+            Texture* texture{ nullptr };
+            TextureState state;
+            bool write{ false };
+        };
+        struct BufferAccess
+        {
+            Buffer* buffer{ nullptr };
+            BufferState state;
+            bool write{ false };
+        };
+        struct Task
+        {
+            std::string name;
+            CommandContext* command_context{ nullptr };
+            std::vector<TextureAccess> texture_accesses;
+            std::vector<BufferAccess> buffer_accesses;
+            SyncOperations sync_operations;
+            RecordCallback record;
+            bool side_effect{ false };
+            bool culled{ false };
+        };
+        struct Wait
+        {
+            uint32_t batch_index{ 0 };
+            VkPipelineStageFlags2 stage_mask{ VK_PIPELINE_STAGE_2_NONE };
+            // Every batch of the previous execution on the queue of the batch is waited. The previous execution can
+            // belong to an earlier compilation, thus its batches don't match the current ones.
+            bool previous_execution{ false };
+        };
+        /**
+        * Consecutive tasks of a command context, submitted together.
+        */
+        struct Batch
+        {
+            CommandContext* command_context{ nullptr };
+            uint32_t queue_index{ 0 };
+            // Value of the queue timeline relative to the start of the execution
+            uint64_t timeline_value{ 0 };
+            std::vector<uint32_t> tasks;
+            std::vector<Wait> waits;
+            std::vector<TextureAccess> texture_acquires;
+            std::vector<BufferAccess> buffer_acquires;
+            std::vector<TextureAccess> texture_releases;
+            std::vector<BufferAccess> buffer_releases;
+        };
+        struct QueueTimeline
+        {
+            VkQueue queue{ VK_NULL_HANDLE };
+            SemaphoreId semaphore;
+            // The last value signaled by a submitted batch, 0 before the first execution
+            uint64_t last_signaled_value{ 0 };
+            // The last signaled value when the current execution started
+            uint64_t execution_start_value{ 0 };
+            uint64_t batch_count{ 0 };
+        };
+
+        std::vector<std::vector<uint32_t>> collectDependencies() const;
+        void cullTasks(const std::vector<std::vector<uint32_t>>& dependencies);
+        void sortTasks(const std::vector<std::vector<uint32_t>>& dependencies);
+        void createBatches();
+        void synchronizeBatches();
+        uint32_t getQueueIndex(VkQueue queue);
+        void recordBatch(VkCommandBuffer command_buffer, const Batch& batch);
+
+        LogicalDevice& _logical_device;
+        std::vector<Task> _tasks;
+        std::unordered_set<const void*> _outputs;
+        std::vector<TaskId> _execution_order;
+        std::vector<Batch> _batches;
+        // The timelines are kept between compilations, previous executions can still wait for them
+        SyncPrimitives _sync_primitives;
+        std::vector<QueueTimeline> _queue_timelines;
+        bool _compiled{ false };
+    };
+}
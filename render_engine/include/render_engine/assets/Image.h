@@ -4,6 +4,7 @@
 
 #include <filesystem>
 #include <functional>
+#include <utility>
 #include <variant>
 
 #include <glm/vec4.hpp>
@@ -110,6 +111,18 @@ namespace RenderEngine
             _data = createEmptyData();
         }
 
+        Image(uint32_t width,
+              uint32_t height,
+              uint32_t depth,
+              VkFormat format,
+              RawData data)
+            : _width(width)
+            , _height(height)
+            , _depth(depth)
+            , _format(format)
+            , _data(std::move(data))
+        {}
+
         Image(const Image&) = default;
         Image& operator=(const Image&) = default;
         Image(Image&&) = default;
@@ -125,12 +138,15 @@ namespace RenderEngine
         BufferInfo createBufferInfo() const;
         const RawData& getData() const { return _data; }
         void setData(std::vector<uint8_t> value) { _data = std::move(value); }
+        RawData exchangeData(RawData value) { return std::exchange(_data, std::move(value)); }
         VkDeviceSize getSize() const;
+        VkDeviceSize getSizeInBytes() const;
 
         void processData(const ImageProcessor& image_processor);
         void saveRawDataToFile(const std::filesystem::path& file_path) const;
     private:
         uint32_t getPixelComponentCount() const;
+        uint32_t getPixelComponentSize() const;
         RawData createEmptyData() const;
         uint32_t _width{ 0 };
         uint32_t _height{ 0 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <render_engine/assets/Material.h>
+#include <render_engine/resources/UniformBufferUpdater.h>
 
 namespace RenderEngine
 {
@@ -11,8 +12,10 @@ namespace RenderEngine
         {
         public:
             UpdateContext(PushConstantsUpdater push_constant_updater,
+                          UniformBufferUpdater uniform_buffer_updater,
                           const MaterialInstance& material_instance)
                 : _push_constant_updater(std::move(push_constant_updater))
+                , _uniform_buffer_updater(std::move(uniform_buffer_updater))
                 , _material_instance(material_instance)
             {}
 
@@ -25,9 +28,11 @@ namespace RenderEngine
                 return _material_instance.getMaterial().getFragmentShader().getMetaData();
             }
             PushConstantsUpdater& getPushConstantUpdater() { return _push_constant_updater; }
+            UniformBufferUpdater& getUniformBufferUpdater() { return _uniform_buffer_updater; }
 
         private:
             PushConstantsUpdater _push_constant_updater;
+            UniformBufferUpdater _uniform_buffer_updater;
             const MaterialInstance& _material_instance;
         };
         struct CallbackContainer
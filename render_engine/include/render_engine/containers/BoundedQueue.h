@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace RenderEngine
+{
+    /**
+    * Lock-free queue with a fixed number of preallocated slots (bounded MPMC queue of Dmitry Vyukov).
+    *
+    * Every slot has a sequence number telling whether it can be written or read in the current lap of the ring,
+    * thus the writers and the readers only synchronize on the slot they use. A failed tryPush/tryPop leaves the
+    * value untouched.
+    */
+    template<typename T>
+    class BoundedQueue
+    {
+    public:
+        explicit BoundedQueue(size_t capacity)
+            : _capacity(capacity)
+            , _slots(std::make_unique<Slot[]>(capacity))
+        {
+            assert(_capacity > 0 && "The queue needs at least one slot");
+            for (size_t i = 0; i < _capacity; ++i)
+            {
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue(BoundedQueue&&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(BoundedQueue&&) = delete;
+
+        bool tryPush(T& value)
+        {
+            size_t position = _push_position.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot& slot = _slots[position % _capacity];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+                if (difference == 0)
+                {
+                    if (_push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        slot.value = std::move(value);
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The slot still holds the value of the previous lap
+                    return false;
+                }
+                else
+                {
+                    position = _push_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool tryPop(T& value)
+        {
+            size_t position = _pop_position.load(std::memory_order_relaxed);
+            while (true)
+            {
+                Slot& slot = _slots[position % _capacity];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+                if (difference == 0)
+                {
+                    if (_pop_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    {
+                        value = std::move(slot.value);
+                        slot.sequence.store(position + _capacity, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The slot is not written yet in this lap
+                    return false;
+                }
+                else
+                {
+                    position = _pop_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+        * Only a snapshot when other threads use the queue.
+        */
+        bool isEmpty() const
+        {
+            return _pop_position.load(std::memory_order_acquire) == _push_position.load(std::memory_order_acquire);
+        }
+        size_t getCapacity() const { return _capacity; }
+    private:
+        static constexpr size_t kCacheLineSize = 64;
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence{ 0 };
+            T value;
+        };
+
+        const size_t _capacity{ 0 };
+        std::unique_ptr<Slot[]> _slots;
+        // The positions are on different cache lines to not slow down the writer and the reader of each other
+        alignas(kCacheLineSize) std::atomic<size_t> _push_position{ 0 };
+        alignas(kCacheLineSize) std::atomic<size_t> _pop_position{ 0 };
+    };
+}
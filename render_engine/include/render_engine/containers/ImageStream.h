@@ -1,13 +1,22 @@
 #pragma once
 
-#include <deque>
-#include <iterator>
+#include <render_engine/containers/BoundedQueue.h>
+
+#include <atomic>
+#include <cstdint>
 #include <vector>
 
 #include <volk.h>
 
 namespace RenderEngine
 {
+    /**
+    * Lock-free stream of images between one writer and one reader thread.
+    *
+    * The stream holds at most capacity images. When it is full the writer either drops the oldest image or waits
+    * until the reader takes one out, depending on the overflow policy. The buffers of the images that are read or
+    * dropped go back to the writer through acquireBuffer, thus in steady state the stream doesn't allocate.
+    */
     class ImageStream
     {
     public:
@@ -18,35 +27,123 @@ namespace RenderEngine
             VkFormat format{ VK_FORMAT_UNDEFINED };
         };
 
-        explicit ImageStream(ImageDescription image_description)
+        enum class OverflowPolicy
+        {
+            DropOldest,
+            BackPressure
+        };
+
+        struct Statistics
+        {
+            uint64_t pushed_count{ 0 };
+            uint64_t dropped_count{ 0 };
+        };
+
+        static constexpr size_t kDefaultCapacity = 4;
+
+        explicit ImageStream(ImageDescription image_description,
+                             size_t capacity = kDefaultCapacity,
+                             OverflowPolicy overflow_policy = OverflowPolicy::DropOldest)
             : _image_description(std::move(image_description))
+            , _overflow_policy(overflow_policy)
+            , _images(capacity)
+            // Every image of the ring, the one at the reader and the one at the writer can be recycled
+            , _free_buffers(capacity + 2)
         {
 
         }
+
+        ImageStream(const ImageStream&) = delete;
+        ImageStream(ImageStream&&) = delete;
+        ImageStream& operator=(const ImageStream&) = delete;
+        ImageStream& operator=(ImageStream&&) = delete;
+
+        /**
+        * Writer side.
+        */
         ImageStream& operator<<(std::vector<uint8_t> data)
         {
-            _image_data_container.emplace_back(std::move(data));
+            while (true)
+            {
+                const uint64_t popped_count = _popped_count.load(std::memory_order_acquire);
+                if (_images.tryPush(data))
+                {
+                    break;
+                }
+                if (_overflow_policy == OverflowPolicy::BackPressure)
+                {
+                    _popped_count.wait(popped_count, std::memory_order_acquire);
+                    continue;
+                }
+                // The pop fails only when the reader takes the oldest image at the same time
+                std::vector<uint8_t> dropped_image;
+                if (_images.tryPop(dropped_image))
+                {
+                    _dropped_count.fetch_add(1, std::memory_order_relaxed);
+                    recycleBuffer(std::move(dropped_image));
+                }
+            }
+            _pushed_count.fetch_add(1, std::memory_order_relaxed);
             return *this;
         }
 
+        /**
+        * Reader side. The previous content of the output is given back to the writer to be reused by acquireBuffer.
+        */
         ImageStream& operator>>(std::vector<uint8_t>& output)
         {
-            if (_image_data_container.empty())
+            std::vector<uint8_t> image;
+            if (_images.tryPop(image) == false)
             {
                 return *this;
             }
-            auto result = _image_data_container.front();
-            _image_data_container.pop_front();
-            output = std::move(result);
+            _popped_count.fetch_add(1, std::memory_order_release);
+            _popped_count.notify_one();
+            std::swap(output, image);
+            recycleBuffer(std::move(image));
             return *this;
+        }
+
+        /**
+        * Writer side. Returns a buffer with the given size reusing the buffers that were given back by the reader.
+        */
+        std::vector<uint8_t> acquireBuffer(size_t size)
+        {
+            std::vector<uint8_t> result;
+            _free_buffers.tryPop(result);
+            result.resize(size);
+            return result;
+        }
 
+        bool isEmpty() const
+        {
+            return _images.isEmpty();
         }
 
-        bool isEmpty() const { return _image_data_container.empty(); }
+        Statistics getStatistics() const
+        {
+            return { .pushed_count = _pushed_count.load(std::memory_order_relaxed),
+                .dropped_count = _dropped_count.load(std::memory_order_relaxed) };
+        }
 
         const ImageDescription getImageDescription() const { return _image_description; }
+        OverflowPolicy getOverflowPolicy() const { return _overflow_policy; }
     private:
+        void recycleBuffer(std::vector<uint8_t> buffer)
+        {
+            if (buffer.capacity() > 0)
+            {
+                // When the free list is full the buffer is released
+                _free_buffers.tryPush(buffer);
+            }
+        }
+
         ImageDescription _image_description;
-        std::deque<std::vector<uint8_t>> _image_data_container;
+        const OverflowPolicy _overflow_policy{ OverflowPolicy::DropOldest };
+        BoundedQueue<std::vector<uint8_t>> _images;
+        BoundedQueue<std::vector<uint8_t>> _free_buffers;
+        std::atomic<uint64_t> _popped_count{ 0 };
+        std::atomic<uint64_t> _pushed_count{ 0 };
+        std::atomic<uint64_t> _dropped_count{ 0 };
     };
-}
\ No newline at end of file
+}
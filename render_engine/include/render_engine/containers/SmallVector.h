@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace RenderEngine
+{
+    /**
+    * Vector of trivially copyable elements that keeps the first N elements inline. It allocates only when it grows beyond N,
+    * so copying a small instance is a plain memory copy.
+    */
+    template<typename T, size_t N>
+    class SmallVector
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SmallVector supports only trivially copyable elements");
+    public:
+        SmallVector() = default;
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+        T* data() { return isInline() ? _inline_storage.data() : _heap_storage.data(); }
+        const T* data() const { return isInline() ? _inline_storage.data() : _heap_storage.data(); }
+
+        T* begin() { return data(); }
+        T* end() { return data() + _size; }
+        const T* begin() const { return data(); }
+        const T* end() const { return data() + _size; }
+
+        T& operator[](size_t index)
+        {
+            assert(index < _size);
+            return data()[index];
+        }
+        const T& operator[](size_t index) const
+        {
+            assert(index < _size);
+            return data()[index];
+        }
+
+        void push_back(const T& value)
+        {
+            if (isInline() && _size < N)
+            {
+                _inline_storage[_size++] = value;
+                return;
+            }
+            spill();
+            _heap_storage.push_back(value);
+            ++_size;
+        }
+
+        void append(std::span<const T> values)
+        {
+            if (isInline() && _size + values.size() <= N)
+            {
+                std::ranges::copy(values, _inline_storage.begin() + _size);
+                _size += values.size();
+                return;
+            }
+            spill();
+            _heap_storage.insert(_heap_storage.end(), values.begin(), values.end());
+            _size += values.size();
+        }
+
+        template<typename Predicate>
+        void eraseIf(Predicate predicate)
+        {
+            T* new_end = std::remove_if(begin(), end(), predicate);
+            _size = static_cast<size_t>(new_end - begin());
+            if (isInline() == false)
+            {
+                _heap_storage.resize(_size);
+            }
+        }
+
+        void clear()
+        {
+            _heap_storage.clear();
+            _size = 0;
+        }
+    private:
+        bool isInline() const { return _heap_storage.empty(); }
+
+        void spill()
+        {
+            if (isInline() && _size > 0)
+            {
+                _heap_storage.assign(_inline_storage.begin(), _inline_storage.begin() + _size);
+            }
+        }
+
+        std::array<T, N> _inline_storage{};
+        // Used instead of the inline storage when it is not empty
+        std::vector<T> _heap_storage;
+        size_t _size{ 0 };
+    };
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/LogicalDevice.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RenderEngine
+{
+    /**
+    * Part of the engine that owns an allocation. It is used only for the memory statistics.
+    */
+    enum class MemorySubsystem : uint32_t
+    {
+        Renderer = 0,
+        Transfer,
+        Volume
+    };
+    constexpr size_t kMemorySubsystemCount = 3;
+
+    /**
+    * Hands out device memory for the buffers and textures of a device.
+    *
+    * The memory is allocated from the driver in large blocks per memory type and the blocks are split with a buddy
+    * allocator. Small buffers, buffers and images have their own pools, thus the buffer-image granularity never needs
+    * to be respected inside a block and the small allocations don't fragment the large blocks. Large images, exported
+    * images and the resources the driver prefers to have their own memory get dedicated allocations.
+    *
+    * Host visible blocks are persistently mapped. Allocations can be released from any thread.
+    */
+    class DeviceMemoryAllocator
+    {
+        class Block;
+    public:
+        class Allocation
+        {
+        public:
+            friend class DeviceMemoryAllocator;
+
+            Allocation() = default;
+            ~Allocation();
+
+            Allocation(Allocation&& o) noexcept;
+            Allocation(const Allocation&) = delete;
+
+            Allocation& operator=(Allocation&& o) noexcept;
+            Allocation& operator=(const Allocation&) = delete;
+
+            VkDeviceMemory getMemory() const { return _memory; }
+            VkDeviceSize getOffset() const { return _offset; }
+            /**
+            * Size reserved for the allocation. It can be larger than the requested size.
+            */
+            VkDeviceSize getSize() const { return _size; }
+            /**
+            * Start of the allocation in the mapped memory or nullptr when the memory is not host visible.
+            */
+            void* getMappedMemory() const { return _mapped_memory; }
+            uint32_t getMemoryTypeIndex() const { return _memory_type_index; }
+            MemorySubsystem getSubsystem() const { return _subsystem; }
+            VkMemoryPropertyFlags getMemoryProperties() const { return _memory_properties; }
+            bool isDedicated() const { return _block == nullptr && _memory != VK_NULL_HANDLE; }
+
+            void release() noexcept;
+        private:
+            DeviceMemoryAllocator* _allocator{ nullptr };
+            Block* _block{ nullptr };
+            uint32_t _order{ 0 };
+            VkDeviceMemory _memory{ VK_NULL_HANDLE };
+            VkDeviceSize _offset{ 0 };
+            VkDeviceSize _size{ 0 };
+            VkDeviceSize _requested_size{ 0 };
+            void* _mapped_memory{ nullptr };
+            uint32_t _memory_type_index{ 0 };
+            VkMemoryPropertyFlags _memory_properties{ 0 };
+            MemorySubsystem _subsystem{ MemorySubsystem::Renderer };
+        };
+
+        struct MemoryTypeStatistics
+        {
+            uint32_t memory_type_index{ 0 };
+            uint32_t heap_index{ 0 };
+            VkMemoryPropertyFlags memory_properties{ 0 };
+            uint32_t block_count{ 0 };
+            uint32_t dedicated_allocation_count{ 0 };
+            uint32_t live_allocation_count{ 0 };
+            // Memory allocated from the driver: the blocks and the dedicated allocations
+            VkDeviceSize reserved_bytes{ 0 };
+            // Memory requested by the live allocations
+            VkDeviceSize used_bytes{ 0 };
+            VkDeviceSize free_bytes_in_blocks{ 0 };
+            VkDeviceSize largest_free_range{ 0 };
+            // 0 when the free memory of the blocks is one range, close to 1 when it is split into many small ranges
+            float fragmentation{ 0.0f };
+        };
+
+        struct SubsystemStatistics
+        {
+            uint32_t live_allocation_count{ 0 };
+            // Memory requested by the live allocations
+            VkDeviceSize used_bytes{ 0 };
+        };
+
+        DeviceMemoryAllocator(VkPhysicalDevice physical_device, LogicalDevice& logical_device);
+        ~DeviceMemoryAllocator();
+
+        DeviceMemoryAllocator(DeviceMemoryAllocator&&) = delete;
+        DeviceMemoryAllocator(const DeviceMemoryAllocator&) = delete;
+
+        DeviceMemoryAllocator& operator=(DeviceMemoryAllocator&&) = delete;
+        DeviceMemoryAllocator& operator=(const DeviceMemoryAllocator&) = delete;
+
+        /**
+        * The preferred properties are used when a memory type has them on top of the required ones.
+        */
+        [[nodiscard]]
+        Allocation allocateForBuffer(VkBuffer buffer,
+                                     MemorySubsystem subsystem,
+                                     VkMemoryPropertyFlags required_properties,
+                                     VkMemoryPropertyFlags preferred_properties = 0);
+        /**
+        * Exported and lazily allocated memory is always a dedicated allocation to not share the other resources of a block.
+        */
+        [[nodiscard]]
+        Allocation allocateForImage(VkImage image,
+                                    MemorySubsystem subsystem,
+                                    VkMemoryPropertyFlags required_properties,
+                                    VkMemoryPropertyFlags preferred_properties = 0,
+                                    const VkExportMemoryAllocateInfo* export_info = nullptr);
+        /**
+        * Memory shared by images that alias each other. The requirements must be satisfied by every image bound to it,
+        * the memory is never dedicated to one of them.
+        */
+        [[nodiscard]]
+        Allocation allocateForAliasedImages(const VkMemoryRequirements& requirements,
+                                            MemorySubsystem subsystem,
+                                            VkMemoryPropertyFlags required_properties,
+                                            VkMemoryPropertyFlags preferred_properties = 0);
+
+        /**
+        * Only the memory types that have (or had) allocations are listed.
+        */
+        std::vector<MemoryTypeStatistics> getStatistics() const;
+        std::array<SubsystemStatistics, kMemorySubsystemCount> getSubsystemStatistics() const;
+        const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const { return _memory_properties; }
+    private:
+        enum PoolType
+        {
+            kSmallBufferPool = 0,
+            kBufferPool,
+            kImagePool,
+            kPoolTypeCount
+        };
+
+        struct Pool
+        {
+            VkDeviceSize block_size{ 0 };
+            VkDeviceSize min_allocation_size{ 0 };
+            std::vector<std::unique_ptr<Block>> blocks;
+        };
+
+        struct MemoryType
+        {
+            std::array<Pool, kPoolTypeCount> pools;
+            uint32_t dedicated_allocation_count{ 0 };
+            VkDeviceSize dedicated_bytes{ 0 };
+            uint32_t live_allocation_count{ 0 };
+            VkDeviceSize used_bytes{ 0 };
+            bool used{ false };
+        };
+
+        struct DedicatedTarget
+        {
+            VkBuffer buffer{ VK_NULL_HANDLE };
+            VkImage image{ VK_NULL_HANDLE };
+            const void* next{ nullptr };
+        };
+
+        uint32_t findMemoryType(uint32_t type_filter, VkMemoryPropertyFlags properties, VkMemoryPropertyFlags preferred_properties) const;
+        VkDeviceSize getMinimalAlignment(uint32_t memory_type_index) const;
+        Allocation allocateFromPool(const VkMemoryRequirements& requirements, uint32_t memory_type_index, PoolType pool_type);
+        Allocation allocateDedicated(const VkMemoryRequirements& requirements, uint32_t memory_type_index, const DedicatedTarget& target);
+        void registerAllocation(Allocation& allocation, MemorySubsystem subsystem);
+        VkDeviceMemory allocateMemory(VkDeviceSize size, uint32_t memory_type_index, const void* next, void** mapped_memory);
+        void free(Allocation& allocation) noexcept;
+
+        VkPhysicalDevice _physical_device{ VK_NULL_HANDLE };
+        LogicalDevice& _logical_device;
+        VkPhysicalDeviceMemoryProperties _memory_properties{};
+        VkDeviceSize _non_coherent_atom_size{ 1 };
+        std::vector<MemoryType> _memory_types;
+        std::array<SubsystemStatistics, kMemorySubsystemCount> _subsystem_statistics;
+        mutable std::mutex _mutex;
+    };
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/memory/DeviceMemoryAllocator.h>
+#include <render_engine/memory/TransientResourcePool.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace RenderEngine
+{
+    /**
+    * Collects the memory usage of a device per heap, memory type and subsystem.
+    *
+    * The heap budget and the usage of the process come from VK_EXT_memory_budget when the device supports it. The
+    * reserved and used bytes are the ones allocated by the engine. The memory saved by aliasing the transient textures
+    * is reported separately.
+    */
+    class MemoryTracker
+    {
+    public:
+        struct HeapStatistics
+        {
+            uint32_t heap_index{ 0 };
+            VkMemoryHeapFlags flags{ 0 };
+            VkDeviceSize size{ 0 };
+            // Memory allocated by the engine from the heap
+            VkDeviceSize reserved_bytes{ 0 };
+            // Memory requested by the live allocations of the engine
+            VkDeviceSize used_bytes{ 0 };
+            // Memory the process can allocate from the heap without a performance penalty
+            std::optional<VkDeviceSize> budget;
+            // Memory allocated from the heap by the whole process
+            std::optional<VkDeviceSize> process_usage;
+        };
+
+        struct Report
+        {
+            std::vector<HeapStatistics> heaps;
+            std::vector<DeviceMemoryAllocator::MemoryTypeStatistics> memory_types;
+            std::array<DeviceMemoryAllocator::SubsystemStatistics, kMemorySubsystemCount> subsystems;
+            TransientResourcePool::Statistics transient_resources;
+        };
+
+        MemoryTracker(VkPhysicalDevice physical_device,
+                      const DeviceMemoryAllocator& memory_allocator,
+                      const TransientResourcePool& transient_resource_pool,
+                      bool memory_budget_supported)
+            : _physical_device(physical_device)
+            , _memory_allocator(memory_allocator)
+            , _transient_resource_pool(transient_resource_pool)
+            , _memory_budget_supported(memory_budget_supported)
+        {}
+
+        MemoryTracker(MemoryTracker&&) = delete;
+        MemoryTracker(const MemoryTracker&) = delete;
+
+        MemoryTracker& operator=(MemoryTracker&&) = delete;
+        MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+        Report createReport() const;
+        bool isMemoryBudgetSupported() const { return _memory_budget_supported; }
+
+        void onGui() const;
+    private:
+        VkPhysicalDevice _physical_device{ VK_NULL_HANDLE };
+        const DeviceMemoryAllocator& _memory_allocator;
+        const TransientResourcePool& _transient_resource_pool;
+        bool _memory_budget_supported{ false };
+    };
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/LogicalDevice.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+
+namespace RenderEngine
+{
+    class CoherentBuffer;
+    class DeviceMemoryAllocator;
+
+    /**
+    * Persistently mapped host visible buffer that is shared by the data transfers of a device.
+    *
+    * Allocations can be released in any order but the memory is reclaimed in allocation order (ring).
+    * When an allocation doesn't fit into the ring a dedicated buffer is created for it. The statistics
+    * help to size the ring in a way that it doesn't happen.
+    *
+    * Allocations can be released from any thread (e.g. a readback thread).
+    *
+    * Upload rings are host coherent. Download rings prefer host cached memory because the CPU reads from uncached memory
+    * are slow. Their allocations have to be invalidated before the CPU reads them.
+    */
+    class StagingRingBuffer : public std::enable_shared_from_this<StagingRingBuffer>
+    {
+        struct CreationToken
+        {};
+    public:
+        enum class Usage
+        {
+            Upload = 0,
+            Download
+        };
+
+        class Allocation
+        {
+        public:
+            friend class StagingRingBuffer;
+
+            Allocation() = default;
+            ~Allocation();
+
+            Allocation(Allocation&&) noexcept = default;
+            Allocation(const Allocation&) = delete;
+
+            Allocation& operator=(Allocation&& o) noexcept;
+            Allocation& operator=(const Allocation&) = delete;
+
+            VkBuffer getBuffer() const { return _buffer; }
+            VkDeviceSize getOffset() const { return _offset; }
+            VkDeviceSize getSize() const { return _size; }
+            std::span<uint8_t> getMemory() const { return { _memory, static_cast<size_t>(_size) }; }
+            bool isDedicated() const { return _dedicated_buffer != nullptr; }
+
+            void upload(std::span<const uint8_t> data_view);
+            /**
+            * Makes the data written by the device visible for the host. Needs to be called before reading a download.
+            */
+            void invalidate();
+            void release() noexcept;
+        private:
+            std::weak_ptr<StagingRingBuffer> _ring;
+            uint64_t _region_id{ 0 };
+            VkBuffer _buffer{ VK_NULL_HANDLE };
+            VkDeviceSize _offset{ 0 };
+            VkDeviceSize _size{ 0 };
+            uint8_t* _memory{ nullptr };
+            std::unique_ptr<CoherentBuffer> _dedicated_buffer;
+        };
+
+        struct Statistics
+        {
+            VkDeviceSize capacity{ 0 };
+            VkDeviceSize used{ 0 };
+            VkDeviceSize high_water_mark{ 0 };
+            uint64_t allocation_count{ 0 };
+            uint64_t dedicated_allocation_count{ 0 };
+        };
+
+        static std::shared_ptr<StagingRingBuffer> create(VkPhysicalDevice physical_device,
+                                                         LogicalDevice& logical_device,
+                                                         DeviceMemoryAllocator& memory_allocator,
+                                                         VkDeviceSize capacity,
+                                                         Usage usage)
+        {
+            return std::make_shared<StagingRingBuffer>(physical_device, logical_device, memory_allocator, capacity, usage, CreationToken{});
+        }
+
+        StagingRingBuffer(VkPhysicalDevice physical_device,
+                          LogicalDevice& logical_device,
+                          DeviceMemoryAllocator& memory_allocator,
+                          VkDeviceSize capacity,
+                          Usage usage,
+                          CreationToken);
+        ~StagingRingBuffer();
+
+        StagingRingBuffer(StagingRingBuffer&&) = delete;
+        StagingRingBuffer(const StagingRingBuffer&) = delete;
+
+        StagingRingBuffer& operator=(StagingRingBuffer&&) = delete;
+        StagingRingBuffer& operator=(const StagingRingBuffer&) = delete;
+
+        [[nodiscard]]
+        Allocation allocate(VkDeviceSize size);
+
+        Statistics getStatistics() const
+        {
+            std::unique_lock lock(_mutex);
+            return _statistics;
+        }
+    private:
+        struct Region
+        {
+            VkDeviceSize end{ 0 };
+            bool released{ false };
+        };
+
+        void release(uint64_t region_id);
+        std::optional<VkDeviceSize> findSpace(VkDeviceSize size) const;
+        VkDeviceSize alignOffset(VkDeviceSize offset) const;
+        VkDeviceSize calculateUsedSize() const;
+
+        VkPhysicalDevice _physical_device{ VK_NULL_HANDLE };
+        LogicalDevice& _logical_device;
+        DeviceMemoryAllocator& _memory_allocator;
+        Usage _usage{ Usage::Upload };
+        std::unique_ptr<CoherentBuffer> _buffer;
+        VkDeviceSize _alignment{ 1 };
+        VkDeviceSize _head{ 0 };
+        VkDeviceSize _tail{ 0 };
+        std::deque<Region> _regions;
+        uint64_t _first_region_id{ 0 };
+        Statistics _statistics;
+        mutable std::mutex _mutex;
+    };
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/assets/Image.h>
+#include <render_engine/LogicalDevice.h>
+#include <render_engine/memory/DeviceMemoryAllocator.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RenderEngine
+{
+    class Texture;
+    class TextureFactory;
+
+    /**
+    * Memory of the intermediate textures of a device, e.g. the attachments that are written and read inside one render
+    * pass. Every texture declares the steps of the frame in which it is live. Textures whose live ranges don't overlap
+    * share the same memory.
+    *
+    * The steps don't need to follow the execution order, only their overlap matters. A part of the frame that never
+    * runs together with the other parts (e.g. a render pass) reserves its own steps, thus its textures can alias the
+    * textures of every other part.
+    *
+    * Only the textures of the same queue share a memory, their accesses are ordered by the submission order of the
+    * queue. Their content is undefined at the start of their live range: the first use must discard it (e.g. an
+    * undefined initial layout) and wait for every previous access of the queue (e.g. an external subpass dependency
+    * from all commands). The pool doesn't record these aliasing barriers. The frames in flight of one user overlap,
+    * thus a texture used by a frame must be created for each frame.
+    */
+    class TransientResourcePool
+    {
+    public:
+        /**
+        * Both steps are included.
+        */
+        struct LiveRange
+        {
+            uint32_t first_step{ 0 };
+            uint32_t last_step{ 0 };
+
+            bool overlaps(const LiveRange& o) const
+            {
+                return first_step <= o.last_step && o.first_step <= last_step;
+            }
+        };
+
+        /**
+        * Gives the memory back to the pool when it is destroyed.
+        */
+        class TransientTexture
+        {
+        public:
+            friend class TransientResourcePool;
+
+            TransientTexture() = default;
+            ~TransientTexture();
+
+            TransientTexture(TransientTexture&& o) noexcept;
+            TransientTexture(const TransientTexture&) = delete;
+
+            TransientTexture& operator=(TransientTexture&& o) noexcept;
+            TransientTexture& operator=(const TransientTexture&) = delete;
+
+            Texture* get() const { return _texture.get(); }
+            Texture* operator->() const { return _texture.get(); }
+            Texture& operator*() const { return *_texture; }
+
+            void reset() noexcept;
+        private:
+            TransientTexture(TransientResourcePool& pool, std::unique_ptr<Texture> texture);
+
+            TransientResourcePool* _pool{ nullptr };
+            std::unique_ptr<Texture> _texture;
+        };
+
+        struct Statistics
+        {
+            uint32_t texture_count{ 0 };
+            uint32_t memory_count{ 0 };
+            // Memory the textures would need without aliasing
+            VkDeviceSize texture_bytes{ 0 };
+            // Memory allocated for the textures
+            VkDeviceSize allocated_bytes{ 0 };
+
+            VkDeviceSize getSavedBytes() const { return texture_bytes > allocated_bytes ? texture_bytes - allocated_bytes : 0; }
+        };
+
+        TransientResourcePool(TextureFactory& texture_factory,
+                              LogicalDevice& logical_device,
+                              DeviceMemoryAllocator& memory_allocator);
+        ~TransientResourcePool();
+
+        TransientResourcePool(TransientResourcePool&&) = delete;
+        TransientResourcePool(const TransientResourcePool&) = delete;
+
+        TransientResourcePool& operator=(TransientResourcePool&&) = delete;
+        TransientResourcePool& operator=(const TransientResourcePool&) = delete;
+
+        /**
+        * Reserves step_count consecutive steps that no other part of the frame uses.
+        */
+        LiveRange reserveSteps(uint32_t step_count);
+
+        /**
+        * The texture is bound to the smallest memory of the queue that fits it and has no texture with an overlapping live
+        * range. When there is none a new memory is allocated.
+        */
+        [[nodiscard]]
+        TransientTexture createTexture(Image image,
+                                       VkImageAspectFlags aspect,
+                                       VkShaderStageFlags shader_usage,
+                                       VkImageUsageFlags image_usage,
+                                       VkQueue queue,
+                                       LiveRange live_range,
+                                       MemorySubsystem subsystem = MemorySubsystem::Renderer);
+
+        Statistics getStatistics() const;
+    private:
+        struct AliasedTexture
+        {
+            const Texture* texture{ nullptr };
+            LiveRange live_range;
+            VkDeviceSize size{ 0 };
+        };
+        struct Memory
+        {
+            DeviceMemoryAllocator::Allocation allocation;
+            VkDeviceSize size{ 0 };
+            VkMemoryPropertyFlags preferred_properties{ 0 };
+            // Queue of every texture of the memory
+            VkQueue queue{ VK_NULL_HANDLE };
+            std::vector<AliasedTexture> textures;
+        };
+
+        Memory* findMemory(const VkMemoryRequirements& requirements,
+                           VkMemoryPropertyFlags preferred_properties,
+                           MemorySubsystem subsystem,
+                           VkQueue queue,
+                           const LiveRange& live_range);
+        void release(const Texture& texture) noexcept;
+
+        TextureFactory& _texture_factory;
+        LogicalDevice& _logical_device;
+        DeviceMemoryAllocator& _memory_allocator;
+        std::vector<std::unique_ptr<Memory>> _memories;
+        uint32_t _next_step{ 0 };
+        mutable std::mutex _mutex;
+    };
+}
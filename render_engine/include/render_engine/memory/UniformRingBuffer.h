@@ -0,0 +1,67 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/LogicalDevice.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace RenderEngine
+{
+    class CoherentBuffer;
+    class DeviceMemoryAllocator;
+
+    /**
+    * Linear allocator of uniform data. Every back buffer has one persistently mapped buffer, the allocations of a frame
+    * are bound with dynamic offsets into it. The buffer of a back buffer is reused when its frame begins again.
+    *
+    * Allocations can be made from any thread.
+    */
+    class UniformRingBuffer
+    {
+    public:
+        struct Allocation
+        {
+            void* memory{ nullptr };
+            uint32_t offset{ 0 };
+        };
+
+        UniformRingBuffer(VkPhysicalDevice physical_device,
+                          LogicalDevice& logical_device,
+                          DeviceMemoryAllocator& memory_allocator,
+                          uint32_t back_buffer_size,
+                          VkDeviceSize size_per_frame);
+        ~UniformRingBuffer();
+
+        UniformRingBuffer(UniformRingBuffer&&) = delete;
+        UniformRingBuffer(const UniformRingBuffer&) = delete;
+
+        UniformRingBuffer& operator=(UniformRingBuffer&&) = delete;
+        UniformRingBuffer& operator=(const UniformRingBuffer&) = delete;
+
+        [[nodiscard]]
+        Allocation allocate(uint32_t back_buffer_index, VkDeviceSize size);
+        /**
+        * Must be called when the previous frame of the back buffer is finished on the GPU.
+        */
+        void onFrameBegin(uint32_t back_buffer_index);
+
+        VkBuffer getBuffer(uint32_t back_buffer_index) const;
+        VkDeviceSize getSizePerFrame() const { return _size_per_frame; }
+        VkDeviceSize getHighWaterMark() const { return _high_water_mark.load(std::memory_order_relaxed); }
+    private:
+        struct Frame
+        {
+            std::unique_ptr<CoherentBuffer> buffer;
+            std::atomic<VkDeviceSize> head{ 0 };
+        };
+
+        std::vector<std::unique_ptr<Frame>> _frames;
+        VkDeviceSize _size_per_frame{ 0 };
+        VkDeviceSize _alignment{ 1 };
+        std::atomic<VkDeviceSize> _high_water_mark{ 0 };
+    };
+}
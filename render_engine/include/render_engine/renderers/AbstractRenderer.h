@@ -37,15 +37,29 @@ namespace RenderEngine
         friend class ReinitializationCommand;
 
         virtual ~AbstractRenderer() = default;
+        /**
+        * Called on the main thread before the frame of the window is rendered, e.g. to use the OS window.
+        */
+        virtual void handleEvents() {}
         virtual void onFrameBegin(uint32_t frame_number) = 0;
         virtual void draw(uint32_t swap_chain_image_index) = 0;
         virtual std::vector<VkCommandBuffer> getCommandBuffers(uint32_t frame_number) = 0;
         virtual SyncOperations getSyncOperations(uint32_t frame_number) = 0;
         [[nodiscard]]
         ReinitializationCommand reinit();
+
+        /**
+        * A renderer recording in parallel is drawn on a worker thread of the render context, at the same time as the
+        * other renderers of its window. Every renderer records into its own command pool, but its draw() must not touch
+        * other objects shared with the rest of the window unless they are thread-safe.
+        */
+        void setParallelRecording(bool enabled) { _parallel_recording = enabled; }
+        bool isParallelRecordingEnabled() const { return _parallel_recording; }
     private:
         virtual void beforeReinit() = 0;
         virtual void finalizeReinit(const RenderTarget& render_target) = 0;
 
+        bool _parallel_recording{ false };
+
     };
 }
\ No newline at end of file
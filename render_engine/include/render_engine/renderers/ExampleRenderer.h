@@ -1,4 +1,5 @@
 #pragma once
+#include <render_engine/CommandContext.h>
 #include <render_engine/CommandPoolFactory.h>
 #include <render_engine/renderers/AbstractRenderer.h>
 #include <render_engine/resources/Buffer.h>
@@ -36,7 +37,8 @@ namespace RenderEngine
                         bool last_ExampleRenderer);
 
         void init(const std::vector<Vertex>& vertices, const std::vector<uint16_t>& indicies);
-        void onFrameBegin(uint32_t) override  final {}
+        // Called by the thread updating the window before the draw calls are recorded
+        void onFrameBegin(uint32_t) override final { _frame_color_offset = _color_offset; }
         void draw(uint32_t swap_chain_image_index) override final
         {
             draw(_frame_buffers[swap_chain_image_index], getFrameData(swap_chain_image_index));
@@ -74,6 +76,8 @@ namespace RenderEngine
         void finalizeReinit(const RenderTarget& swap_chain) override final;
         LogicalDevice& getLogicalDevice() { return _window.getDevice().getLogicalDevice(); }
         IWindow& _window;
+        // Own command pool of the renderer, thus it can be recorded in parallel with the other renderers
+        std::shared_ptr<CommandContext> _command_context;
         VkRenderPass _render_pass;
         VkPipelineLayout _pipeline_layout;
         VkPipeline _pipeline;
@@ -86,5 +90,7 @@ namespace RenderEngine
         std::unique_ptr<Buffer> _vertex_buffer;
         std::unique_ptr<Buffer> _index_buffer;
         ColorOffset _color_offset;
+        // Copy of _color_offset taken at the beginning of the frame, the UI can change the original while drawing
+        ColorOffset _frame_color_offset{};
     };
 }
\ No newline at end of file
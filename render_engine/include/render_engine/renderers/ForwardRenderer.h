@@ -3,7 +3,12 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <span>
+#include <vector>
 
+#include <render_engine/assets/MaterialInstance.h>
+#include <render_engine/CommandContext.h>
 #include <render_engine/containers/BackBuffer.h>
 #include <render_engine/renderers/SingleColorOutputRenderer.h>
 #include <render_engine/window/Window.h>
@@ -32,8 +37,24 @@ namespace RenderEngine
             std::unique_ptr<Technique> technique;
             std::vector<const MeshInstance*> mesh_instances;
         };
+        struct DrawCallChunk
+        {
+            MeshGroup* mesh_group{ nullptr };
+            // Frame of the technique of the mesh group, every chunk of the group continues it
+            MaterialInstance::UpdateContext* frame_context{ nullptr };
+            std::span<const MeshInstance* const> mesh_instances;
+        };
+        /**
+        * Command pool of a chunk and its secondary command buffer for each back buffer.
+        */
+        struct ChunkRecorder
+        {
+            std::shared_ptr<CommandContext> command_context;
+            std::vector<VkCommandBuffer> command_buffers;
+        };
     public:
         static constexpr uint32_t kRendererId = 2u;
+        static constexpr uint32_t kDefaultDrawCallChunkSize = 0u;
         ForwardRenderer(IWindow& window,
                         RenderTarget render_target,
                         bool last_renderer);
@@ -41,16 +62,34 @@ namespace RenderEngine
         void onFrameBegin(uint32_t image_index) override;
         void addMesh(const MeshInstance* mesh_instance);
         void draw(uint32_t swap_chain_image_index) override;
+        /**
+        * The mesh groups are split into chunks of at most chunk_size mesh instances. When there are more draw calls than
+        * chunk_size the chunks are recorded into secondary command buffers by the job system of the render context.
+        * The frame callbacks of the materials are called once on the thread calling draw, the draw callbacks of the
+        * chunks of a mesh group are called concurrently.
+        *
+        * Zero records every draw call on the calling thread, it is the default.
+        */
+        void setDrawCallChunkSize(uint32_t chunk_size) { _draw_call_chunk_size = chunk_size; }
+        uint32_t getDrawCallChunkSize() const { return _draw_call_chunk_size; }
         SyncOperations getSyncOperations(uint32_t) final
         {
             return {};
         }
     private:
         std::vector<AttachmentInfo> reinitializeAttachments(const RenderTarget&) override final { return {}; }
+        std::vector<DrawCallChunk> createDrawCallChunks(std::span<MaterialInstance::UpdateContext> frame_contexts);
+        void recordDrawCallChunk(VkCommandBuffer command_buffer, const DrawCallChunk& chunk);
+        void recordDrawCallChunksInParallel(VkCommandBuffer command_buffer,
+                                            const std::vector<DrawCallChunk>& chunks,
+                                            uint32_t swap_chain_image_index);
 
         std::vector<MeshGroup> _meshes;
         std::map<const Mesh*, MeshBuffers> _mesh_buffers;
         PerformanceMarkerFactory _performance_markers;
+        // Chunks recorded in parallel need their own command pools
+        std::vector<ChunkRecorder> _chunk_recorders;
+        uint32_t _draw_call_chunk_size{ kDefaultDrawCallChunkSize };
 
     };
 }
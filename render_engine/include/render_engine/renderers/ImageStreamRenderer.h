@@ -29,8 +29,12 @@ namespace RenderEngine
         struct UploadData
         {
             SyncObject synchronization_object;
-            explicit UploadData(SyncObject synchronization_object)
+            // Tiles of the image that changed since the last upload into the texture
+            std::vector<bool> dirty_tiles;
+            bool upload_scheduled{ true };
+            UploadData(SyncObject synchronization_object, size_t tile_count)
                 : synchronization_object(std::move(synchronization_object))
+                , dirty_tiles(tile_count, false)
             {}
         };
         void destroy() noexcept;
@@ -38,11 +42,15 @@ namespace RenderEngine
         std::vector<AttachmentInfo> reinitializeAttachments(const RenderTarget&) override final { return {}; }
         ImageStream& _image_stream;
         Image _image_cache;
+        // Receives the next image of the stream, it is swapped with the data of the image cache to reuse its allocation
+        std::vector<uint8_t> _image_buffer;
         std::unordered_map<Texture*, UploadData> _upload_data;
         std::unique_ptr<Material> _fullscreen_material;
         std::unique_ptr<MaterialInstance> _material_instance;
         std::unique_ptr<Technique> _technique;
         std::vector<std::unique_ptr<Texture>> _texture_container;
+        uint32_t _tile_column_count{ 0 };
+        uint32_t _tile_row_count{ 0 };
         bool _draw_call_recorded{ true };
         PerformanceMarkerFactory _performance_markers;
 
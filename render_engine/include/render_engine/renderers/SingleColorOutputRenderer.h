@@ -62,6 +62,8 @@ namespace RenderEngine
         virtual std::vector<AttachmentInfo> reinitializeAttachments(const RenderTarget& render_target) = 0;
 
         IWindow& _window;
+        // Own command pool of the renderer, thus it can be recorded in parallel with the other renderers
+        std::shared_ptr<CommandContext> _command_context;
         std::vector<VkFramebuffer> _frame_buffers;
         std::vector<FrameData> _back_buffer;
         VkRenderPass _render_pass{ VK_NULL_HANDLE };
@@ -7,6 +7,7 @@
 #include <volk.h>
 
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <memory>
@@ -26,6 +27,8 @@ namespace RenderEngine
         {
             std::set<ImGuiContext*> invalidContexts;
             std::atomic<VkDevice> loadedDevicePrototypes{ VK_NULL_HANDLE };
+            // ImGui has one current context and one set of Vulkan functions, the windows use them one after the other
+            std::mutex mutex;
         };
 
         static ImGuiGlobals& getGlobals();
@@ -36,6 +39,7 @@ namespace RenderEngine
                    RenderTarget render_target,
                    uint32_t back_buffer_size,
                    bool first_renderer);
+        void handleEvents() override final;
         void onFrameBegin(uint32_t) override final {}
         void draw(uint32_t swap_chain_image_index) override final
         {
@@ -67,6 +71,8 @@ namespace RenderEngine
         GLFWwindow* _window_handle{ nullptr };
 
         std::function<void()> _on_gui;
+        // The GUI frame is built by handleEvents on the main thread, draw only records its draw data
+        bool _gui_frame_built{ false };
         PerformanceMarkerFactory _performance_markers;
 
     };
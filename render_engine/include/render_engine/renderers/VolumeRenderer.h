@@ -4,6 +4,7 @@
 #include <render_engine/assets/VolumetricObject.h>
 #include <render_engine/cuda_compute/DistanceFieldTask.h>
 #include <render_engine/cuda_compute/ExternalSurface.h>
+#include <render_engine/memory/TransientResourcePool.h>
 #include <render_engine/renderers/ForwardRenderer.h>
 #include <render_engine/renderers/SingleColorOutputRenderer.h>
 #include <render_engine/resources/RenderTarget.h>
@@ -33,10 +34,14 @@ namespace RenderEngine
             std::unique_ptr<Buffer> normal_buffer;
             std::unique_ptr<Buffer> texture_buffer;
         };
+        /**
+        * Attachment that is written and read only inside the render pass. It is not stored to memory, thus its memory is
+        * aliased with the transient textures of the other render passes on the same queue.
+        */
         struct FrameBufferData
         {
-            std::vector<std::unique_ptr<Texture>> textures_per_back_buffer;
-            std::vector<std::unique_ptr<TextureView>> texture_views_per_back_buffer;
+            TransientResourcePool::TransientTexture texture;
+            std::unique_ptr<TextureView> texture_view;
         };
         struct TechniqueData
         {
@@ -50,6 +55,8 @@ namespace RenderEngine
             std::vector<std::unique_ptr<Texture>> distance_field_textures;
             std::vector<std::unique_ptr<TextureView>> distance_field_texture_views;
             std::vector<SyncObject> synchronization_objects;
+            // The same semaphore in every synchronization object
+            SemaphoreId distance_field_ready;
             uint32_t segmentation_threshold{};
         };
         struct MeshGroup
@@ -59,8 +66,10 @@ namespace RenderEngine
             std::vector<CudaCompute::DistanceFieldTask> tasks;
         };
 
-        void initializeFrameBuffers(uint32_t back_buffer_count, const Image& ethalon_image);
-        void initializeFrameBufferData(uint32_t back_buffer_count, const Image& ethalon_image, FrameBufferData* frame_buffer_data);
+        void initializeFrameBuffers(const Image& ethalon_image, uint32_t back_buffer_size);
+        void initializeFrameBufferData(const Image& ethalon_image,
+                                       TransientResourcePool::LiveRange live_range,
+                                       FrameBufferData* frame_buffer_data);
         TechniqueData createTechniqueDataFor(const VolumetricObjectInstance& mesh);
         std::vector<AttachmentInfo> reinitializeAttachments(const RenderTarget& render_target) override final;
         std::vector<AttachmentInfo> createFrameBuffersAndAttachments(const RenderTarget& render_target);
@@ -75,10 +84,13 @@ namespace RenderEngine
         void cleanupDistanceFieldTasks(MeshGroup& mesh_group);
 
         RenderTarget _render_target;
+        // One step per subpass
+        TransientResourcePool::LiveRange _render_pass_steps;
         std::vector<MeshGroup> _meshes;
         std::vector<MeshGroup> _meshes_with_distance_field;
-        FrameBufferData _front_face_frame_buffer;
-        FrameBufferData _back_face_frame_buffer;
+        // One per back buffer, the frames in flight don't share the attachments
+        std::vector<FrameBufferData> _front_face_frame_buffers;
+        std::vector<FrameBufferData> _back_face_frame_buffers;
         std::map<const Mesh*, MeshBuffers> _mesh_buffers;
         PerformanceMarkerFactory _performance_markers;
 
@@ -4,6 +4,7 @@
 #include <render_engine/DataTransferTasks.h>
 #include <render_engine/Device.h>
 #include <render_engine/LogicalDevice.h>
+#include <render_engine/memory/DeviceMemoryAllocator.h>
 #include <render_engine/synchronization/ResourceStateMachine.h>
 #include <render_engine/TransferEngine.h>
 
@@ -17,6 +18,9 @@ namespace RenderEngine
         VkBufferUsageFlags usage{ 0 };
         VkDeviceSize size{ 0 };
         VkMemoryPropertyFlags memory_properties{ 0 };
+        // Used when a memory type has them on top of the required memory_properties
+        VkMemoryPropertyFlags preferred_memory_properties{ 0 };
+        MemorySubsystem subsystem{ MemorySubsystem::Renderer };
     };
 
     class Buffer
@@ -24,7 +28,10 @@ namespace RenderEngine
     public:
         friend class ResourceStateMachine;
 
-        Buffer(VkPhysicalDevice physical_device, LogicalDevice& logical_device, BufferInfo&& buffer_info);
+        Buffer(VkPhysicalDevice physical_device,
+               LogicalDevice& logical_device,
+               DeviceMemoryAllocator& memory_allocator,
+               BufferInfo&& buffer_info);
         ~Buffer();
 
         VkBuffer getBuffer() const { return _buffer; }
@@ -52,7 +59,7 @@ namespace RenderEngine
         VkPhysicalDevice _physical_device{ VK_NULL_HANDLE };
         LogicalDevice& _logical_device;
         VkBuffer _buffer{ VK_NULL_HANDLE };;
-        VkDeviceMemory _buffer_memory{ VK_NULL_HANDLE };;
+        DeviceMemoryAllocator::Allocation _allocation;
         BufferInfo _buffer_info;
         BufferState _buffer_state;
         std::shared_ptr<UploadTask> _ongoing_upload{ nullptr };
@@ -66,7 +73,10 @@ namespace RenderEngine
     public:
         friend class ResourceStateMachine;
 
-        CoherentBuffer(VkPhysicalDevice physical_device, LogicalDevice& logical_device, BufferInfo&& buffer_info);
+        CoherentBuffer(VkPhysicalDevice physical_device,
+                       LogicalDevice& logical_device,
+                       DeviceMemoryAllocator& memory_allocator,
+                       BufferInfo&& buffer_info);
         ~CoherentBuffer();
 
         void upload(std::span<const uint8_t> data_view);
@@ -84,6 +94,13 @@ namespace RenderEngine
         VkDeviceSize getDeviceSize() const { return _buffer_info.size; }
 
         const void* getMemory() const { return _mapped_memory; }
+        void* getMemory() { return _mapped_memory; }
+
+        bool isHostCoherent() const { return _host_coherent; }
+        /**
+        * Makes the device writes visible to the host. It is needed only when the memory is not host coherent.
+        */
+        void invalidate(VkDeviceSize offset, VkDeviceSize size);
 
         VkPhysicalDevice getPhysicalDevice() const { return _physical_device; }
         LogicalDevice& getLogicalDevice() const { return _logical_device; }
@@ -92,8 +109,10 @@ namespace RenderEngine
         VkPhysicalDevice _physical_device{ VK_NULL_HANDLE };
         LogicalDevice& _logical_device;
         VkBuffer _buffer{ VK_NULL_HANDLE };;
-        VkDeviceMemory _buffer_memory{ VK_NULL_HANDLE };;
+        DeviceMemoryAllocator::Allocation _allocation;
         BufferInfo _buffer_info;
         void* _mapped_memory{ nullptr };
+        bool _host_coherent{ true };
+        VkDeviceSize _non_coherent_atom_size{ 1 };
     };
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/LogicalDevice.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace RenderEngine
+{
+    /**
+    * Allocates descriptor sets from a chain of descriptor pools. A new pool is created when the current one runs out
+    * of sets or descriptors.
+    *
+    * Persistent sets are released with their DescriptorSets object. The pools are not created with the free descriptor
+    * set flag, a pool is reset and reused when every set of it is released.
+    * Transient sets live for one frame. Their pools are reset when the frame of the back buffer begins again.
+    */
+    class DescriptorAllocator
+    {
+        struct Pool;
+    public:
+        class DescriptorSets
+        {
+        public:
+            friend class DescriptorAllocator;
+
+            DescriptorSets() = default;
+            ~DescriptorSets();
+
+            DescriptorSets(DescriptorSets&& o) noexcept;
+            DescriptorSets(const DescriptorSets&) = delete;
+
+            DescriptorSets& operator=(DescriptorSets&& o) noexcept;
+            DescriptorSets& operator=(const DescriptorSets&) = delete;
+
+            const std::vector<VkDescriptorSet>& getSets() const { return _sets; }
+            VkDescriptorSet operator[](size_t index) const { return _sets[index]; }
+
+            void release() noexcept;
+        private:
+            DescriptorAllocator* _allocator{ nullptr };
+            Pool* _pool{ nullptr };
+            std::vector<VkDescriptorSet> _sets;
+        };
+
+        struct Statistics
+        {
+            uint32_t pool_count{ 0 };
+            // Pools that are reset and wait to be reused
+            uint32_t free_pool_count{ 0 };
+            uint32_t transient_pool_count{ 0 };
+            uint32_t live_set_count{ 0 };
+            uint32_t transient_set_count{ 0 };
+            // Sets that can be allocated from the created pools
+            uint32_t set_capacity{ 0 };
+        };
+
+        DescriptorAllocator(LogicalDevice& logical_device, uint32_t back_buffer_size);
+        ~DescriptorAllocator();
+
+        DescriptorAllocator(DescriptorAllocator&&) = delete;
+        DescriptorAllocator(const DescriptorAllocator&) = delete;
+
+        DescriptorAllocator& operator=(DescriptorAllocator&&) = delete;
+        DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+        [[nodiscard]]
+        DescriptorSets allocate(std::span<const VkDescriptorSetLayout> layouts);
+        /**
+        * The set is valid until the frame of the back buffer begins again.
+        */
+        VkDescriptorSet allocateTransient(VkDescriptorSetLayout layout, uint32_t back_buffer_index);
+        /**
+        * Must be called when the previous frame of the back buffer is finished on the GPU.
+        */
+        void onFrameBegin(uint32_t back_buffer_index);
+
+        Statistics getStatistics() const;
+    private:
+        struct Pool
+        {
+            VkDescriptorPool descriptor_pool{ VK_NULL_HANDLE };
+            uint32_t max_sets{ 0 };
+            uint32_t live_set_count{ 0 };
+        };
+
+        struct TransientPools
+        {
+            std::vector<Pool*> pools;
+            uint32_t set_count{ 0 };
+        };
+
+        Pool* createPool(uint32_t min_set_count);
+        Pool* acquirePool(uint32_t min_set_count);
+        bool tryAllocate(Pool& pool, std::span<const VkDescriptorSetLayout> layouts, VkDescriptorSet* descriptor_sets);
+        void resetPool(Pool& pool);
+        void free(DescriptorSets& descriptor_sets) noexcept;
+
+        LogicalDevice& _logical_device;
+        std::vector<std::unique_ptr<Pool>> _pools;
+        std::vector<Pool*> _free_pools;
+        Pool* _current_pool{ nullptr };
+        std::vector<TransientPools> _transient_pools;
+        uint32_t _next_pool_size{ 0 };
+        mutable std::mutex _mutex;
+    };
+}
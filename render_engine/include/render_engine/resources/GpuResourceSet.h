@@ -18,6 +18,7 @@ namespace RenderEngine
 
         GpuResourceSet(GpuResourceSet&& o) noexcept
             : _resources(std::move(o._resources))
+            , _descriptor_sets(std::move(o._descriptor_sets))
             , _resource_layout(std::move(o._resource_layout))
             , _logical_device(std::move(o._logical_device))
         {
@@ -28,8 +29,10 @@ namespace RenderEngine
         {
             using std::swap;
             swap(_resources, o._resources);
+            swap(_descriptor_sets, o._descriptor_sets);
             swap(_resource_layout, o._resource_layout);
             swap(_logical_device, o._logical_device);
+            return *this;
         }
 
         GpuResourceSet(const GpuResourceSet&) = delete;
@@ -41,10 +44,15 @@ namespace RenderEngine
             return { range.begin(), range.end() };
         }
         VkDescriptorSetLayout getLayout() const { return _resource_layout; }
+        /**
+        * One descriptor set per back buffer, empty when the set has no resources.
+        */
+        const std::vector<VkDescriptorSet>& getDescriptorSets() const { return _descriptor_sets.getSets(); }
     private:
         LogicalDevice& getLogicalDevice() { return *_logical_device; }
 
         std::vector<std::unique_ptr<UniformBinding>> _resources;
+        DescriptorAllocator::DescriptorSets _descriptor_sets;
         VkDescriptorSetLayout _resource_layout{ VK_NULL_HANDLE };
         LogicalDevice* _logical_device{ nullptr };
     };
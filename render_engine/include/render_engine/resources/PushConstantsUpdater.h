@@ -4,10 +4,16 @@
 
 #include <render_engine/LogicalDevice.h>
 
+#include <cstdint>
 #include <span>
+#include <vector>
 
 namespace RenderEngine
 {
+    /**
+    * Records the push constants into its command buffer. An updater without command buffer keeps the updates, they are
+    * recorded by the updaters continuing it.
+    */
     class PushConstantsUpdater
     {
     public:
@@ -25,9 +31,24 @@ namespace RenderEngine
         PushConstantsUpdater& operator=(PushConstantsUpdater&&) = default;
 
         void update(VkShaderStageFlags shader_stages, uint32_t offset, std::span<const uint8_t> data);
+        /**
+        * Creates an updater of the command buffer and records the kept updates into it.
+        */
+        PushConstantsUpdater continueOn(VkCommandBuffer command_buffer) const;
     private:
+        struct KeptUpdate
+        {
+            VkShaderStageFlags shader_stages{ 0 };
+            uint32_t offset{ 0 };
+            // Range of the data in _kept_data
+            uint32_t data_offset{ 0 };
+            uint32_t data_size{ 0 };
+        };
+
         LogicalDevice& _logical_device;
         VkCommandBuffer _command_buffer{ VK_NULL_HANDLE };
         VkPipelineLayout _layout{ VK_NULL_HANDLE };
+        std::vector<KeptUpdate> _kept_updates;
+        std::vector<uint8_t> _kept_data;
     };
-}
\ No newline at end of file
+}
@@ -2,14 +2,17 @@
 
 #include <volk.h>
 
+#include <span>
 #include <vector>
 
 #include <render_engine/assets/Material.h>
 #include <render_engine/assets/Mesh.h>
 #include <render_engine/LogicalDevice.h>
 #include <render_engine/resources/GpuResourceSet.h>
+#include <render_engine/memory/UniformRingBuffer.h>
 #include <render_engine/resources/PushConstantsUpdater.h>
 #include <render_engine/resources/UniformBinding.h>
+#include <render_engine/resources/UniformBufferUpdater.h>
 
 namespace RenderEngine
 {
@@ -18,6 +21,7 @@ namespace RenderEngine
     public:
 
         Technique(LogicalDevice& logical_device,
+                  UniformRingBuffer& uniform_ring_buffer,
                   const MaterialInstance* material,
                   TextureBindingMap&& subpass_textures,
                   GpuResourceSet&& constant_resources,
@@ -35,32 +39,66 @@ namespace RenderEngine
         {
             return _pipeline_layout;
         }
-        std::vector<VkDescriptorSet> collectDescriptorSets(size_t frame_number)
+        /**
+        * Binds the descriptor sets with the dynamic offsets of the uniform data written by the updater.
+        */
+        void bindDescriptorSets(const UniformBufferUpdater& uniform_buffer_updater);
+        /**
+        * Binds the descriptor sets of a technique without update context, the dynamic uniform buffers are bound at offset zero.
+        */
+        void bindDescriptorSets(VkCommandBuffer command_buffer, uint32_t frame_number);
+        /**
+        * The sets in the order of the pipeline layout, they are collected when the technique is created.
+        */
+        std::span<const VkDescriptorSet> getDescriptorSets(uint32_t frame_number) const
         {
-            std::set<VkDescriptorSet> result;
-            for (const UniformBinding* binding : (std::vector{ _per_frame_resources.getResources(), _per_draw_call_resources.getResources() }) | std::views::join)
+            if (_descriptor_sets.empty())
             {
-                result.insert(binding->getDescriptorSet(frame_number));
+                return {};
             }
-            return std::vector<VkDescriptorSet>{ result.begin(), result.end() };
+            return _descriptor_sets[frame_number % _descriptor_sets.size()];
         }
 
+        /**
+        * Calls the frame callback of the material. Without command buffer the push constants of the frame are kept,
+        * the command buffers recording the draw calls get them by continueFrame.
+        */
         MaterialInstance::UpdateContext onFrameBegin(uint32_t frame_number, VkCommandBuffer command_buffer)
         {
             MaterialInstance::UpdateContext result(createPushConstantsUpdater(command_buffer),
+                                                   UniformBufferUpdater{ _uniform_ring_buffer, _dynamic_uniform_bindings, frame_number, command_buffer },
                                                    *_material_instance);
             _material_instance->onFrameBegin(result, frame_number);
+            // The descriptor sets are bound after the frame begins, they get the new offsets anyway
+            result.getUniformBufferUpdater().takeChanges();
             return result;
         }
+        /**
+        * Records the push constants of the frame into the command buffer and returns its context for the draw calls.
+        * The frame callback of the material is not called again, the contexts can be continued on different threads.
+        */
+        MaterialInstance::UpdateContext continueFrame(MaterialInstance::UpdateContext& frame_context, VkCommandBuffer command_buffer)
+        {
+            return MaterialInstance::UpdateContext(frame_context.getPushConstantUpdater().continueOn(command_buffer),
+                                                   frame_context.getUniformBufferUpdater().continueOn(command_buffer),
+                                                   *_material_instance);
+        }
         void onDraw(MaterialInstance::UpdateContext& update_context, const MeshInstance* mesh_instance)
         {
             _material_instance->onDraw(update_context, mesh_instance);
+            if (UniformBufferUpdater& updater = update_context.getUniformBufferUpdater(); updater.takeChanges())
+            {
+                bindDescriptorSets(updater);
+            }
         }
 
-        std::ranges::input_range auto getUniformBindings() const { return (std::vector{ _per_frame_resources.getResources(), _per_draw_call_resources.getResources() }) | std::views::join; }
+        std::span<UniformBinding* const> getUniformBindings() const { return _uniform_bindings; }
 
     private:
         void destroy();
+        void bindDescriptorSets(VkCommandBuffer command_buffer,
+                                uint32_t frame_number,
+                                std::span<const uint32_t> dynamic_offsets);
         VkShaderStageFlags getPushConstantsUsageFlag() const;
         PushConstantsUpdater createPushConstantsUpdater(VkCommandBuffer command_buffer)
         {
@@ -72,6 +110,12 @@ namespace RenderEngine
         GpuResourceSet _constant_resources;
         GpuResourceSet _per_frame_resources;
         GpuResourceSet _per_draw_call_resources;
+        std::vector<UniformBinding*> _uniform_bindings;
+        // In the order of the dynamic offsets: per frame set first, then by binding within a set
+        std::vector<UniformBinding*> _dynamic_uniform_bindings;
+        // Descriptor sets of each back buffer in the order of the pipeline layout
+        std::vector<std::vector<VkDescriptorSet>> _descriptor_sets;
+        UniformRingBuffer& _uniform_ring_buffer;
         LogicalDevice& _logical_device;
         VkPipeline _pipeline{ VK_NULL_HANDLE };
         VkPipelineLayout _pipeline_layout{ VK_NULL_HANDLE };
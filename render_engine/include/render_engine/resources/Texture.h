@@ -5,12 +5,15 @@
 #include <render_engine/assets/Image.h>
 #include <render_engine/DataTransferScheduler.h>
 #include <render_engine/DataTransferTasks.h>
+#include <render_engine/memory/DeviceMemoryAllocator.h>
 #include <render_engine/resources/Buffer.h>
 #include <render_engine/synchronization/ResourceStateMachine.h>
 #include <render_engine/synchronization/SyncOperations.h>
 #include <render_engine/TransferEngine.h>
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
 namespace RenderEngine
 {
@@ -51,17 +54,27 @@ namespace RenderEngine
         VkImage getVkImage() const { return _texture; }
         const Image& getImage() const { return _image; }
 
+        /**
+        * State of the whole texture. When its subresources are in different states it is the state of the first one.
+        */
         const TextureState& getResourceState() const
         {
-            return _texture_state;
+            return _subresource_states.front();
         }
+        const TextureState& getResourceState(uint32_t mip_level, uint32_t array_layer) const
+        {
+            return _subresource_states[getSubresourceIndex(mip_level, array_layer)];
+        }
+        uint32_t getMipLevelCount() const { return _mip_level_count; }
+        uint32_t getArrayLayerCount() const { return _array_layer_count; }
 
         HANDLE getMemoryHandle() const;
         const VkMemoryRequirements& getMemoryRequirements() const { return _memory_requirements; }
         void overrideResourceState(TextureState value, ResourceAccessToken)
         {
-            _texture_state = std::move(value);
+            std::ranges::fill(_subresource_states, value);
         }
+        void overrideResourceState(TextureState value, const VkImageSubresourceRange& range, ResourceAccessToken);
         void assignUploadTask(std::shared_ptr<UploadTask>);
         void assignDownloadTask(std::shared_ptr<DownloadTask>);
 
@@ -70,7 +83,6 @@ namespace RenderEngine
         std::shared_ptr<UploadTask> getUploadTask() { return _ongoing_upload; }
 
         VkImageAspectFlags getAspect() const { return _aspect; }
-        CoherentBuffer& getStagingBuffer() { return _staging_buffer; }
         VkShaderStageFlags getShaderUsageFlag() const { return _shader_usage; }
 
         void setInitialCommandContext(std::weak_ptr<CommandContext> command_context);
@@ -78,30 +90,39 @@ namespace RenderEngine
         Texture(Image image,
                 VkPhysicalDevice physical_device,
                 LogicalDevice& logical_device,
+                DeviceMemoryAllocator& memory_allocator,
                 VkImageAspectFlags aspect,
                 VkShaderStageFlags shader_usage,
                 std::set<uint32_t> compatible_queue_family_indexes,
                 VkImageUsageFlags image_usage,
-                bool support_external_usage);
+                bool support_external_usage,
+                bool allocate_memory,
+                MemorySubsystem subsystem);
         Texture(Image image,
                 VkImage texture,
                 VkPhysicalDevice physical_device,
                 LogicalDevice& logical_device,
                 VkImageAspectFlags aspect);
         void destroy() noexcept;
+        size_t getSubresourceIndex(uint32_t mip_level, uint32_t array_layer) const
+        {
+            return static_cast<size_t>(mip_level) * _array_layer_count + array_layer;
+        }
 
         VkPhysicalDevice _physical_device{ VK_NULL_HANDLE };
         LogicalDevice& _logical_device;
         VkImage _texture{ VK_NULL_HANDLE };
-        CoherentBuffer _staging_buffer;
         Image _image;
         VkImageAspectFlags _aspect{ VK_IMAGE_ASPECT_NONE };
         VkShaderStageFlags _shader_usage{ VK_SHADER_STAGE_ALL };
         std::set<uint32_t> _compatible_queue_family_indexes;
         bool _vkimage_owner{ true };
 
-        VkDeviceMemory _texture_memory{ VK_NULL_HANDLE };
-        TextureState _texture_state;
+        DeviceMemoryAllocator::Allocation _allocation;
+        uint32_t _mip_level_count{ 1 };
+        uint32_t _array_layer_count{ 1 };
+        // Indexed by mip level then array layer
+        std::vector<TextureState> _subresource_states;
         VkMemoryRequirements _memory_requirements{};
         std::shared_ptr<UploadTask> _ongoing_upload{ nullptr };
         std::shared_ptr<DownloadTask> _ongoing_download{ nullptr };
@@ -225,12 +246,14 @@ namespace RenderEngine
                        DataTransferScheduler& data_transfer_scheduler,
                        std::set<uint32_t> compatible_queue_family_indexes,
                        VkPhysicalDevice physical_device,
-                       LogicalDevice& logical_device)
+                       LogicalDevice& logical_device,
+                       DeviceMemoryAllocator& memory_allocator)
             : _transfer_engine(transfer_engine)
             , _data_transfer_scheduler(data_transfer_scheduler)
             , _compatible_queue_family_indexes(std::move(compatible_queue_family_indexes))
             , _physical_device(physical_device)
             , _logical_device(logical_device)
+            , _memory_allocator(memory_allocator)
         {}
         TextureFactory(const TextureFactory&) = delete;
         TextureFactory(TextureFactory&&) = delete;
@@ -245,7 +268,8 @@ namespace RenderEngine
                                         const SyncOperations& synchronization_primitive,
                                         CommandContext* dst_context,
                                         VkImageUsageFlagBits image_usage,
-                                        TextureState final_state);
+                                        TextureState final_state,
+                                        MemorySubsystem subsystem = MemorySubsystem::Renderer);
         [[nodiscard]]
         std::unique_ptr<Texture> createExternal(Image image,
                                                 VkImageAspectFlags aspect,
@@ -253,18 +277,21 @@ namespace RenderEngine
                                                 const SyncOperations& synchronization_primitive,
                                                 CommandContext* dst_context,
                                                 VkImageUsageFlagBits image_usage,
-                                                TextureState final_state);
+                                                TextureState final_state,
+                                                MemorySubsystem subsystem = MemorySubsystem::Renderer);
         [[nodiscard]]
         std::unique_ptr<Texture> createNoUpload(Image image,
                                                 VkImageAspectFlags aspect,
                                                 VkShaderStageFlags shader_usage,
-                                                VkImageUsageFlags image_usage);
+                                                VkImageUsageFlags image_usage,
+                                                MemorySubsystem subsystem = MemorySubsystem::Renderer);
 
         [[nodiscard]]
         std::unique_ptr<Texture> createExternalNoUpload(Image image,
                                                         VkImageAspectFlags aspect,
                                                         VkShaderStageFlags shader_usage,
-                                                        VkImageUsageFlags image_usage);
+                                                        VkImageUsageFlags image_usage,
+                                                        MemorySubsystem subsystem = MemorySubsystem::Renderer);
 
         [[nodiscard]]
         std::unique_ptr<Texture> createWrapper(Image image,
@@ -273,12 +300,23 @@ namespace RenderEngine
                                                LogicalDevice& logical_device,
                                                VkImageAspectFlags aspect);
     private:
+        friend class TransientResourcePool;
+
+        /**
+        * The memory of the texture is bound by TransientResourcePool.
+        */
+        [[nodiscard]]
+        std::unique_ptr<Texture> createWithoutMemory(Image image,
+                                                     VkImageAspectFlags aspect,
+                                                     VkShaderStageFlags shader_usage,
+                                                     VkImageUsageFlags image_usage);
 
         TransferEngine& _transfer_engine;
         DataTransferScheduler& _data_transfer_scheduler;
         std::set<uint32_t> _compatible_queue_family_indexes;
         VkPhysicalDevice _physical_device{ VK_NULL_HANDLE };
         LogicalDevice& _logical_device;
+        DeviceMemoryAllocator& _memory_allocator;
     };
 
 }
\ No newline at end of file
@@ -21,12 +21,17 @@ namespace RenderEngine
             Texture* texture{ nullptr };
         };
 
+        /**
+        * Dynamic uniform buffers don't have their own buffers, their data is written to the uniform ring buffer every frame.
+        */
         UniformBinding(BackBuffer<FrameData>&& back_buffer,
                        int32_t binding,
-                       LogicalDevice& logical_device)
+                       LogicalDevice& logical_device,
+                       VkDeviceSize dynamic_uniform_size = 0)
             : _logical_device(logical_device)
             , _back_buffer(std::move(back_buffer))
             , _binding(binding)
+            , _dynamic_uniform_size(dynamic_uniform_size)
         {}
         ~UniformBinding() = default;
         UniformBinding(const UniformBinding&) = delete;
@@ -46,9 +51,13 @@ namespace RenderEngine
         {
             return _back_buffer[frame_number].texture;
         }
+        int32_t getBinding() const { return _binding; }
+        bool isDynamicUniform() const { return _dynamic_uniform_size > 0; }
+        VkDeviceSize getDynamicUniformSize() const { return _dynamic_uniform_size; }
     private:
         LogicalDevice& _logical_device;
         BackBuffer<FrameData> _back_buffer;
         int32_t _binding{ -1 };
+        VkDeviceSize _dynamic_uniform_size{ 0 };
     };
 }
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <volk.h>
+
+#include <render_engine/memory/UniformRingBuffer.h>
+#include <render_engine/resources/UniformBinding.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace RenderEngine
+{
+    /**
+    * Writes the per frame and per draw call uniform data into the uniform ring buffer. The dynamic offsets of the
+    * updated bindings are rebound by the technique before the next draw call.
+    *
+    * The offsets belong to the updater, not to the bindings, thus the updaters of a technique can record different
+    * command buffers on different threads.
+    */
+    class UniformBufferUpdater
+    {
+    public:
+        // The minimum of maxDescriptorSetUniformBuffersDynamic that every device supports
+        static constexpr size_t kMaxDynamicBindings = 8;
+
+        UniformBufferUpdater(UniformRingBuffer& uniform_ring_buffer,
+                             std::span<UniformBinding* const> dynamic_bindings,
+                             uint32_t frame_number,
+                             VkCommandBuffer command_buffer)
+            : _uniform_ring_buffer(&uniform_ring_buffer)
+            , _dynamic_bindings(dynamic_bindings)
+            , _frame_number(frame_number)
+            , _command_buffer(command_buffer)
+        {}
+        UniformBufferUpdater(const UniformBufferUpdater&) = delete;
+        UniformBufferUpdater(UniformBufferUpdater&&) = default;
+
+        UniformBufferUpdater& operator=(const UniformBufferUpdater&) = delete;
+        UniformBufferUpdater& operator=(UniformBufferUpdater&&) = default;
+
+        void update(int32_t binding, std::span<const uint8_t> data);
+        /**
+        * Returns true when any binding got new data since the last call.
+        */
+        bool takeChanges() { return std::exchange(_changed, false); }
+
+        uint32_t getFrameNumber() const { return _frame_number; }
+        VkCommandBuffer getCommandBuffer() const { return _command_buffer; }
+        /**
+        * Offsets of the last written data in the order of the dynamic bindings. The bindings without data are at zero.
+        */
+        std::span<const uint32_t> getDynamicOffsets() const { return std::span(_dynamic_offsets).first(_dynamic_bindings.size()); }
+        /**
+        * Creates an updater of the command buffer starting from the offsets of this one.
+        */
+        UniformBufferUpdater continueOn(VkCommandBuffer command_buffer) const
+        {
+            UniformBufferUpdater result(*_uniform_ring_buffer, _dynamic_bindings, _frame_number, command_buffer);
+            result._dynamic_offsets = _dynamic_offsets;
+            return result;
+        }
+    private:
+        UniformRingBuffer* _uniform_ring_buffer{ nullptr };
+        std::span<UniformBinding* const> _dynamic_bindings;
+        std::array<uint32_t, kMaxDynamicBindings> _dynamic_offsets{};
+        uint32_t _frame_number{ 0 };
+        VkCommandBuffer _command_buffer{ VK_NULL_HANDLE };
+        bool _changed{ false };
+    };
+}
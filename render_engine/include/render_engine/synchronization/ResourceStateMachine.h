@@ -8,7 +8,7 @@
 #include <cassert>
 #include <functional>
 #include <optional>
-#include <unordered_map>
+#include <vector>
 
 namespace RenderEngine
 {
@@ -47,12 +47,35 @@ namespace RenderEngine
             : _logical_device(logical_device)
         {}
 
+        /**
+        * The state of every subresource in the range is tracked separately. Subresources that are already in the next
+        * state don't get a barrier unless the state writes the memory. When the layout of next_state is undefined, the
+        * subresources keep their layout. A resource without a queue family owner is acquired without a transfer.
+        */
+        void recordStateChange(Texture* texture, TextureState next_state, const VkImageSubresourceRange& range);
         void recordStateChange(Texture* texture, TextureState next_state);
         void recordStateChange(Buffer* buffer, BufferState next_state);
+        /**
+        * Records the release half of a queue family ownership transfer. The barrier is committed together with the
+        * other changes, but the state of the resource is not changed here. It is applied when the matching acquire is
+        * committed on the destination queue.
+        */
+        void recordReleaseStateChange(Texture* texture, TextureState next_state);
+        void recordReleaseStateChange(Buffer* buffer, BufferState next_state);
+        /**
+        * Every recorded change is committed with one pipeline barrier.
+        */
         void commitChanges(VkCommandBuffer command_buffer)
         {
             commitChanges(command_buffer, true);
         }
+        /**
+        * Commits every recorded change as the release half of a queue family ownership transfer.
+        */
+        void commitReleaseChanges(VkCommandBuffer command_buffer)
+        {
+            commitChanges(command_buffer, false);
+        }
     private:
         [[nodiscard]]
         static SyncObject transferOwnershipImpl(ResourceStateHolder auto* texture,
@@ -62,16 +85,14 @@ namespace RenderEngine
                                                 const SyncOperations& sync_operations);
 
         static void ownershipTransformRelease(VkCommandBuffer src_command_buffer,
-                                              VkQueue src_queue,
-                                              LogicalDevice& logical_device,
+                                              CommandContext& src,
                                               ResourceStateHolder auto* texture,
                                               const ResourceState auto& transition_state,
                                               const SyncObject& transformation_sync_object,
                                               const SyncOperations& external_operations);
 
         static void ownershipTransformAcquire(VkCommandBuffer dst_command_buffer,
-                                              VkQueue dst_queue,
-                                              LogicalDevice& logical_device,
+                                              CommandContext& dst,
                                               ResourceStateHolder auto* texture,
                                               const ResourceState auto& transition_state,
                                               const SyncObject& transformation_sync_object,
@@ -88,9 +109,26 @@ namespace RenderEngine
         std::vector<VkBufferMemoryBarrier2> createBufferBarriers(bool apply_state_change_on_buffer);
         bool stateCanMakeChangesOnMemory(VkAccessFlags2 access);
 
+        struct TextureStateChange
+        {
+            Texture* texture{ nullptr };
+            VkImageSubresourceRange range{};
+            TextureState next_state;
+            bool apply_state_change{ true };
+        };
+        struct BufferStateChange
+        {
+            Buffer* buffer{ nullptr };
+            BufferState next_state;
+            bool apply_state_change{ true };
+        };
+
+        void addStateChange(TextureStateChange change);
+        void addStateChange(BufferStateChange change);
+
         LogicalDevice& _logical_device;
-        std::unordered_map<Texture*, TextureState> _images{};
-        std::unordered_map<Buffer*, BufferState> _buffers{};
+        std::vector<TextureStateChange> _images{};
+        std::vector<BufferStateChange> _buffers{};
 
     };
 }
\ No newline at end of file
@@ -4,8 +4,25 @@
 #include <render_engine/synchronization/SyncOperations.h>
 #include <render_engine/synchronization/SyncPrimitives.h>
 
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <vector>
+
 namespace RenderEngine
 {
+    /**
+    * Handle of a synchronization operation group. Group names are interned, the same name gives the same id in every SyncObject.
+    */
+    struct GroupId
+    {
+        uint32_t index{ 0 };
+
+        static GroupId fromName(std::string_view name);
+        auto operator<=>(const GroupId&) const = default;
+    };
+
     /**
     * Synchronization group namespace for publicly available groups.
     *
@@ -17,9 +34,9 @@ namespace RenderEngine
     */
     namespace SyncGroups
     {
-
-        constexpr auto kInternal = "InternalGroup";
-        constexpr auto kExternal = "ExternalGroup";
+        // Their names are "InternalGroup" and "ExternalGroup"
+        constexpr GroupId kInternal{ 0 };
+        constexpr GroupId kExternal{ 1 };
     }
 
     class SyncObject
@@ -33,26 +50,30 @@ namespace RenderEngine
                 return Query{ sync_object };
             }
 
-            Query&& select(const std::string& name)&&
+            Query&& select(GroupId group)&&
             {
-                _operations = _sync_object.getOperationsGroup(name);
+                _operations = _sync_object.getOperationsGroup(group);
                 return std::move(*this);
             }
-            Query&& select(std::initializer_list<std::string> name_container)&&
+            Query&& select(std::string_view name)&&
+            {
+                return std::move(*this).select(GroupId::fromName(name));
+            }
+            Query&& select(std::initializer_list<GroupId> group_container)&&
             {
                 // Fences are needed only once to avoid 'fence-conflict' See more in the unionWith function
                 bool need_fence = true;
-                for (auto name : name_container)
+                for (GroupId group : group_container)
                 {
                     if (need_fence == false)
                     {
                         constexpr int32_t everything_except_fence_bit = ~SyncOperations::ExtractFence;
-                        _operations = _operations.createUnionWith(_sync_object.getOperationsGroup(name).extract(everything_except_fence_bit));
+                        _operations.unionWith(_sync_object.getOperationsGroup(group), everything_except_fence_bit);
                     }
                     else
                     {
                         need_fence = false;
-                        _operations = _operations.createUnionWith(_sync_object.getOperationsGroup(name));
+                        _operations.unionWith(_sync_object.getOperationsGroup(group));
                     }
                 }
                 return std::move(*this);
@@ -65,13 +86,13 @@ namespace RenderEngine
 
             Query&& join(const SyncOperations& operations)&&
             {
-                _operations = _operations.createUnionWith(operations);
+                _operations.unionWith(operations);
                 return std::move(*this);
             }
 
             Query&& join(const Query& o)&&
             {
-                _operations = _operations.createUnionWith(o._operations);
+                _operations.unionWith(o._operations);
                 return std::move(*this);
             }
 
@@ -102,37 +123,63 @@ namespace RenderEngine
         {
             return SyncObject(logical_device, true, create_flags);
         }
-        const SyncOperations& getOperationsGroup(const std::string& name) const { return _operation_groups.at(name); }
+        const SyncOperations& getOperationsGroup(GroupId group) const;
+        const SyncOperations& getOperationsGroup(std::string_view name) const { return getOperationsGroup(GroupId::fromName(name)); }
 
-        void addSignalOperationToGroup(const std::string& group_name, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask);
-        void addSignalOperationToGroup(const std::string& group_name, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value);
+        void addSignalOperationToGroup(GroupId group, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask);
+        void addSignalOperationToGroup(GroupId group, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask, uint64_t value);
 
-        void addWaitOperationToGroup(const std::string& group_name, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask);
+        void addWaitOperationToGroup(GroupId group, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask);
+        void addWaitOperationToGroup(GroupId group, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask, uint64_t value);
 
-        void addWaitOperationToGroup(const std::string& group_name, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value);
+        void addSignalOperationToGroup(std::string_view group_name, std::string_view semaphore_name, VkPipelineStageFlags2 stage_mask)
+        {
+            addSignalOperationToGroup(GroupId::fromName(group_name), _primitives.getSemaphoreId(semaphore_name), stage_mask);
+        }
+        void addSignalOperationToGroup(std::string_view group_name, std::string_view semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value)
+        {
+            addSignalOperationToGroup(GroupId::fromName(group_name), _primitives.getSemaphoreId(semaphore_name), stage_mask, value);
+        }
+
+        void addWaitOperationToGroup(std::string_view group_name, std::string_view semaphore_name, VkPipelineStageFlags2 stage_mask)
+        {
+            addWaitOperationToGroup(GroupId::fromName(group_name), _primitives.getSemaphoreId(semaphore_name), stage_mask);
+        }
+        void addWaitOperationToGroup(std::string_view group_name, std::string_view semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value)
+        {
+            addWaitOperationToGroup(GroupId::fromName(group_name), _primitives.getSemaphoreId(semaphore_name), stage_mask, value);
+        }
 
-        void signalSemaphore(const std::string& name, uint64_t value);
+        void signalSemaphore(SemaphoreId semaphore, uint64_t value);
+        void signalSemaphore(std::string_view name, uint64_t value) { signalSemaphore(_primitives.getSemaphoreId(name), value); }
 
-        void waitSemaphore(const std::string& name, uint64_t value);
-        uint64_t getSemaphoreValue(const std::string& name);
+        void waitSemaphore(SemaphoreId semaphore, uint64_t value);
+        void waitSemaphore(std::string_view name, uint64_t value) { waitSemaphore(_primitives.getSemaphoreId(name), value); }
+
+        uint64_t getSemaphoreValue(SemaphoreId semaphore);
+        uint64_t getSemaphoreValue(std::string_view name) { return getSemaphoreValue(_primitives.getSemaphoreId(name)); }
 
         void waitFence();
         void resetFence();
 
         const SyncPrimitives& getPrimitives() const { return _primitives; }
 
-        void createSemaphore(std::string name);
+        SemaphoreId createSemaphore(std::string name);
 
-        void createTimelineSemaphore(std::string name, uint64_t initial_value, uint64_t timeline_width);
+        SemaphoreId createTimelineSemaphore(std::string name, uint64_t initial_value, uint64_t timeline_width);
 
-        void stepTimeline(const std::string& name);
+        void stepTimeline(SemaphoreId semaphore);
+        void stepTimeline(std::string_view name) { stepTimeline(_primitives.getSemaphoreId(name)); }
 
         Query query() const { return Query::from(*this); }
 
     private:
         SyncObject(LogicalDevice& logical_device, bool create_with_fence, VkFenceCreateFlags create_flags = 0);
 
+        SyncOperations& getOrCreateOperationsGroup(GroupId group);
+
         SyncPrimitives _primitives;
-        std::unordered_map<std::string, SyncOperations> _operation_groups;
+        // Indexed by the group id, the groups that are not used by the object are empty
+        std::vector<std::optional<SyncOperations>> _operation_groups;
     };
 }
\ No newline at end of file
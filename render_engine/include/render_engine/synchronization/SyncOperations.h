@@ -1,16 +1,24 @@
 #pragma once
 
 #include <render_engine/CommandContext.h>
+#include <render_engine/containers/SmallVector.h>
 #include <render_engine/synchronization/SyncPrimitives.h>
 
+#include <string_view>
 #include <vector>
 
 namespace RenderEngine
 {
 
+    /**
+    * Semaphore operations and a fence of a submit. The operations are stored inline up to kInlineSemaphoreCount,
+    * thus copying and merging the usual instances doesn't allocate.
+    */
     class SyncOperations
     {
     public:
+        static constexpr size_t kInlineSemaphoreCount = 8;
+
         enum ExtractBits : int32_t
         {
             ExtractWaitOperations = 1,
@@ -28,13 +36,29 @@ namespace RenderEngine
 
         SyncOperations& operator=(const SyncOperations&) = default;
         SyncOperations& operator=(SyncOperations&&) = default;
-        void addWaitOperation(SyncPrimitives& sync_object, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask);
+        void addWaitOperation(SyncPrimitives& sync_object, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask);
+        void addWaitOperation(SyncPrimitives& sync_object, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask, uint64_t value);
 
-        void addWaitOperation(SyncPrimitives& sync_object, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value);
+        void addSignalOperation(SyncPrimitives& sync_object, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask);
+        void addSignalOperation(SyncPrimitives& sync_object, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask, uint64_t value);
 
-        void addSignalOperation(SyncPrimitives& sync_object, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask);
+        void addWaitOperation(SyncPrimitives& sync_object, std::string_view semaphore_name, VkPipelineStageFlags2 stage_mask)
+        {
+            addWaitOperation(sync_object, sync_object.getSemaphoreId(semaphore_name), stage_mask);
+        }
+        void addWaitOperation(SyncPrimitives& sync_object, std::string_view semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value)
+        {
+            addWaitOperation(sync_object, sync_object.getSemaphoreId(semaphore_name), stage_mask, value);
+        }
 
-        void addSignalOperation(SyncPrimitives& sync_object, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value);
+        void addSignalOperation(SyncPrimitives& sync_object, std::string_view semaphore_name, VkPipelineStageFlags2 stage_mask)
+        {
+            addSignalOperation(sync_object, sync_object.getSemaphoreId(semaphore_name), stage_mask);
+        }
+        void addSignalOperation(SyncPrimitives& sync_object, std::string_view semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value)
+        {
+            addSignalOperation(sync_object, sync_object.getSemaphoreId(semaphore_name), stage_mask, value);
+        }
 
         const SyncOperations& fillInfo(VkSubmitInfo2& submit_info) const;
         bool hasAnyFence() const { return _fence != VK_NULL_HANDLE; }
@@ -47,6 +71,10 @@ namespace RenderEngine
             result.unionWith(o);
             return result;
         }
+        /**
+        * Merges the operations of o selected by extract_bits into this object.
+        */
+        SyncOperations& unionWith(const SyncOperations& o, int32_t extract_bits = ExtractWaitOperations | ExtractSignalOperations | ExtractFence);
 
         void shiftTimelineSemaphoreValues(uint64_t offset);
 
@@ -55,28 +83,26 @@ namespace RenderEngine
         SyncOperations extract(int32_t extract_bits) const
         {
             SyncOperations result;
-            if (extract_bits & ExtractWaitOperations)
-            {
-                result._wait_semaphore_dependency = _wait_semaphore_dependency;
-            }
-            if (extract_bits & ExtractSignalOperations)
-            {
-                result._signal_semaphore_dependency = _signal_semaphore_dependency;
-            }
-            if (extract_bits & ExtractFence)
-            {
-                result._fence = _fence;
-            }
+            result.unionWith(*this, extract_bits);
             return result;
         }
 
-        SyncOperations restrict(const CommandContext& context) const;
+        SyncOperations restrict(const CommandContext& context) const
+        {
+            SyncOperations result = *this;
+            result.restrictTo(context);
+            return result;
+        }
+        /**
+        * Removes the operations whose stages are not supported by the context.
+        */
+        void restrictTo(const CommandContext& context);
 
     private:
-        void unionWith(const SyncOperations& o);
+        using SemaphoreSubmitInfos = SmallVector<VkSemaphoreSubmitInfo, kInlineSemaphoreCount>;
 
-        std::vector<VkSemaphoreSubmitInfo> _wait_semaphore_dependency;
-        std::vector<VkSemaphoreSubmitInfo> _signal_semaphore_dependency;
+        SemaphoreSubmitInfos _wait_semaphore_dependency;
+        SemaphoreSubmitInfos _signal_semaphore_dependency;
         VkFence _fence{ VK_NULL_HANDLE };
     };
 
@@ -2,13 +2,31 @@
 
 #include <volk.h>
 
+#include <cstdint>
+#include <limits>
+#include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <vector>
 
 #include <render_engine/LogicalDevice.h>
 
 namespace RenderEngine
 {
+    /**
+    * Handle of a semaphore. It is the index of the semaphore in the SyncPrimitives that created it,
+    * so it is valid only with that object.
+    */
+    struct SemaphoreId
+    {
+        static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        uint32_t index{ kInvalidIndex };
+
+        bool isValid() const { return index != kInvalidIndex; }
+        auto operator<=>(const SemaphoreId&) const = default;
+    };
+
     class SyncPrimitives
     {
     public:
@@ -24,33 +42,63 @@ namespace RenderEngine
         SyncPrimitives& operator=(SyncPrimitives&& o);
         SyncPrimitives& operator=(const SyncPrimitives& o) = delete;
 
-        void createSemaphore(std::string name);
+        SemaphoreId createSemaphore(std::string name);
+
+        SemaphoreId createTimelineSemaphore(std::string name, uint64_t initial_value, uint64_t timeline_width);
 
-        void createTimelineSemaphore(std::string name, uint64_t initial_value, uint64_t timeline_width);
+        /**
+        * Finds the semaphore by its name. It is meant to be called once, the returned id should be stored.
+        */
+        SemaphoreId getSemaphoreId(std::string_view name) const;
 
-        const VkSemaphore& getSemaphore(const std::string& name) const
+        const VkSemaphore& getSemaphore(SemaphoreId id) const
         {
-            return _semaphore_map.at(name);
+            return _semaphores.at(id.index).semaphore;
+        }
+        const VkSemaphore& getSemaphore(std::string_view name) const
+        {
+            return getSemaphore(getSemaphoreId(name));
+        }
+
+        const std::string& getSemaphoreName(SemaphoreId id) const
+        {
+            return _semaphores.at(id.index).name;
         }
 
         const VkFence& getFence() const { return _fence; }
 
         LogicalDevice& getLogicalDevice() const { return *_logical_device; }
 
-        uint64_t getTimelineOffset(const std::string& name)
+        uint64_t getTimelineOffset(SemaphoreId id) const
         {
-            return _timeline_data.at(name).timeline_offset;
+            return getTimelineData(id).timeline_offset;
+        }
+        uint64_t getTimelineOffset(std::string_view name) const
+        {
+            return getTimelineOffset(getSemaphoreId(name));
         }
 
-        uint64_t getTimelineWidth(const std::string& name)
+        uint64_t getTimelineWidth(SemaphoreId id) const
+        {
+            return getTimelineData(id).timeline_width;
+        }
+        uint64_t getTimelineWidth(std::string_view name) const
         {
-            return _timeline_data.at(name).timeline_width;
+            return getTimelineWidth(getSemaphoreId(name));
         }
 
-        uint64_t stepTimeline(const std::string& name);
+        uint64_t stepTimeline(SemaphoreId id);
+        uint64_t stepTimeline(std::string_view name)
+        {
+            return stepTimeline(getSemaphoreId(name));
+        }
 
-        bool hasSemaphore(const std::string& name) const { return _semaphore_map.contains(name); }
-        bool hasTimelineSemaphore(const std::string& name) const { return _timeline_data.contains(name); }
+        bool hasSemaphore(std::string_view name) const { return findSemaphore(name) != nullptr; }
+        bool hasTimelineSemaphore(std::string_view name) const
+        {
+            const SemaphoreData* semaphore_data = findSemaphore(name);
+            return semaphore_data != nullptr && semaphore_data->timeline_data != std::nullopt;
+        }
     private:
         struct TimelineSemaphoreData
         {
@@ -58,15 +106,27 @@ namespace RenderEngine
             uint64_t timeline_offset{ 0 };
             uint64_t initial_value{ 0 };
         };
+        struct SemaphoreData
+        {
+            std::string name;
+            VkSemaphore semaphore{ VK_NULL_HANDLE };
+            std::optional<TimelineSemaphoreData> timeline_data;
+        };
         explicit SyncPrimitives(LogicalDevice& logical_device) :
             _logical_device(&logical_device)
         {}
 
+        const SemaphoreData* findSemaphore(std::string_view name) const;
+        const TimelineSemaphoreData& getTimelineData(SemaphoreId id) const
+        {
+            return _semaphores.at(id.index).timeline_data.value();
+        }
+        SemaphoreId addSemaphore(SemaphoreData semaphore_data);
 
-        std::unordered_map<std::string, VkSemaphore> _semaphore_map;
-        std::unordered_map<std::string, TimelineSemaphoreData> _timeline_data;
+        // An object has only a few semaphores, the names are searched linearly
+        std::vector<SemaphoreData> _semaphores;
         VkFence _fence{ VK_NULL_HANDLE };
 
         LogicalDevice* _logical_device{ nullptr };
     };
-}
\ No newline at end of file
+}
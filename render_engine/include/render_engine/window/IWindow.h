@@ -10,7 +10,23 @@ namespace RenderEngine
     public:
         virtual ~IWindow() = default;
 
-        virtual void update() = 0;
+        /**
+        * The part of the update using the OS window, e.g. its events. It is called only on the main thread.
+        */
+        virtual void handleEvents() = 0;
+        /**
+        * Records and submits the next frame. It can be called on any thread after handleEvents, but the windows of a
+        * device must not be rendered at the same time.
+        */
+        virtual void render() = 0;
+        /**
+        * Updates the window on the main thread.
+        */
+        void update()
+        {
+            handleEvents();
+            render();
+        }
         virtual bool isClosed() const = 0;
         virtual void registerRenderers(const std::vector<uint32_t>& renderer_ids) = 0;
         virtual Device& getDevice() = 0;
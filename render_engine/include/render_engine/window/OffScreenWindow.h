@@ -5,7 +5,9 @@
 #include <render_engine/resources/Texture.h>
 #include <render_engine/synchronization/SyncObject.h>
 #include <render_engine/window/IWindow.h>
+#include <render_engine/window/ReadbackWorker.h>
 
+#include <chrono>
 #include <vector>
 namespace RenderEngine
 {
@@ -13,11 +15,19 @@ namespace RenderEngine
     {
 
     public:
+        struct FrameStatistics
+        {
+            std::chrono::microseconds render_thread_frame_time{ 0 };
+            std::chrono::microseconds readback_latency{ 0 };
+        };
+
         OffScreenWindow(Device& device,
                         std::unique_ptr<RenderEngine>&& render_engine,
-                        std::vector<std::unique_ptr<Texture>>&& textures);
+                        std::vector<std::unique_ptr<Texture>>&& textures,
+                        uint32_t readback_frames_in_flight);
         ~OffScreenWindow();
-        void update() override final;
+        void handleEvents() override final {}
+        void render() override final;
         void registerRenderers(const std::vector<uint32_t>& renderer_ids) override final;
         Device& getDevice()  override final { return _device; }
         void enableRenderdocCapture() override final;
@@ -38,6 +48,7 @@ namespace RenderEngine
 
         ImageStream& getImageStream() { return _image_stream; }
         uint32_t getFrameCounter() const { return _frame_counter; }
+        FrameStatistics getFrameStatistics() const;
         void registerTunnel(WindowTunnel& tunnel) override final;
         WindowTunnel* getTunnel() override final;
 
@@ -49,15 +60,15 @@ namespace RenderEngine
             bool contains_image{ false };
             std::unique_ptr<Texture> render_target_texture;
             std::unique_ptr<ITextureView> render_target_texture_view;
+            std::chrono::steady_clock::time_point download_request_time;
         };
         void initSynchronizationObjects();
         void present();
-        void present(FrameData& current_frame_data) const;
-        void readBack();
+        void present(FrameData& current_frame_data);
+        void readBack(uint32_t image_index);
         void destroy();
         RenderTarget createRenderTarget();
         uint32_t getCurrentImageIndex() const { return _current_render_target_index; }
-        uint32_t getOldestImageIndex() const { return (_current_render_target_index + 1) % _back_buffer_size; }
 
         Device& _device;
         std::unique_ptr<RenderEngine> _render_engine;
@@ -71,6 +82,8 @@ namespace RenderEngine
         size_t _back_buffer_size{ 2 };
         void* _renderdoc_api{ nullptr };
         ImageStream _image_stream;
+        std::unique_ptr<ReadbackWorker> _readback_worker;
+        std::chrono::microseconds _render_thread_frame_time{ 0 };
         WindowTunnel* _tunnel{ nullptr };
     };
 }
\ No newline at end of file
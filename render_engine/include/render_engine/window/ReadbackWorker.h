@@ -0,0 +1,65 @@
+#pragma once
+
+#include <render_engine/containers/ImageStream.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace RenderEngine
+{
+    class DownloadTask;
+
+    /**
+    * Finishes the started downloads on a background thread: waits for the transfer and copies the image out of the
+    * staging memory into the image stream.
+    *
+    * At most frames_in_flight downloads are waited/copied at the same time. When the limit is reached push() blocks
+    * the caller until a frame is finished.
+    */
+    class ReadbackWorker
+    {
+    public:
+        ReadbackWorker(ImageStream& image_stream, uint32_t frames_in_flight);
+        ~ReadbackWorker();
+
+        ReadbackWorker(ReadbackWorker&&) = delete;
+        ReadbackWorker(const ReadbackWorker&) = delete;
+
+        ReadbackWorker& operator=(ReadbackWorker&&) = delete;
+        ReadbackWorker& operator=(const ReadbackWorker&) = delete;
+
+        void push(std::shared_ptr<DownloadTask> download_task, std::chrono::steady_clock::time_point request_time);
+
+        /**
+        * Time between the request of the download and the image being available in the image stream.
+        */
+        std::chrono::microseconds getLastLatency() const;
+        uint32_t getFramesInFlight() const { return _frames_in_flight; }
+    private:
+        struct Job
+        {
+            std::shared_ptr<DownloadTask> download_task;
+            std::chrono::steady_clock::time_point request_time;
+        };
+
+        void run();
+
+        ImageStream& _image_stream;
+        const uint32_t _frames_in_flight{ 1 };
+
+        mutable std::mutex _mutex;
+        std::condition_variable _job_available;
+        std::condition_variable _slot_available;
+        std::deque<Job> _jobs;
+        uint32_t _jobs_in_progress{ 0 };
+        std::chrono::microseconds _last_latency{ 0 };
+        bool _stop{ false };
+
+        std::thread _thread;
+    };
+}
@@ -34,7 +34,9 @@ namespace RenderEngine
                std::shared_ptr<CommandContext>&& present_context);
         ~Window();
 
-        void update() override final;
+        // GLFW and the ImGui frame of the UI renderer are handled here, render doesn't use them
+        void handleEvents() override final;
+        void render() override final;
         bool isClosed() const override final { return _closed; }
 
         void registerRenderers(const std::vector<uint32_t>& renderer_ids) override final;
@@ -63,9 +65,10 @@ namespace RenderEngine
         struct FrameData
         {
             SyncObject synch_render;
+            SemaphoreId image_available;
+            SemaphoreId render_finished;
         };
         void initSynchronizationObjects();
-        void handleEvents();
         void present();
         void present(FrameData& current_frame_data);
         void reinitSwapChain();
@@ -87,6 +90,9 @@ namespace RenderEngine
         void* _renderdoc_api{ nullptr };
         std::optional<uint32_t> _swap_chain_image_index;
         bool _new_swap_chain_image_is_required{ true };
+        // The swap chain is recreated on the main thread, the size of the OS window is queried from GLFW
+        bool _swap_chain_reinit_required{ false };
+        bool _iconified{ false };
         WindowTunnel* _tunnel{ nullptr };
         bool _closed = false;
     };
@@ -2,6 +2,9 @@
 
 #include <render_engine/renderers/ImageStreamRenderer.h>
 #include <render_engine/window/OffScreenWindow.h>
+#include <render_engine/window/WindowUpdateScheduler.h>
+
+#include <memory>
 
 namespace RenderEngine
 {
@@ -9,13 +12,7 @@ namespace RenderEngine
     {
     public:
         WindowTunnel(std::unique_ptr<OffScreenWindow> origin_window,
-                     std::unique_ptr<IWindow> destination_window)
-            : _origin_window(std::move(origin_window))
-            , _destination_window(std::move(destination_window))
-        {
-            _origin_window->registerTunnel(*this);
-            _destination_window->registerTunnel(*this);
-        }
+                     std::unique_ptr<IWindow> destination_window);
         ~WindowTunnel() = default;
 
         WindowTunnel(const WindowTunnel&) = delete;
@@ -30,9 +27,14 @@ namespace RenderEngine
         const OffScreenWindow& getOriginWindow() const { return *_origin_window; }
         const IWindow& getDestinationWindow() const { return *_destination_window; }
 
+        /**
+        * The windows are updated concurrently when they are on different devices.
+        */
         void update();
+        const WindowUpdateScheduler& getUpdateScheduler() const { return *_update_scheduler; }
     private:
         std::unique_ptr<OffScreenWindow> _origin_window;
         std::unique_ptr<IWindow> _destination_window;
+        std::unique_ptr<WindowUpdateScheduler> _update_scheduler;
     };
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <render_engine/JobSystem.h>
+#include <render_engine/window/IWindow.h>
+
+#include <chrono>
+#include <vector>
+
+namespace RenderEngine
+{
+    class Device;
+    class WindowTunnel;
+
+    /**
+    * Updates the windows of different devices concurrently.
+    *
+    * The events of every window are handled first by the thread calling update, it must be the main thread. Then the
+    * windows are rendered. The windows of a device share its queues, staging area and frame scheduler, thus they form a
+    * lane: they are rendered one after the other in the order they were added, inside one frame batch. The lanes run in
+    * parallel as jobs of the job system.
+    */
+    class WindowUpdateScheduler
+    {
+    public:
+        struct WindowStatistics
+        {
+            const IWindow* window{ nullptr };
+            uint32_t lane_index{ 0 };
+            // Time of the last rendering of the window. The last window of a lane includes the flush of the frame batch.
+            std::chrono::microseconds frame_time{ 0 };
+        };
+
+        explicit WindowUpdateScheduler(JobSystem& job_system)
+            : _job_system(job_system)
+        {}
+
+        WindowUpdateScheduler(WindowUpdateScheduler&&) = delete;
+        WindowUpdateScheduler(const WindowUpdateScheduler&) = delete;
+
+        WindowUpdateScheduler& operator=(WindowUpdateScheduler&&) = delete;
+        WindowUpdateScheduler& operator=(const WindowUpdateScheduler&) = delete;
+
+        /**
+        * The window must outlive the scheduler.
+        */
+        void addWindow(IWindow& window);
+        /**
+        * The origin is updated before the destination when they are on the same device.
+        */
+        void addTunnel(WindowTunnel& tunnel);
+
+        /**
+        * Updates every window once and waits for all of them. The first exception of the lanes is rethrown.
+        */
+        void update();
+
+        /**
+        * The statistics are written by the lanes, they can be read between the updates and while the events are handled.
+        */
+        const std::vector<WindowStatistics>& getStatistics() const { return _statistics; }
+        std::chrono::microseconds getFrameTime(const IWindow& window) const;
+        // Wall clock time of the last update of all windows
+        std::chrono::microseconds getUpdateTime() const { return _update_time; }
+        uint32_t getLaneCount() const { return static_cast<uint32_t>(_lanes.size()); }
+
+        void onGui() const;
+    private:
+        struct Lane
+        {
+            Device* device{ nullptr };
+            // Indexes of the statistics of the windows
+            std::vector<uint32_t> windows;
+        };
+
+        void updateLane(const Lane& lane);
+
+        JobSystem& _job_system;
+        std::vector<Lane> _lanes;
+        std::vector<IWindow*> _windows;
+        std::vector<WindowStatistics> _statistics;
+        std::chrono::microseconds _update_time{ 0 };
+    };
+}
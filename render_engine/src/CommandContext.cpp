@@ -1,5 +1,8 @@
 #include <render_engine/CommandContext.h>
 
+#include <render_engine/containers/SmallVector.h>
+#include <render_engine/synchronization/SyncOperations.h>
+
 #include <algorithm>
 #include <cassert>
 #include <ranges>
@@ -33,13 +36,27 @@ namespace RenderEngine
         {
             VkCommandPoolCreateInfo pool_info{};
             pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-            pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
             pool_info.queueFamilyIndex = queue_family_index;
             if (getLogicalDevice()->vkCreateCommandPool(*getLogicalDevice(), &pool_info, nullptr, &_transient_command_pool) != VK_SUCCESS)
             {
                 throw std::runtime_error("failed to create command pool!");
             }
         }
+        {
+            VkSemaphoreTypeCreateInfo type_info{};
+            type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+            type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+            type_info.initialValue = 0;
+
+            VkSemaphoreCreateInfo create_info{};
+            create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            create_info.pNext = &type_info;
+            if (getLogicalDevice()->vkCreateSemaphore(*getLogicalDevice(), &create_info, nullptr, &_submit_timeline) != VK_SUCCESS)
+            {
+                throw std::runtime_error("failed to create submit timeline semaphore!");
+            }
+        }
     }
     CommandContext::CommandContext(CommandContext&& o) noexcept
     {
@@ -53,6 +70,13 @@ namespace RenderEngine
         swap(o._queue, _queue);
         swap(o._command_pool, _command_pool);
         swap(o._transient_command_pool, _transient_command_pool);
+        swap(o._queue_family_info, _queue_family_info);
+        swap(o._submit_timeline, _submit_timeline);
+        swap(o._submit_counter, _submit_counter);
+        swap(o._free_command_buffers, _free_command_buffers);
+        swap(o._recording_command_buffers, _recording_command_buffers);
+        swap(o._in_flight_command_buffers, _in_flight_command_buffers);
+        swap(o._command_buffer_statistics, _command_buffer_statistics);
         return *this;
     }
     CommandContext::~CommandContext()
@@ -63,17 +87,32 @@ namespace RenderEngine
         }
         getLogicalDevice()->vkDestroyCommandPool(*getLogicalDevice(), _command_pool, nullptr);
         getLogicalDevice()->vkDestroyCommandPool(*getLogicalDevice(), _transient_command_pool, nullptr);
+        getLogicalDevice()->vkDestroySemaphore(*getLogicalDevice(), _submit_timeline, nullptr);
     }
     VkQueue CommandContext::getQueue() const
     {
         return _queue;
     }
-    VkCommandBuffer CommandContext::createCommandBuffer(Usage usage) const
+    VkCommandBuffer CommandContext::createCommandBuffer(Usage usage)
     {
+        if (usage == Usage::SingleSubmit)
+        {
+            return acquireSingleSubmitCommandBuffer();
+        }
         return createCommandBuffers(1, usage).front();
     }
-    std::vector<VkCommandBuffer> CommandContext::createCommandBuffers(uint32_t count, Usage usage) const
+    std::vector<VkCommandBuffer> CommandContext::createCommandBuffers(uint32_t count, Usage usage)
     {
+        if (usage == Usage::SingleSubmit)
+        {
+            std::vector<VkCommandBuffer> command_buffers;
+            command_buffers.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                command_buffers.push_back(acquireSingleSubmitCommandBuffer());
+            }
+            return command_buffers;
+        }
         std::vector<VkCommandBuffer> command_buffers(count, VK_NULL_HANDLE);
         VkCommandBufferAllocateInfo allocInfo{};
         allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -89,6 +128,137 @@ namespace RenderEngine
         return command_buffers;
     }
 
+    std::vector<VkCommandBuffer> CommandContext::createSecondaryCommandBuffers(uint32_t count)
+    {
+        std::vector<VkCommandBuffer> command_buffers(count, VK_NULL_HANDLE);
+        VkCommandBufferAllocateInfo alloc_info{};
+        alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        alloc_info.commandPool = getCommandPool(Usage::MultipleSubmit);
+        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        alloc_info.commandBufferCount = count;
+
+        if (getLogicalDevice()->vkAllocateCommandBuffers(*getLogicalDevice(), &alloc_info, command_buffers.data()) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to allocate secondary command buffers!");
+        }
+
+        return command_buffers;
+    }
+
+    VkCommandBuffer CommandContext::acquireSingleSubmitCommandBuffer()
+    {
+        if (_free_command_buffers.empty())
+        {
+            recycleCommandBuffers();
+        }
+        VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+        if (_free_command_buffers.empty() == false)
+        {
+            // Implicitly reset by vkBeginCommandBuffer
+            command_buffer = _free_command_buffers.back();
+            _free_command_buffers.pop_back();
+            _command_buffer_statistics.recycled_count++;
+        }
+        else
+        {
+            VkCommandBufferAllocateInfo alloc_info{};
+            alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            alloc_info.commandPool = _transient_command_pool;
+            alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            alloc_info.commandBufferCount = 1;
+            if (getLogicalDevice()->vkAllocateCommandBuffers(*getLogicalDevice(), &alloc_info, &command_buffer) != VK_SUCCESS)
+            {
+                throw std::runtime_error("failed to allocate command buffers!");
+            }
+            _command_buffer_statistics.allocated_count++;
+        }
+        _recording_command_buffers.push_back(command_buffer);
+        return command_buffer;
+    }
+
+    void CommandContext::submit(VkCommandBuffer command_buffer, const SyncOperations& sync_operations)
+    {
+        auto recording_it = std::ranges::find(_recording_command_buffers, command_buffer);
+        assert(recording_it != _recording_command_buffers.end() && "Only SingleSubmit command buffers of this context can be submitted");
+
+        VkCommandBufferSubmitInfo command_buffer_info{};
+        command_buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        command_buffer_info.commandBuffer = command_buffer;
+
+        VkSubmitInfo2 submit_info{};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submit_info.commandBufferInfoCount = 1;
+        submit_info.pCommandBufferInfos = &command_buffer_info;
+        sync_operations.fillInfo(submit_info);
+
+        // One more than the inline operations of SyncOperations, the finish signal doesn't allocate either
+        SmallVector<VkSemaphoreSubmitInfo, SyncOperations::kInlineSemaphoreCount + 1> signal_infos;
+        signal_infos.append(std::span(submit_info.pSignalSemaphoreInfos, submit_info.signalSemaphoreInfoCount));
+        // The counter is only advanced by a successful submit
+        const uint64_t finish_value = _submit_counter + 1;
+        VkSemaphoreSubmitInfo finish_signal{};
+        finish_signal.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        finish_signal.semaphore = _submit_timeline;
+        finish_signal.value = finish_value;
+        finish_signal.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        signal_infos.push_back(finish_signal);
+        submit_info.signalSemaphoreInfoCount = static_cast<uint32_t>(signal_infos.size());
+        submit_info.pSignalSemaphoreInfos = signal_infos.data();
+
+        {
+            auto queue_lock = getLogicalDevice().lockQueue(getQueue());
+            if (getLogicalDevice()->vkQueueSubmit2(getQueue(), 1, &submit_info, sync_operations.getFence()) != VK_SUCCESS)
+            {
+                queue_lock.unlock();
+                abandon(command_buffer);
+                throw std::runtime_error("failed to submit command buffer!");
+            }
+        }
+        _submit_counter = finish_value;
+        _recording_command_buffers.erase(recording_it);
+        _in_flight_command_buffers.push_back({ .command_buffer = command_buffer, .finish_value = finish_value });
+        _command_buffer_statistics.in_flight_count = _in_flight_command_buffers.size();
+    }
+
+    void CommandContext::abandon(VkCommandBuffer command_buffer)
+    {
+        auto recording_it = std::ranges::find(_recording_command_buffers, command_buffer);
+        assert(recording_it != _recording_command_buffers.end() && "Only SingleSubmit command buffers of this context can be abandoned");
+        _recording_command_buffers.erase(recording_it);
+        // It can be left in the recording state, which vkBeginCommandBuffer doesn't accept. When it cannot be reset it
+        // stays allocated until the next reset of the pool.
+        if (getLogicalDevice()->vkResetCommandBuffer(command_buffer, 0) == VK_SUCCESS)
+        {
+            _free_command_buffers.push_back(command_buffer);
+        }
+    }
+
+    void CommandContext::recycleCommandBuffers()
+    {
+        if (_in_flight_command_buffers.empty() == false)
+        {
+            uint64_t finished_value = 0;
+            if (getLogicalDevice()->vkGetSemaphoreCounterValue(*getLogicalDevice(), _submit_timeline, &finished_value) != VK_SUCCESS)
+            {
+                throw std::runtime_error("failed to get the value of the submit timeline!");
+            }
+            // Signal operations of a queue are finished in submission order
+            while (_in_flight_command_buffers.empty() == false
+                   && _in_flight_command_buffers.front().finish_value <= finished_value)
+            {
+                _free_command_buffers.push_back(_in_flight_command_buffers.front().command_buffer);
+                _in_flight_command_buffers.pop_front();
+            }
+            _command_buffer_statistics.in_flight_count = _in_flight_command_buffers.size();
+        }
+        if (_in_flight_command_buffers.empty()
+            && _recording_command_buffers.empty()
+            && _free_command_buffers.empty() == false)
+        {
+            getLogicalDevice()->vkResetCommandPool(*getLogicalDevice(), _transient_command_pool, 0);
+        }
+    }
+
     std::shared_ptr<CommandContext> CommandContext::clone() const
     {
         return std::make_shared<CommandContext>(*_logical_device, _queue_family_index, _queue_family_info, CommandContext::CreationToken{});
@@ -1,178 +1,203 @@
 #include <render_engine/DataTransferScheduler.h>
 
 #include <render_engine/containers/VariantOverloaded.h>
+#include <render_engine/DataTransferTasks.h>
 #include <render_engine/resources/Buffer.h>
 #include <render_engine/resources/Texture.h>
+#include <render_engine/TransferEngine.h>
 
-#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <functional>
+#include <map>
+#include <numeric>
 
 namespace RenderEngine
 {
     namespace
     {
-#pragma region Buffer Staging Memory
+#pragma region Transfer Jobs
+        /*
+        * Description of one resource transfer inside a batch.
+        *  - copy_state: state of the resource while the copy command is executed (already on the transfer queue)
+        *  - final_state: state of the resource after the transfer. Its command context is defined by dst_context.
+        */
+        template<typename ResourceType, typename StateType>
+        struct TransferJob
+        {
+            ResourceType* resource{ nullptr };
+            CommandContext* dst_context{ nullptr };
+            bool need_release{ false };
+            bool need_acquire{ false };
+            StateType copy_state;
+            StateType final_state;
+            SyncOperations sync_operations;
+            std::function<void(VkCommandBuffer)> copy_command;
+        };
+        using TextureTransferJob = TransferJob<Texture, TextureState>;
+        using BufferTransferJob = TransferJob<Buffer, BufferState>;
 
-        uint32_t findMemoryType(VkPhysicalDevice physical_device, uint32_t typeFilter, VkMemoryPropertyFlags properties)
+        class TransferJobReferences
         {
-            VkPhysicalDeviceMemoryProperties memProperties;
-            vkGetPhysicalDeviceMemoryProperties(physical_device, &memProperties);
+        public:
+            void add(TextureTransferJob* job) { _texture_jobs.push_back(job); }
+            void add(BufferTransferJob* job) { _buffer_jobs.push_back(job); }
 
-            for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+            void forEach(const auto& function) const
             {
-                if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
+                for (auto* job : _texture_jobs)
                 {
-                    return i;
+                    function(*job);
+                }
+                for (auto* job : _buffer_jobs)
+                {
+                    function(*job);
                 }
             }
+        private:
+            std::vector<TextureTransferJob*> _texture_jobs;
+            std::vector<BufferTransferJob*> _buffer_jobs;
+        };
 
-            throw std::runtime_error("failed to find suitable memory type!");
-        }
-
-        std::pair<VkBuffer, VkDeviceMemory> createBuffer(
-            VkPhysicalDevice physical_device,
-            LogicalDevice& logical_device,
-            VkDeviceSize size,
-            VkBufferUsageFlags usage,
-            VkMemoryPropertyFlags properties)
-        {
-            VkBuffer buffer;
-            VkDeviceMemory buffer_memory;
-            VkBufferCreateInfo bufferInfo{};
-            bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            bufferInfo.size = size;
-            bufferInfo.usage = usage;
-            bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-            if (logical_device->vkCreateBuffer(*logical_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
-            {
-                throw std::runtime_error("failed to create buffer!");
-            }
-
-            VkMemoryRequirements mem_requirements;
-            logical_device->vkGetBufferMemoryRequirements(*logical_device, buffer, &mem_requirements);
+        /*
+        * Resources of the batch that are owned by the same queue family before (release) or after (acquire) the transfer.
+        * The ownership transfer of all of them is done with one barrier in one submit.
+        */
+        struct QueueFamilyGroup
+        {
+            CommandContext* context{ nullptr };
+            TransferJobReferences jobs;
+            SyncOperations sync_operations;
+        };
+#pragma endregion
 
-            VkMemoryAllocateInfo allocInfo{};
+#pragma region Texture Regions
+        std::span<const uint8_t> getImageDataView(const Image& image)
+        {
+            return std::visit(overloaded{
+                              [&](const std::vector<uint8_t>& image_data) { return std::span(image_data); },
+                              [&](const std::vector<float>& image_data) { return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(image_data.data()), image_data.size() * sizeof(float)); } },
+                              image.getData());
+        }
 
-            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocInfo.allocationSize = mem_requirements.size;
-            allocInfo.memoryTypeIndex = findMemoryType(physical_device, mem_requirements.memoryTypeBits, properties);
+        VkDeviceSize getTexelSize(const Image& image)
+        {
+            return image.getSizeInBytes() / (static_cast<VkDeviceSize>(image.getWidth()) * image.getHeight() * image.getDepth());
+        }
 
-            if (logical_device->vkAllocateMemory(*logical_device, &allocInfo, nullptr, &buffer_memory) != VK_SUCCESS)
-            {
-                throw std::runtime_error("failed to allocate buffer memory!");
-            }
+        /*
+        * vkCmdCopyBufferToImage needs buffer offsets that are multiples of both the texel size and 4, e.g. 12 for a
+        * three channel float format.
+        */
+        VkDeviceSize getRegionAlignment(const Image& image)
+        {
+            return std::lcm(getTexelSize(image), VkDeviceSize{ 4 });
+        }
 
-            logical_device->vkBindBufferMemory(*logical_device, buffer, buffer_memory, 0);
-            return { std::move(buffer), std::move(buffer_memory) };
+        VkDeviceSize alignRegionOffset(VkDeviceSize offset, VkDeviceSize alignment)
+        {
+            return (offset + alignment - 1) / alignment * alignment;
         }
-#pragma endregion
 
-#pragma region Texture Upload/Download Commands
-        std::function<void(VkCommandBuffer)> createTextureUnifiedUploadCommand(Texture& texture,
-                                                                               CommandContext& dst_context,
-                                                                               TextureState final_state)
+        /*
+        * Packs the texels of the regions tightly after each other into the staging memory which starts at staging_offset
+        * in the staging buffer. The regions are aligned in the buffer, not in the allocation: the alignment of the
+        * staging allocation is not necessarily a multiple of the texel size.
+        * The returned copy regions have offsets relative to the beginning of the staging allocation.
+        */
+        std::vector<VkBufferImageCopy> packImageRegions(const Image& image,
+                                                        std::span<const VkBufferImageCopy> regions,
+                                                        std::span<uint8_t> staging_memory,
+                                                        VkDeviceSize staging_offset)
         {
-            auto upload_command = [&](VkCommandBuffer command_buffer)
-                {
-                    ResourceStateMachine state_machine(dst_context.getLogicalDevice());
-                    state_machine.recordStateChange(&texture,
-                                                    texture.getResourceState().clone()
-                                                    .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
-                                                    .setAccessFlag(VK_ACCESS_2_TRANSFER_WRITE_BIT)
-                                                    .setImageLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-                    );
-                    state_machine.commitChanges(command_buffer);
+            const std::span<const uint8_t> image_data = getImageDataView(image);
+            const size_t texel_size = getTexelSize(image);
+            const VkDeviceSize region_alignment = getRegionAlignment(image);
+            std::vector<VkBufferImageCopy> result;
+            result.reserve(regions.size());
+
+            VkDeviceSize buffer_offset = 0;
+            for (VkBufferImageCopy region : regions)
+            {
+                buffer_offset = alignRegionOffset(staging_offset + buffer_offset, region_alignment) - staging_offset;
+                region.bufferOffset = buffer_offset;
+                region.bufferRowLength = 0;
+                region.bufferImageHeight = 0;
 
+                const size_t row_size = region.imageExtent.width * texel_size;
+                for (uint32_t z = 0; z < region.imageExtent.depth; ++z)
+                {
+                    for (uint32_t y = 0; y < region.imageExtent.height; ++y)
                     {
-                        VkBufferImageCopy copy_region{};
-                        copy_region.bufferOffset = 0;
-                        copy_region.bufferRowLength = 0;
-                        copy_region.bufferImageHeight = 0;
-
-                        copy_region.imageSubresource.aspectMask = texture.getAspect();
-                        copy_region.imageSubresource.mipLevel = 0;
-                        copy_region.imageSubresource.baseArrayLayer = 0;
-                        copy_region.imageSubresource.layerCount = 1;
-
-                        copy_region.imageOffset = { 0, 0, 0 };
-                        copy_region.imageExtent = {
-                            .width = texture.getImage().getWidth(),
-                            .height = texture.getImage().getHeight(),
-                            .depth = texture.getImage().getDepth()
-                        };
-                        dst_context.getLogicalDevice()->vkCmdCopyBufferToImage(command_buffer,
-                                                                               texture.getStagingBuffer().getBuffer(),
-                                                                               texture.getVkImage(),
-                                                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                                                               1, &copy_region);
+                        const size_t source_texel = (static_cast<size_t>(region.imageOffset.z + z) * image.getHeight() + region.imageOffset.y + y)
+                            * image.getWidth() + region.imageOffset.x;
+                        std::ranges::copy(image_data.subspan(source_texel * texel_size, row_size),
+                                          staging_memory.begin() + buffer_offset);
+                        buffer_offset += row_size;
                     }
-                    state_machine.recordStateChange(&texture,
-                                                    texture.getResourceState().clone()
-                                                    .setPipelineStage(final_state.pipeline_stage)
-                                                    .setAccessFlag(final_state.access_flag)
-                                                    .setImageLayout(final_state.layout));
-                    state_machine.commitChanges(command_buffer);
-                };
-            return upload_command;
+                }
+                result.push_back(region);
+            }
+            return result;
         }
 
-        std::function<void(VkCommandBuffer)> createTextureNotUnifiedUploadCommand(Texture& texture,
-                                                                                  CommandContext* src_context,
-                                                                                  bool initial_transfer)
+        VkDeviceSize calculatePackedSize(const Image& image, std::span<const VkBufferImageCopy> regions)
         {
-            auto upload_command = [&texture, src_context, initial_transfer](VkCommandBuffer command_buffer)
-                {
-                    /*
-                    * Image layout needs to be in dst optimal. When there is no queue ownership transformation
-                    * (i.e.: it is an initial transfer) the layout transformation needs to be done here.
-                    */
-                    if (initial_transfer)
-                    {
-                        ResourceStateMachine state_machine(src_context->getLogicalDevice());
-                        state_machine.recordStateChange(&texture,
-                                                        texture.getResourceState().clone()
-                                                        .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
-                                                        .setAccessFlag(VK_ACCESS_2_TRANSFER_WRITE_BIT)
-                                                        .setImageLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-                        );
-                        state_machine.commitChanges(command_buffer);
-                    }
-                    {
-                        VkBufferImageCopy copy_region{};
-                        copy_region.bufferOffset = 0;
-                        copy_region.bufferRowLength = 0;
-                        copy_region.bufferImageHeight = 0;
-
-                        copy_region.imageSubresource.aspectMask = texture.getAspect();
-                        copy_region.imageSubresource.mipLevel = 0;
-                        copy_region.imageSubresource.baseArrayLayer = 0;
-                        copy_region.imageSubresource.layerCount = 1;
-
-                        copy_region.imageOffset = { 0, 0, 0 };
-                        copy_region.imageExtent = {
-                            .width = texture.getImage().getWidth(),
-                            .height = texture.getImage().getHeight(),
-                            .depth = texture.getImage().getDepth()
-                        };
-                        src_context->getLogicalDevice()->vkCmdCopyBufferToImage(command_buffer,
-                                                                                texture.getStagingBuffer().getBuffer(),
-                                                                                texture.getVkImage(),
-                                                                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                                                                1, &copy_region);
-                    }
+            const VkDeviceSize texel_size = getTexelSize(image);
+            const VkDeviceSize region_alignment = getRegionAlignment(image);
+            VkDeviceSize result = 0;
+            for (const VkBufferImageCopy& region : regions)
+            {
+                // The offset of the allocation is not known yet, the worst case padding is reserved for every region
+                result += region_alignment - 1;
+                result += texel_size * region.imageExtent.width * region.imageExtent.height * region.imageExtent.depth;
+            }
+            return result;
+        }
 
+        VkBufferImageCopy createImageCopyRegion(VkOffset3D offset, VkExtent3D extent)
+        {
+            VkBufferImageCopy copy_region{};
+            copy_region.imageSubresource.mipLevel = 0;
+            copy_region.imageSubresource.baseArrayLayer = 0;
+            copy_region.imageSubresource.layerCount = 1;
+            copy_region.imageOffset = offset;
+            copy_region.imageExtent = extent;
+            return copy_region;
+        }
+#pragma endregion
 
+#pragma region Copy Commands
+        std::function<void(VkCommandBuffer)> createTextureUploadCommand(Texture& texture,
+                                                                        const StagingRingBuffer::Allocation& staging_memory,
+                                                                        std::vector<VkBufferImageCopy> copy_regions,
+                                                                        LogicalDevice& logical_device)
+        {
+            for (VkBufferImageCopy& copy_region : copy_regions)
+            {
+                copy_region.bufferOffset += staging_memory.getOffset();
+                copy_region.imageSubresource.aspectMask = texture.getAspect();
+            }
+            return [&texture, staging_buffer = staging_memory.getBuffer(), copy_regions = std::move(copy_regions), &logical_device](VkCommandBuffer command_buffer)
+                {
+                    logical_device->vkCmdCopyBufferToImage(command_buffer,
+                                                           staging_buffer,
+                                                           texture.getVkImage(),
+                                                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                           static_cast<uint32_t>(copy_regions.size()),
+                                                           copy_regions.data());
                 };
-            return upload_command;
         }
 
-        std::function<void(VkCommandBuffer)> createTextureNotUnifiedDownloadCommand(Texture& texture,
-                                                                                    CommandContext& src_context)
+        std::function<void(VkCommandBuffer)> createTextureDownloadCommand(Texture& texture,
+                                                                          const StagingRingBuffer::Allocation& staging_memory,
+                                                                          LogicalDevice& logical_device)
         {
-            auto download_command = [&texture, &src_context](VkCommandBuffer command_buffer)
+            return [&texture, staging_buffer = staging_memory.getBuffer(), staging_offset = staging_memory.getOffset(), staging_size = staging_memory.getSize(), &logical_device](VkCommandBuffer command_buffer)
                 {
                     VkBufferImageCopy copy_region{};
-                    copy_region.bufferOffset = 0;
+                    copy_region.bufferOffset = staging_offset;
                     copy_region.bufferRowLength = 0;
                     copy_region.bufferImageHeight = 0;
 
@@ -187,332 +212,231 @@ namespace RenderEngine
                         .height = texture.getImage().getHeight(),
                         .depth = texture.getImage().getDepth()
                     };
-                    src_context.getLogicalDevice()->vkCmdCopyImageToBuffer(command_buffer,
-                                                                           texture.getVkImage(),
-                                                                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                                                           texture.getStagingBuffer().getBuffer(),
-                                                                           1, &copy_region);
-
-                };
-            return download_command;
-        }
-
-        std::function<void(VkCommandBuffer)> createTextureUnifiedDownloadCommand(Texture& texture,
-                                                                                 CommandContext& src_context,
-                                                                                 TextureState final_state)
-        {
-            auto download_command = [&](VkCommandBuffer command_buffer)
-                {
-                    ResourceStateMachine state_machine(src_context.getLogicalDevice());
-                    auto old_state = texture.getResourceState();
-                    state_machine.recordStateChange(&texture,
-                                                    texture.getResourceState().clone()
-                                                    .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
-                                                    .setAccessFlag(VK_ACCESS_2_TRANSFER_READ_BIT)
-                                                    .setImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL)
-                    );
-                    state_machine.commitChanges(command_buffer);
-                    {
-                        VkBufferImageCopy copy_region{};
-                        copy_region.bufferOffset = 0;
-                        copy_region.bufferRowLength = 0;
-                        copy_region.bufferImageHeight = 0;
-
-                        copy_region.imageSubresource.aspectMask = texture.getAspect();
-                        copy_region.imageSubresource.mipLevel = 0;
-                        copy_region.imageSubresource.baseArrayLayer = 0;
-                        copy_region.imageSubresource.layerCount = 1;
-
-                        copy_region.imageOffset = { 0, 0, 0 };
-                        copy_region.imageExtent = {
-                            .width = texture.getImage().getWidth(),
-                            .height = texture.getImage().getHeight(),
-                            .depth = texture.getImage().getDepth()
-                        };
-                        src_context.getLogicalDevice()->vkCmdCopyImageToBuffer(command_buffer,
-                                                                               texture.getVkImage(),
-                                                                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                                                               texture.getStagingBuffer().getBuffer(),
-                                                                               1, &copy_region);
-                    }
-
-                    state_machine.recordStateChange(&texture, old_state);
-                    state_machine.commitChanges(command_buffer);
+                    logical_device->vkCmdCopyImageToBuffer(command_buffer,
+                                                           texture.getVkImage(),
+                                                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                           staging_buffer,
+                                                           1, &copy_region);
+
+                    // Make the copy available for the host. The host reads it after invalidating the mapped range.
+                    VkBufferMemoryBarrier2 host_barrier{};
+                    host_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+                    host_barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+                    host_barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+                    host_barrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+                    host_barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+                    host_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    host_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    host_barrier.buffer = staging_buffer;
+                    host_barrier.offset = staging_offset;
+                    host_barrier.size = staging_size;
+
+                    VkDependencyInfo dependency{};
+                    dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+                    dependency.bufferMemoryBarrierCount = 1;
+                    dependency.pBufferMemoryBarriers = &host_barrier;
+                    logical_device->vkCmdPipelineBarrier2(command_buffer, &dependency);
                 };
-            return download_command;
         }
-#pragma endregion
 
-#pragma region Buffer Upload Commands
-        std::function<void(VkCommandBuffer)> createBufferUnifiedUploadCommand(Buffer& buffer,
-                                                                              VkBuffer staging_buffer,
-                                                                              CommandContext& src_context,
-                                                                              BufferState final_buffer_state)
+        std::function<void(VkCommandBuffer)> createBufferUploadCommand(Buffer& buffer,
+                                                                       const StagingRingBuffer::Allocation& staging_memory,
+                                                                       LogicalDevice& logical_device)
         {
-            auto upload_command = [&buffer, &src_context, final_buffer_state, staging_buffer](VkCommandBuffer command_buffer)
+            return [&buffer, staging_buffer = staging_memory.getBuffer(), staging_offset = staging_memory.getOffset(), &logical_device](VkCommandBuffer command_buffer)
                 {
-                    ResourceStateMachine state_machine(src_context.getLogicalDevice());
-                    state_machine.recordStateChange(&buffer,
-                                                    buffer.getResourceState().clone()
-                                                    .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
-                                                    .setAccessFlag(VK_ACCESS_2_TRANSFER_WRITE_BIT));
-                    state_machine.commitChanges(command_buffer);
                     VkBufferCopy copy_region{};
+                    copy_region.srcOffset = staging_offset;
                     copy_region.size = buffer.getDeviceSize();
-                    src_context.getLogicalDevice()->vkCmdCopyBuffer(command_buffer,
-                                                                    staging_buffer,
-                                                                    buffer.getBuffer(),
-                                                                    1,
-                                                                    &copy_region);
-                    state_machine.recordStateChange(&buffer,
-                                                    buffer.getResourceState().clone()
-                                                    .setPipelineStage(final_buffer_state.pipeline_stage)
-                                                    .setAccessFlag(final_buffer_state.access_flag));
-                    state_machine.commitChanges(command_buffer);
+                    logical_device->vkCmdCopyBuffer(command_buffer,
+                                                    staging_buffer,
+                                                    buffer.getBuffer(),
+                                                    1,
+                                                    &copy_region);
                 };
-            return upload_command;
         }
-
-        std::function<void(VkCommandBuffer)> createBufferNotUnifiedUploadCommand(Buffer& buffer,
-                                                                                 VkBuffer staging_buffer,
-                                                                                 CommandContext& dst_context)
-        {
-            auto upload_command = [&buffer, staging_buffer, &dst_context](VkCommandBuffer command_buffer)
-                {
-                    VkBufferCopy copy_region{};
-                    copy_region.size = buffer.getDeviceSize();
-                    dst_context.getLogicalDevice()->vkCmdCopyBuffer(command_buffer,
-                                                                    staging_buffer,
-                                                                    buffer.getBuffer(),
-                                                                    1,
-                                                                    &copy_region);
-                };
-            return upload_command;
-        }
-
 #pragma endregion
 
-#pragma region Queue Transfer Commands
-
-        enum class DataTransferType
+#pragma region Batch Submission
+        /*
+        * Each submission of the batch is a step on the data transfer timeline of the scheduler. The timeline is never reset,
+        * a batch continues from the value where the previous batch finished. Step i waits for value start + i and signals start + i + 1.
+        * It makes the order of the submissions explicit even when they are executed on different queues:
+        *  release submits (one per source queue family) -> transfer submit -> acquire submits (one per destination queue family)
+        * Waiting for the previous batch at the first step keeps the signaled values monotonic across the queues.
+        */
+        SyncOperations createStepOperations(SyncPrimitives& transfer_timeline, SemaphoreId transfer_semaphore, uint64_t batch_start_value, uint64_t step)
         {
-            Upload,
-            Download
-        };
-        [[nodiscard]]
-        SyncObject unifiedQueueTransfer(
-            SyncOperations sync_operations,
-            TransferEngine& transfer_engine,
-            std::function<void(VkCommandBuffer)> upload_command)
-        {
-            SyncObject transfer_sync_object = SyncObject::CreateEmpty(transfer_engine.getTransferContext().getLogicalDevice());
-            transfer_sync_object.createTimelineSemaphore(DataTransferScheduler::kDataTransferFinishSemaphoreName, 0, 2);
-            transfer_sync_object.addSignalOperationToGroup(SyncGroups::kInternal,
-                                                           DataTransferScheduler::kDataTransferFinishSemaphoreName,
-                                                           VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                                                           1);
-            transfer_sync_object.addWaitOperationToGroup(SyncGroups::kExternal,
-                                                         DataTransferScheduler::kDataTransferFinishSemaphoreName,
-                                                         VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                                                         1);
-            transfer_engine.transfer(sync_operations.createUnionWith(transfer_sync_object.getOperationsGroup(SyncGroups::kInternal))
-                                     , upload_command);
-            return transfer_sync_object;
+            SyncOperations result;
+            result.addWaitOperation(transfer_timeline,
+                                    transfer_semaphore,
+                                    VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                    batch_start_value + step);
+            result.addSignalOperation(transfer_timeline,
+                                      transfer_semaphore,
+                                      VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                      batch_start_value + step + 1);
+            return result;
         }
 
-        [[nodiscard]]
-        std::vector<SyncObject> textureNotUnifiedQueueTransfer(Texture& texture,
-                                                               SyncOperations sync_operations,
-                                                               TransferEngine& transfer_engine,
-                                                               CommandContext& src_context,
-                                                               CommandContext& dst_context,
-                                                               TextureState final_state,
-                                                               std::function<void(VkCommandBuffer)> upload_command,
-                                                               DataTransferType transfer_type)
-        {
-            std::vector<SyncObject> result;
-            const bool is_initial_transfer = texture.getResourceState().command_context.expired();
-
-
-            SyncObject transfer_sync_object = SyncObject::CreateEmpty(src_context.getLogicalDevice());
-            transfer_sync_object.createTimelineSemaphore(DataTransferScheduler::kDataTransferFinishSemaphoreName, 0, 2);
-            transfer_sync_object.addSignalOperationToGroup(SyncGroups::kInternal,
-                                                           DataTransferScheduler::kDataTransferFinishSemaphoreName,
-                                                           VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                                                           1);
-            transfer_sync_object.addWaitOperationToGroup(SyncGroups::kExternal,
-                                                         DataTransferScheduler::kDataTransferFinishSemaphoreName,
-                                                         VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                                                         1);
-            if (is_initial_transfer == false)
+        void submitCommands(CommandContext& context,
+                            const SyncOperations& sync_operations,
+                            const std::function<void(VkCommandBuffer)>& record_command)
+        {
+            auto& logical_device = context.getLogicalDevice();
+            VkCommandBuffer command_buffer = context.createCommandBuffer(CommandContext::Usage::SingleSubmit);
+            try
             {
-                VkImageLayout layout_for_copy = transfer_type == DataTransferType::Download
-                    ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-                    : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                SyncObject sync_object_src_to_transfer = ResourceStateMachine::transferOwnership(&texture,
-                                                                                                 texture.getResourceState().clone()
-                                                                                                 .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
-                                                                                                 .setAccessFlag(0)
-                                                                                                 .setImageLayout(layout_for_copy),
-                                                                                                 texture.getResourceState().command_context.lock().get(),
-                                                                                                 &transfer_engine.getTransferContext(),
-                                                                                                 sync_operations.extract(SyncOperations::ExtractWaitOperations));
-
-                transfer_engine.transfer(sync_object_src_to_transfer.getOperationsGroup(SyncGroups::kExternal)
-                                         .createUnionWith(transfer_sync_object.getOperationsGroup(SyncGroups::kInternal)),
-                                         upload_command);
-                result.push_back(std::move(sync_object_src_to_transfer));
+                VkCommandBufferBeginInfo begin_info{};
+                begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
+                if (logical_device->vkBeginCommandBuffer(command_buffer, &begin_info) != VK_SUCCESS)
+                {
+                    throw std::runtime_error("failed to begin recording command buffer!");
+                }
+                record_command(command_buffer);
+                if (logical_device->vkEndCommandBuffer(command_buffer) != VK_SUCCESS)
+                {
+                    throw std::runtime_error("failed to record command buffer!");
+                }
             }
-            else
+            catch (...)
             {
-                SyncObject execution_barrier = ResourceStateMachine::barrier(texture, src_context, sync_operations);
-
-                transfer_engine.transfer(transfer_sync_object.getOperationsGroup(SyncGroups::kInternal)
-                                         .createUnionWith(execution_barrier.getOperationsGroup(SyncGroups::kExternal)),
-                                         upload_command);
-                result.push_back(std::move(execution_barrier));
-
+                context.abandon(command_buffer);
+                throw;
             }
-            assert(texture.getResourceState().getQueueFamilyIndex() == transfer_engine.getTransferContext().getQueueFamilyIndex());
-
-            SyncObject sync_object_transfer_to_dst = ResourceStateMachine::transferOwnership(&texture,
-                                                                                             texture.getResourceState().clone()
-                                                                                             .setPipelineStage(final_state.pipeline_stage)
-                                                                                             .setAccessFlag(0)
-                                                                                             .setImageLayout(final_state.layout),
-                                                                                             texture.getResourceState().command_context.lock().get(),
-                                                                                             &dst_context,
-                                                                                             sync_operations.extract(SyncOperations::ExtractSignalOperations | SyncOperations::ExtractFence)
-                                                                                             .createUnionWith(transfer_sync_object.getOperationsGroup(SyncGroups::kExternal)));
-            assert(texture.getResourceState().getQueueFamilyIndex() == dst_context.getQueueFamilyIndex());
-            result.push_back(std::move(sync_object_transfer_to_dst));
-            result.push_back(std::move(transfer_sync_object));
-            return result;
+            context.submit(command_buffer, sync_operations);
         }
 
-        [[nodiscard]]
-        std::vector<SyncObject> bufferNotUnifiedQueueTransfer(Buffer& buffer,
-                                                              SyncOperations sync_operations,
-                                                              TransferEngine& transfer_engine,
-                                                              CommandContext& src_context,
-                                                              CommandContext& dst_context,
-                                                              BufferState final_buffer_state,
-                                                              std::function<void(VkCommandBuffer)> upload_command)
-        {
-            std::vector<SyncObject> result;
-
-            SyncObject transfer_sync_object = SyncObject::CreateEmpty(src_context.getLogicalDevice());
-            transfer_sync_object.createTimelineSemaphore(DataTransferScheduler::kDataTransferFinishSemaphoreName, 0, 2);
-            transfer_sync_object.addSignalOperationToGroup(SyncGroups::kInternal,
-                                                           DataTransferScheduler::kDataTransferFinishSemaphoreName,
-                                                           VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                                                           1);
-            transfer_sync_object.addWaitOperationToGroup(SyncGroups::kExternal,
-                                                         DataTransferScheduler::kDataTransferFinishSemaphoreName,
-                                                         VK_PIPELINE_STAGE_2_TRANSFER_BIT,
-                                                         1);
-            const bool is_initial_transfer = buffer.getResourceState().command_context.expired();
-
-            if (is_initial_transfer == false)
-            {
-                SyncObject sync_object_src_to_transfer = ResourceStateMachine::transferOwnership(&buffer,
-                                                                                                 buffer.getResourceState().clone()
-                                                                                                 .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
-                                                                                                 .setAccessFlag(0),
-                                                                                                 buffer.getResourceState().command_context.lock().get(),
-                                                                                                 &transfer_engine.getTransferContext(),
-                                                                                                 sync_operations.extract(SyncOperations::ExtractWaitOperations));
-                transfer_engine.transfer(sync_object_src_to_transfer.getOperationsGroup(SyncGroups::kExternal)
-                                         .createUnionWith(transfer_sync_object.getOperationsGroup(SyncGroups::kInternal)),
-                                         upload_command);
-                result.push_back(std::move(sync_object_src_to_transfer));
-
-            }
-            else
+        /*
+        * State of the resource while the queue family ownership is transferred to the destination.
+        * When the transfer queue doesn't support the final pipeline stage the transfer is done with a transfer stage
+        * and the final state is set by an additional barrier on the destination queue.
+        */
+        template<typename ResourceType, typename StateType>
+        StateType createOwnershipState(const TransferJob<ResourceType, StateType>& job, const CommandContext& transfer_context)
+        {
+            StateType result = job.final_state.clone().setCommandContext(job.dst_context->getWeakReference());
+            if (transfer_context.isPipelineStageSupported(result.pipeline_stage) == false)
             {
-                SyncObject execution_barrier = ResourceStateMachine::barrier(&buffer, &src_context, sync_operations);
-                transfer_engine.transfer(execution_barrier.getOperationsGroup(SyncGroups::kExternal)
-                                         .createUnionWith(transfer_sync_object.getOperationsGroup(SyncGroups::kInternal)),
-                                         upload_command);
-                result.push_back(std::move(execution_barrier));
+                result.pipeline_stage = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+                result.access_flag = VK_ACCESS_2_NONE;
             }
-            assert(buffer.getResourceState().getQueueFamilyIndex() == transfer_engine.getTransferContext().getQueueFamilyIndex());
-
-            SyncObject sync_object_transfer_to_dst = ResourceStateMachine::transferOwnership(&buffer,
-                                                                                             buffer.getResourceState().clone()
-                                                                                             .setPipelineStage(final_buffer_state.pipeline_stage)
-                                                                                             .setAccessFlag(0),
-                                                                                             buffer.getResourceState().command_context.lock().get(),
-                                                                                             &dst_context,
-                                                                                             sync_operations.extract(SyncOperations::ExtractSignalOperations)
-                                                                                             .createUnionWith(transfer_sync_object.getOperationsGroup(SyncGroups::kExternal))
-            );
-            assert(buffer.getResourceState().getQueueFamilyIndex() == dst_context.getQueueFamilyIndex());
-            result.push_back(std::move(sync_object_transfer_to_dst));
-            result.push_back(std::move(transfer_sync_object));
             return result;
         }
+
+        template<typename ResourceType, typename StateType>
+        bool needsExtraStateTransition(const TransferJob<ResourceType, StateType>& job, const CommandContext& transfer_context)
+        {
+            return transfer_context.isPipelineStageSupported(job.final_state.pipeline_stage) == false;
+        }
 #pragma endregion
     } // namespace
 
     const std::string DataTransferScheduler::kDataTransferFinishSemaphoreName = "DataTransferFinished";
 
 
+    DataTransferScheduler::DataTransferScheduler(VkPhysicalDevice physical_device,
+                                                 LogicalDevice& logical_device,
+                                                 DeviceMemoryAllocator& memory_allocator,
+                                                 VkDeviceSize upload_ring_size,
+                                                 VkDeviceSize download_ring_size)
+        : _upload_ring(StagingRingBuffer::create(physical_device, logical_device, memory_allocator, upload_ring_size, StagingRingBuffer::Usage::Upload))
+        , _download_ring(StagingRingBuffer::create(physical_device, logical_device, memory_allocator, download_ring_size, StagingRingBuffer::Usage::Download))
+        , _transfer_timeline(std::make_shared<SyncPrimitives>(SyncPrimitives::CreateEmpty(logical_device)))
+    {
+        // The values of the timeline are absolute, it is never stepped.
+        _transfer_semaphore = _transfer_timeline->createTimelineSemaphore(kDataTransferFinishSemaphoreName, 0, 0);
+    }
+
     DataTransferScheduler::~DataTransferScheduler() = default;
 
+    void DataTransferScheduler::releaseFinishedBatches()
+    {
+        std::erase_if(_ongoing_batches, [](auto& batch)
+                      {
+                          if (batch->isFinished() == false)
+                          {
+                              return false;
+                          }
+                          batch->releaseStagingMemory();
+                          return true;
+                      });
+    }
+
     std::weak_ptr<UploadTask> DataTransferScheduler::upload(Texture* texture,
-                                                            Image image,
+                                                            const Image& image,
                                                             CommandContext& dst_context,
                                                             TextureState final_state,
                                                             SyncOperations additional_sync_operations)
     {
-        auto task = [image_to_upload = std::move(image), &dst_context, texture, final_texture_state = std::move(final_state), additional_sync_operations]
-        (SyncOperations sync_operations, TransferEngine& transfer_engine, UploadTask::Storage&) -> std::vector<SyncObject>
-            {
-                if (texture->isImageCompatible(image_to_upload) == false)
-                {
-                    throw std::runtime_error("Input image is incompatible with the texture");
-                }
-                std::span<const uint8_t> data_view =
-                    std::visit(overloaded{
-                               [&](const std::vector<uint8_t>& image_data) { return std::span(image_data); },
-                               [&](const std::vector<float>& image_data) { return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(&image_data[0]), image_data.size() / sizeof(float)); } },
-                               image_to_upload.getData());
-                texture->getStagingBuffer().upload(data_view);
-                const bool is_initial_transfer = texture->getResourceState().command_context.expired();
-
-                if (is_initial_transfer)
-                {
-                    texture->setInitialCommandContext(transfer_engine.getTransferContext().getWeakReference());
-                }
+        const VkBufferImageCopy whole_image = createImageCopyRegion({ 0, 0, 0 },
+                                                                    { image.getWidth(), image.getHeight(), image.getDepth() });
+        return scheduleTextureUpload(texture,
+                                     image,
+                                     std::span(&whole_image, 1),
+                                     dst_context,
+                                     std::move(final_state),
+                                     std::move(additional_sync_operations));
+    }
 
-                auto* src_context = texture->getResourceState().command_context.lock().get();
+    std::weak_ptr<UploadTask> DataTransferScheduler::upload(Texture* texture,
+                                                            const Image& image,
+                                                            std::span<const VkRect2D> regions,
+                                                            CommandContext& dst_context,
+                                                            TextureState final_state,
+                                                            SyncOperations additional_sync_operations)
+    {
+        assert(image.is3D() == false && "Region upload is supported only for 2D images");
+        if (_textures_staging_area.uploads.contains(texture))
+        {
+            // The regions of the pending upload would be lost. Uploading the whole image covers both of them.
+            return upload(texture, image, dst_context, std::move(final_state), std::move(additional_sync_operations));
+        }
+        std::vector<VkBufferImageCopy> copy_regions;
+        copy_regions.reserve(regions.size());
+        for (const VkRect2D& region : regions)
+        {
+            assert(region.offset.x >= 0 && region.offset.y >= 0
+                   && region.offset.x + region.extent.width <= image.getWidth()
+                   && region.offset.y + region.extent.height <= image.getHeight()
+                   && "Upload region is out of the image");
+            copy_regions.push_back(createImageCopyRegion({ region.offset.x, region.offset.y, 0 },
+                                                         { region.extent.width, region.extent.height, 1 }));
+        }
+        return scheduleTextureUpload(texture,
+                                     image,
+                                     copy_regions,
+                                     dst_context,
+                                     std::move(final_state),
+                                     std::move(additional_sync_operations));
+    }
 
-                if (dst_context.getQueueFamilyIndex() != transfer_engine.getTransferContext().getQueueFamilyIndex()
-                    || src_context->getQueueFamilyIndex() != transfer_engine.getTransferContext().getQueueFamilyIndex())
-                {
-                    return textureNotUnifiedQueueTransfer(*texture,
-                                                          sync_operations.createUnionWith(additional_sync_operations),
-                                                          transfer_engine,
-                                                          *src_context,
-                                                          dst_context,
-                                                          std::move(final_texture_state),
-                                                          createTextureNotUnifiedUploadCommand(*texture, src_context, is_initial_transfer),
-                                                          DataTransferType::Upload);
-                }
-                else
-                {
-                    SyncObject transfer_sync_object = unifiedQueueTransfer(sync_operations.createUnionWith(additional_sync_operations),
-                                                                           transfer_engine,
-                                                                           createTextureUnifiedUploadCommand(*texture, dst_context, std::move(final_texture_state)));
-                    std::vector<SyncObject> result;
-                    result.push_back(std::move(transfer_sync_object));
-                    return result;
-                }
-            };
-        std::shared_ptr<UploadTask> result = std::make_shared<UploadTask>(std::move(task));
-        _textures_staging_area.uploads[texture] = result;
+    std::weak_ptr<UploadTask> DataTransferScheduler::scheduleTextureUpload(Texture* texture,
+                                                                           const Image& image,
+                                                                           std::span<const VkBufferImageCopy> regions,
+                                                                           CommandContext& dst_context,
+                                                                           TextureState final_state,
+                                                                           SyncOperations additional_sync_operations)
+    {
+        if (texture->isImageCompatible(image) == false)
+        {
+            throw std::runtime_error("Input image is incompatible with the texture");
+        }
+        assert(regions.empty() == false && "Texture upload needs at least one region");
+
+        // The data is copied into the staging memory right away, thus the image doesn't need to be stored until the execution
+        StagingRingBuffer::Allocation staging_memory = _upload_ring->allocate(calculatePackedSize(image, regions));
+        std::vector<VkBufferImageCopy> copy_regions = packImageRegions(image, regions, staging_memory.getMemory(), staging_memory.getOffset());
+
+        std::shared_ptr<UploadTask> result = std::make_shared<UploadTask>();
+        _textures_staging_area.uploads[texture] = TextureUploadJob{ .staging_memory = std::move(staging_memory),
+            .copy_regions = std::move(copy_regions),
+            .dst_context = &dst_context,
+            .final_state = std::move(final_state),
+            .sync_operations = std::move(additional_sync_operations),
+            .task = result };
         return result;
     }
 
@@ -521,128 +445,294 @@ namespace RenderEngine
                                                             CommandContext& dst_context,
                                                             BufferState final_state)
     {
-        auto task = [data_to_upload = std::move(data), &dst_context, buffer, final_buffer_state = std::move(final_state)]
-        (SyncOperations sync_operations, TransferEngine& transfer_engine, UploadTask::Storage& task_storage) -> std::vector<SyncObject>
+        std::shared_ptr<UploadTask> result = std::make_shared<UploadTask>();
+        _buffers_staging_area.uploads[buffer] = BufferUploadJob{ .data = std::move(data),
+            .dst_context = &dst_context,
+            .final_state = std::move(final_state),
+            .task = result };
+        return result;
+    }
+
+    std::weak_ptr<DownloadTask> DataTransferScheduler::download(Texture* texture,
+                                                                SyncOperations sync_operations)
+    {
+
+        assert(texture->getResourceState().command_context.expired() == false && "For download it should never be an initial transfer");
+
+        std::shared_ptr<DownloadTask> result = std::make_shared<DownloadTask>(texture);
+        _textures_staging_area.downloads[texture] = DownloadJob{ .sync_operations = std::move(sync_operations),
+            .task = result };
+        return result;
+    }
+
+    void DataTransferScheduler::executeJobs(SyncOperations sync_operations, TransferEngine& transfer_engine)
+    {
+        releaseFinishedBatches();
+        if (_textures_staging_area.uploads.empty()
+            && _textures_staging_area.downloads.empty()
+            && _buffers_staging_area.uploads.empty())
+        {
+            return;
+        }
+        CommandContext& transfer_context = transfer_engine.getTransferContext();
+        LogicalDevice& logical_device = transfer_context.getLogicalDevice();
+        const uint32_t transfer_queue_family = transfer_context.getQueueFamilyIndex();
+
+        // Validated before anything is taken from the staging areas, a failed batch leaves every job in place
+        for (const auto& [buffer, upload_job] : _buffers_staging_area.uploads)
+        {
+            const auto device_size = buffer->getDeviceSize();
+            if (device_size != upload_job.data.size())
+            {
+                throw std::runtime_error("Invalid size during upload. Buffer size: " + std::to_string(device_size) + " data to upload: " + std::to_string(upload_job.data.size()));
+            }
+        }
+
+        std::vector<TextureTransferJob> texture_jobs;
+        std::vector<BufferTransferJob> buffer_jobs;
+        std::vector<StagingRingBuffer::Allocation> upload_staging_memory;
+        std::unordered_map<Texture*, StagingRingBuffer::Allocation> download_staging_memory;
+
+        texture_jobs.reserve(_textures_staging_area.uploads.size() + _textures_staging_area.downloads.size());
+        buffer_jobs.reserve(_buffers_staging_area.uploads.size());
+
+        /*
+        * The ownership of a resource is released when it belongs to another queue family.
+        * Initial transfers are started directly on the transfer queue.
+        */
+        auto prepare_job = [&](auto& job)
+            {
+                auto& resource = *job.resource;
+                if (resource.getResourceState().command_context.expired())
+                {
+                    resource.setInitialCommandContext(transfer_context.getWeakReference());
+                }
+                job.need_release = resource.getResourceState().getQueueFamilyIndex() != transfer_queue_family;
+                job.need_acquire = job.dst_context->getQueueFamilyIndex() != transfer_queue_family;
+                job.copy_state = job.copy_state.clone().setCommandContext(job.need_release
+                                                                          ? transfer_context.getWeakReference()
+                                                                          : resource.getResourceState().command_context);
+            };
+#pragma region Host Side Preparation
+        for (auto& [texture, upload_job] : _textures_staging_area.uploads)
+        {
+            texture_jobs.push_back({ .resource = texture,
+                                   .dst_context = upload_job.dst_context,
+                                   .copy_state = TextureState{}
+                                   .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
+                                   .setAccessFlag(VK_ACCESS_2_TRANSFER_WRITE_BIT)
+                                   .setImageLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL),
+                                   .final_state = upload_job.final_state,
+                                   .sync_operations = upload_job.sync_operations,
+                                   .copy_command = createTextureUploadCommand(*texture,
+                                                                              upload_job.staging_memory,
+                                                                              upload_job.copy_regions,
+                                                                              logical_device) });
+            prepare_job(texture_jobs.back());
+        }
+        for (auto& [texture, download_job] : _textures_staging_area.downloads)
+        {
+            if (_textures_staging_area.uploads.contains(texture))
             {
-                auto& logical_device = buffer->getLogicalDevice();
-                const auto device_size = buffer->getDeviceSize();
+                // The download is executed in the next batch to keep the order of the operations
+                continue;
+            }
+            auto owner_context = texture->getResourceState().command_context.lock();
+            StagingRingBuffer::Allocation staging_memory = _download_ring->allocate(texture->getImage().getSizeInBytes());
+            texture_jobs.push_back({ .resource = texture,
+                                   .dst_context = owner_context.get(),
+                                   .copy_state = TextureState{}
+                                   .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
+                                   .setAccessFlag(VK_ACCESS_2_TRANSFER_READ_BIT)
+                                   .setImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL),
+                                   .final_state = texture->getResourceState().clone(),
+                                   .sync_operations = download_job.sync_operations,
+                                   .copy_command = createTextureDownloadCommand(*texture, staging_memory, logical_device) });
+            prepare_job(texture_jobs.back());
+            download_staging_memory.emplace(texture, std::move(staging_memory));
+        }
+        for (auto& [buffer, upload_job] : _buffers_staging_area.uploads)
+        {
+            StagingRingBuffer::Allocation staging_memory = _upload_ring->allocate(buffer->getDeviceSize());
+            staging_memory.upload(upload_job.data);
+
+            buffer_jobs.push_back({ .resource = buffer,
+                                  .dst_context = upload_job.dst_context,
+                                  .copy_state = BufferState{}
+                                  .setPipelineStage(VK_PIPELINE_STAGE_2_TRANSFER_BIT)
+                                  .setAccessFlag(VK_ACCESS_2_TRANSFER_WRITE_BIT),
+                                  .final_state = upload_job.final_state,
+                                  .sync_operations = {},
+                                  .copy_command = createBufferUploadCommand(*buffer, staging_memory, logical_device) });
+            prepare_job(buffer_jobs.back());
+            upload_staging_memory.push_back(std::move(staging_memory));
+        }
+#pragma endregion
+
+#pragma region Grouping
+        TransferJobReferences all_jobs;
+        std::map<uint32_t, QueueFamilyGroup> release_groups;
+        std::map<uint32_t, QueueFamilyGroup> acquire_groups;
+        SyncOperations transfer_operations;
 
-                if (device_size != data_to_upload.size())
+        auto group_job = [&](auto& job)
+            {
+                all_jobs.add(&job);
+                if (job.need_release)
                 {
-                    throw std::runtime_error("Invalid size during upload. Buffer size: " + std::to_string(device_size) + " data to upload: " + std::to_string(data_to_upload.size()));
+                    auto src_context = job.resource->getResourceState().command_context.lock();
+                    auto& group = release_groups[src_context->getQueueFamilyIndex()];
+                    group.context = src_context.get();
+                    group.jobs.add(&job);
+                    group.sync_operations.unionWith(job.sync_operations, SyncOperations::ExtractWaitOperations);
                 }
-                auto [staging_buffer, staging_memory] = createBuffer(buffer->getPhysicalDevice(),
-                                                                     logical_device,
-                                                                     device_size,
-                                                                     VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                                                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-                void* data = nullptr;
-                logical_device->vkMapMemory(*logical_device, staging_memory, 0, device_size, 0, &data);
-                memcpy(data, data_to_upload.data(), static_cast<size_t>(device_size));
-                logical_device->vkUnmapMemory(*logical_device, staging_memory);
-
-                const bool is_initial_transfer = buffer->getResourceState().command_context.expired();
-                if (is_initial_transfer)
+                else
                 {
-                    buffer->setInitialCommandContext(transfer_engine.getTransferContext().getWeakReference());
+                    transfer_operations.unionWith(job.sync_operations, SyncOperations::ExtractWaitOperations);
                 }
-                auto* src_context = buffer->getResourceState().command_context.lock().get();
-                std::vector<SyncObject> result;
-                if (dst_context.getQueueFamilyIndex() != transfer_engine.getTransferContext().getQueueFamilyIndex()
-                    || src_context->getQueueFamilyIndex() != transfer_engine.getTransferContext().getQueueFamilyIndex())
+                if (job.need_acquire)
                 {
-                    result = bufferNotUnifiedQueueTransfer(*buffer,
-                                                           sync_operations,
-                                                           transfer_engine,
-                                                           *src_context,
-                                                           dst_context,
-                                                           final_buffer_state,
-                                                           createBufferNotUnifiedUploadCommand(*buffer, staging_buffer, dst_context));
+                    auto& group = acquire_groups[job.dst_context->getQueueFamilyIndex()];
+                    group.context = job.dst_context;
+                    group.jobs.add(&job);
+                    group.sync_operations.unionWith(job.sync_operations, SyncOperations::ExtractSignalOperations | SyncOperations::ExtractFence);
                 }
                 else
                 {
-                    SyncObject transfer_sync_object = unifiedQueueTransfer(sync_operations,
-                                                                           transfer_engine,
-                                                                           createBufferUnifiedUploadCommand(*buffer,
-                                                                                                            staging_buffer,
-                                                                                                            *src_context,
-                                                                                                            final_buffer_state));
-                    result.push_back(std::move(transfer_sync_object));
+                    transfer_operations.unionWith(job.sync_operations, SyncOperations::ExtractSignalOperations | SyncOperations::ExtractFence);
                 }
-                task_storage.storeStagingData(staging_buffer, staging_memory, &logical_device);
-                return result;
-
             };
-        std::shared_ptr<UploadTask> result = std::make_shared<UploadTask>(std::move(task));
-        _buffers_staging_area.uploads[buffer] = result;
-        return result;
-    }
-
-    std::weak_ptr<DownloadTask> DataTransferScheduler::download(Texture* texture,
-                                                                SyncOperations sync_operations)
-    {
-
-        assert(texture->getResourceState().command_context.expired() == false && "For download it should never be an initial transfer");
+        for (auto& job : texture_jobs)
+        {
+            group_job(job);
+        }
+        for (auto& job : buffer_jobs)
+        {
+            group_job(job);
+        }
+#pragma endregion
 
-        auto task = [texture, additional_sync_operations = sync_operations]
-        (SyncOperations sync_operations, TransferEngine& transfer_engine) -> std::vector<SyncObject>
+#pragma region Submission
+        const uint64_t step_count = release_groups.size() + 1 + acquire_groups.size();
+        const uint64_t batch_start_value = _transfer_timeline_value;
+        uint64_t current_step = 0;
+        auto get_step_operations = [&](const SyncOperations& additional_operations)
             {
-                auto src_context = texture->getResourceState().command_context.lock();
-                if (src_context->getQueueFamilyIndex() != transfer_engine.getTransferContext().getQueueFamilyIndex())
+                SyncOperations result = createStepOperations(*_transfer_timeline, _transfer_semaphore, batch_start_value, current_step);
+                result.unionWith(additional_operations);
+                if (current_step == 0)
                 {
-                    return textureNotUnifiedQueueTransfer(*texture,
-                                                          sync_operations.createUnionWith(additional_sync_operations),
-                                                          transfer_engine,
-                                                          *src_context,
-                                                          *src_context,
-                                                          texture->getResourceState().clone(),
-                                                          createTextureNotUnifiedDownloadCommand(*texture, *src_context),
-                                                          DataTransferType::Download);
+                    result.unionWith(sync_operations, SyncOperations::ExtractWaitOperations);
                 }
-                else
+                if (current_step + 1 == step_count)
                 {
-                    SyncObject transfer_sync_object = unifiedQueueTransfer(sync_operations.createUnionWith(additional_sync_operations),
-                                                                           transfer_engine,
-                                                                           createTextureUnifiedDownloadCommand(*texture,
-                                                                                                               *src_context,
-                                                                                                               texture->getResourceState().clone()));
-                    std::vector<SyncObject> result;
-                    result.push_back(std::move(transfer_sync_object));
-                    return result;
+                    result.unionWith(sync_operations, SyncOperations::ExtractSignalOperations | SyncOperations::ExtractFence);
                 }
+                ++current_step;
+                return result;
             };
-        std::shared_ptr<DownloadTask> result = std::make_shared<DownloadTask>(std::move(task), texture);
-        _textures_staging_area.downloads[texture] = result;
-        return result;
-    }
 
-    void DataTransferScheduler::executeJobs(SyncOperations sync_operations, TransferEngine& transfer_engine)
-    {
-        for (auto [texture, task] : _textures_staging_area.uploads)
+        // Release - One barrier per source queue family. The state of the resources is applied by the acquire on the transfer queue.
+        for (auto& [queue_family_index, group] : release_groups)
         {
-            texture->assignUploadTask(task);
-            task->start({}, sync_operations, transfer_engine);
+            submitCommands(*group.context,
+                           get_step_operations(group.sync_operations.restrict(*group.context)),
+                           [&](VkCommandBuffer command_buffer)
+                           {
+                               ResourceStateMachine state_machine(logical_device);
+                               group.jobs.forEach([&](auto& job) { state_machine.recordStateChange(job.resource, job.copy_state); });
+                               state_machine.commitReleaseChanges(command_buffer);
+                           });
         }
-        for (auto [texture, task] : _textures_staging_area.downloads)
+
+        // Transfer - Acquire and layout transitions, all the copies and the release to the destination queue families.
+        transfer_engine.transfer(get_step_operations(transfer_operations),
+                                 [&](VkCommandBuffer command_buffer)
+                                 {
+                                     ResourceStateMachine state_machine(logical_device);
+                                     all_jobs.forEach([&](auto& job) { state_machine.recordStateChange(job.resource, job.copy_state); });
+                                     state_machine.commitChanges(command_buffer);
+
+                                     all_jobs.forEach([&](auto& job) { job.copy_command(command_buffer); });
+
+                                     // The final states and the releases to the destination queue families share one barrier
+                                     all_jobs.forEach([&](auto& job)
+                                                      {
+                                                          if (job.need_acquire)
+                                                          {
+                                                              state_machine.recordReleaseStateChange(job.resource,
+                                                                                                     createOwnershipState(job, transfer_context));
+                                                          }
+                                                          else
+                                                          {
+                                                              state_machine.recordStateChange(job.resource,
+                                                                                              job.final_state.clone()
+                                                                                              .setCommandContext(job.resource->getResourceState().command_context));
+                                                          }
+                                                      });
+                                     state_machine.commitChanges(command_buffer);
+                                 });
+
+        // Acquire - One barrier per destination queue family and an additional one for the stages that the transfer queue doesn't support.
+        for (auto& [queue_family_index, group] : acquire_groups)
         {
-            texture->assignDownloadTask(task);
-            task->start({}, sync_operations, transfer_engine);
+            submitCommands(*group.context,
+                           get_step_operations(group.sync_operations.restrict(*group.context)),
+                           [&](VkCommandBuffer command_buffer)
+                           {
+                               ResourceStateMachine state_machine(logical_device);
+                               group.jobs.forEach([&](auto& job) { state_machine.recordStateChange(job.resource, createOwnershipState(job, transfer_context)); });
+                               state_machine.commitChanges(command_buffer);
+
+                               group.jobs.forEach([&](auto& job)
+                                                  {
+                                                      if (needsExtraStateTransition(job, transfer_context))
+                                                      {
+                                                          state_machine.recordStateChange(job.resource,
+                                                                                          job.final_state.clone()
+                                                                                          .setCommandContext(job.dst_context->getWeakReference()));
+                                                      }
+                                                  });
+                               state_machine.commitChanges(command_buffer);
+                           });
         }
-        for (auto [buffer, task] : _buffers_staging_area.uploads)
+        assert(current_step == step_count && "Each step of the batch needs to be submitted");
+#pragma endregion
+
+        _transfer_timeline_value = batch_start_value + step_count;
+        auto batch = std::make_shared<DataTransferBatch>(_transfer_timeline, _transfer_semaphore, _transfer_timeline_value);
+        for (auto& staging_memory : upload_staging_memory)
         {
-            buffer->assignUploadTask(task);
-            task->start({}, sync_operations, transfer_engine);
+            batch->storeStagingMemory(std::move(staging_memory));
         }
-        for (auto [buffer, task] : _buffers_staging_area.downloads)
+        _ongoing_batches.push_back(batch);
+
+        for (auto& [texture, upload_job] : _textures_staging_area.uploads)
+        {
+            // Kept by the staging area until the batch is submitted
+            batch->storeStagingMemory(std::move(upload_job.staging_memory));
+            texture->assignUploadTask(upload_job.task);
+            upload_job.task->start({}, batch);
+        }
+        for (auto& [buffer, upload_job] : _buffers_staging_area.uploads)
         {
-            buffer->assignDownloadTask(task);
-            task->start({}, sync_operations, transfer_engine);
+            buffer->assignUploadTask(upload_job.task);
+            upload_job.task->start({}, batch);
         }
-        _textures_staging_area.downloads.clear();
+        std::erase_if(_textures_staging_area.downloads, [&](auto& item)
+                      {
+                          auto& [texture, download_job] = item;
+                          if (_textures_staging_area.uploads.contains(texture))
+                          {
+                              return false;
+                          }
+                          texture->assignDownloadTask(download_job.task);
+                          download_job.task->start({}, batch, std::move(download_staging_memory.at(texture)));
+                          return true;
+                      });
         _textures_staging_area.uploads.clear();
-        _buffers_staging_area.downloads.clear();
         _buffers_staging_area.uploads.clear();
+        _buffers_staging_area.downloads.clear();
     }
     std::weak_ptr<UploadTask> DataTransferScheduler::upload(Buffer* buffer, std::span<const uint8_t> data, CommandContext& dst_context, BufferState final_state)
     {
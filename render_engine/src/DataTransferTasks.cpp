@@ -4,85 +4,171 @@
 #include <render_engine/DataTransferScheduler.h>
 #include <render_engine/resources/Texture.h>
 
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
 namespace RenderEngine
 {
-    UploadTask::Storage::~Storage()
+    DataTransferBatch::DataTransferBatch(std::shared_ptr<SyncPrimitives> transfer_timeline, SemaphoreId transfer_semaphore, uint64_t finish_value)
+        : _transfer_timeline(std::move(transfer_timeline))
+        , _transfer_semaphore(transfer_semaphore)
+        , _finish_value(finish_value)
     {
-        if (_logical_device)
+        assert(_transfer_timeline->hasTimelineSemaphore(_transfer_timeline->getSemaphoreName(_transfer_semaphore))
+               && "The batch needs to have the timeline semaphore that can be waited");
+        _sync_operations.addWaitOperation(*_transfer_timeline,
+                                          _transfer_semaphore,
+                                          VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                          _finish_value);
+    }
+
+    DataTransferBatch::~DataTransferBatch() = default;
+
+    void DataTransferBatch::storeStagingMemory(StagingRingBuffer::Allocation staging_memory)
+    {
+        _staging_memory.push_back(std::move(staging_memory));
+    }
+
+    void DataTransferBatch::releaseStagingMemory()
+    {
+        assert(isFinished() && "Staging memory can be released only when the transfer is finished");
+        _staging_memory.clear();
+    }
+
+    SyncOperations DataTransferBatch::getSyncOperations() const
+    {
+        return _sync_operations;
+    }
+
+    bool DataTransferBatch::isFinished()
+    {
+        if (_finished == false)
         {
-            auto& logical_device = *_logical_device;
-            logical_device->vkDestroyBuffer(*logical_device, _staging_buffer, nullptr);
-            logical_device->vkFreeMemory(*logical_device, _staging_memory, nullptr);
+            auto& logical_device = _transfer_timeline->getLogicalDevice();
+            uint64_t value = 0;
+            if (logical_device->vkGetSemaphoreCounterValue(*logical_device,
+                                                           _transfer_timeline->getSemaphore(_transfer_semaphore),
+                                                           &value) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Couldn't read the data transfer timeline value");
+            }
+            _finished = value >= _finish_value;
         }
+        return _finished;
     }
 
-    void UploadTask::Storage::storeStagingData(VkBuffer buffer, VkDeviceMemory memory, LogicalDevice* logical_device)
+    void DataTransferBatch::wait()
     {
-        _logical_device = logical_device;
-        _staging_buffer = buffer;
-        _staging_memory = memory;
+        if (_finished)
+        {
+            return;
+        }
+        auto& logical_device = _transfer_timeline->getLogicalDevice();
+        VkSemaphoreWaitInfo wait_info{};
+        wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        wait_info.pSemaphores = &_transfer_timeline->getSemaphore(_transfer_semaphore);
+        wait_info.semaphoreCount = 1;
+        wait_info.pValues = &_finish_value;
+        if (logical_device->vkWaitSemaphores(*logical_device, &wait_info, UINT64_MAX) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Couldn't wait for the data transfer timeline");
+        }
+        _finished = true;
     }
 
     bool UploadTask::isStarted() const
     {
-        return _started;
+        return _batch != nullptr;
     }
 
-    void UploadTask::start(StartToken, SyncOperations in_operations, TransferEngine& transfer_engine)
+    void UploadTask::start(StartToken, std::shared_ptr<DataTransferBatch> batch)
     {
-        _transfer_objects = _task(in_operations, transfer_engine, _storage);
-        assert(_transfer_objects.empty() == false && "transfer must return at leas one sync objects to be able to wait for its finish");
-        assert(_transfer_objects.back().getPrimitives().hasTimelineSemaphore(DataTransferScheduler::kDataTransferFinishSemaphoreName)
-               && "The last object needs to have the timeline semaphore that can be waited");
+        assert(batch != nullptr && "Task can be started only as part of a batch");
+        _batch = std::move(batch);
     }
 
     SyncOperations UploadTask::getSyncOperations() const
     {
         // TODO: Implement multi threaded upload
         assert(isStarted() && "Until the engine is not multi threaded the operation needs to be started before it is waited.");
-        return _transfer_objects.back().getOperationsGroup(SyncGroups::kExternal);
+        return _batch->getSyncOperations();
     }
 
-    bool DownloadTask::isStarted() const
+    bool UploadTask::isFinished()
     {
-        return _started;
+        return isStarted() && _batch->isFinished();
     }
 
-    bool UploadTask::isFinished()
+    bool DownloadTask::isStarted() const
     {
-        return _transfer_objects.back().getSemaphoreValue(DataTransferScheduler::kDataTransferFinishSemaphoreName) == 1;
+        return _batch != nullptr;
     }
 
-    void DownloadTask::start(StartToken, SyncOperations in_operations, TransferEngine& transfer_engine)
+    void DownloadTask::start(StartToken, std::shared_ptr<DataTransferBatch> batch, StagingRingBuffer::Allocation staging_memory)
     {
-        _transfer_objects = _task(in_operations, transfer_engine);
-        assert(_transfer_objects.empty() == false && "transfer must return at leas one sync objects to be able to wait for its finish");
-        assert(_transfer_objects.back().getPrimitives().hasTimelineSemaphore(DataTransferScheduler::kDataTransferFinishSemaphoreName)
-               && "The last object needs to have the timeline semaphore that can be waited");
+        assert(batch != nullptr && "Task can be started only as part of a batch");
+        _batch = std::move(batch);
+        _staging_memory = std::move(staging_memory);
     }
 
     SyncOperations DownloadTask::getSyncOperations() const
     {
         // TODO: Implement multi threaded upload
         assert(isStarted() && "Until the engine is not multi threaded the operation needs to be started before it is waited.");
-        return _transfer_objects.back().getOperationsGroup(SyncGroups::kExternal);
+        return _batch->getSyncOperations();
     }
 
     Image DownloadTask::getImage()
     {
-        _transfer_objects.back().waitSemaphore(DataTransferScheduler::kDataTransferFinishSemaphoreName, 1);
-        std::vector<uint8_t> data(_texture->getStagingBuffer().getDeviceSize());
-        const uint8_t* staging_memory = static_cast<const uint8_t*>(_texture->getStagingBuffer().getMemory());
-        std::copy(staging_memory,
-                  staging_memory + data.size(), data.data());
-        Image result = _texture->getImage();
-        result.setData(std::move(data));
-        return result;
+        const Image& texture_image = _texture->getImage();
+        std::vector<uint8_t> data(texture_image.getSizeInBytes());
+        getInto(data);
+        return Image(texture_image.getWidth(),
+                     texture_image.getHeight(),
+                     texture_image.getDepth(),
+                     texture_image.getFormat(),
+                     std::move(data));
+    }
+
+    size_t DownloadTask::getSizeInBytes() const
+    {
+        return _texture->getImage().getSizeInBytes();
+    }
+
+    void DownloadTask::getInto(std::span<uint8_t> destination, size_t destination_row_pitch)
+    {
+        assert(isStarted() && "Download needs to be started before its image is accessed.");
+        _batch->wait();
+        _staging_memory.invalidate();
+
+        const Image& texture_image = _texture->getImage();
+        const size_t size_in_bytes = texture_image.getSizeInBytes();
+        std::span<const uint8_t> staging_memory = _staging_memory.getMemory().first(size_in_bytes);
+
+        const size_t row_count = static_cast<size_t>(texture_image.getHeight()) * texture_image.getDepth();
+        const size_t row_size = size_in_bytes / row_count;
+        if (destination_row_pitch == 0 || destination_row_pitch == row_size)
+        {
+            if (destination.size() < size_in_bytes)
+            {
+                throw std::runtime_error("Destination is too small for the downloaded image");
+            }
+            std::ranges::copy(staging_memory, destination.begin());
+            return;
+        }
+        if (destination_row_pitch < row_size || destination.size() < destination_row_pitch * (row_count - 1) + row_size)
+        {
+            throw std::runtime_error("Destination is too small for the downloaded image with the given row pitch");
+        }
+        for (size_t row = 0; row < row_count; ++row)
+        {
+            std::ranges::copy(staging_memory.subspan(row * row_size, row_size),
+                              destination.begin() + row * destination_row_pitch);
+        }
     }
 
     bool DownloadTask::isFinished()
     {
-        return _transfer_objects.back().getSemaphoreValue(DataTransferScheduler::kDataTransferFinishSemaphoreName) == 1;
+        return isStarted() && _batch->isFinished();
     }
-}
\ No newline at end of file
+}
@@ -8,13 +8,17 @@ namespace RenderEngine
 
     Debugger::GuiCallbackToken::~GuiCallbackToken()
     {
-        _debugger.removeCallback(_callback);
+        if (_debugger != nullptr)
+        {
+            _debugger->removeCallback(_callback_id);
+        }
     }
 
     Debugger::GuiCallbackToken Debugger::addGuiCallback(std::function<void()> callback)
     {
-        _on_gui_callbacks.push_back(std::move(callback));
-        return Debugger::GuiCallbackToken(*this, _on_gui_callbacks.back());
+        const uint64_t callback_id = _next_callback_id++;
+        _on_gui_callbacks.push_back(GuiCallback{ .id = callback_id, .callback = std::move(callback) });
+        return Debugger::GuiCallbackToken(*this, callback_id);
     }
     void Debugger::print(std::string_view msg)
     {
@@ -22,13 +26,13 @@ namespace RenderEngine
     }
     void Debugger::callGuiCallbacks() const
     {
-        for (const auto& callback : _on_gui_callbacks)
+        for (const auto& gui_callback : _on_gui_callbacks)
         {
-            callback();
+            gui_callback.callback();
         }
     }
-    void Debugger::removeCallback(std::function<void()>& callback)
+    void Debugger::removeCallback(uint64_t callback_id)
     {
-        std::erase_if(_on_gui_callbacks, [&](auto& stored_callback) { return &stored_callback == &callback; });
+        std::erase_if(_on_gui_callbacks, [&](const GuiCallback& gui_callback) { return gui_callback.id == callback_id; });
     }
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 
 #include <volk.h>
 
+#include <render_engine/FrameScheduler.h>
 #include <render_engine/GpuResourceManager.h>
+#include <render_engine/memory/DeviceMemoryAllocator.h>
+#include <render_engine/memory/MemoryTracker.h>
+#include <render_engine/memory/TransientResourcePool.h>
 #include <render_engine/RenderContext.h>
 #include <render_engine/RenderEngine.h>
 #include <render_engine/resources/Texture.h>
@@ -12,9 +16,11 @@
 
 #include <GLFW/glfw3native.h>
 
+#include <algorithm>
 #include <optional>
 #include <set>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 #include <vulkan/vulkan_win32.h>
@@ -26,6 +32,8 @@ namespace
     // TODO support multiple queue count
     constexpr uint32_t k_supported_queue_count = 1;
     constexpr uint32_t k_num_of_cuda_streams = 8;
+    constexpr VkDeviceSize k_upload_ring_size = 64 * 1024 * 1024;
+    constexpr VkDeviceSize k_download_ring_size = 64 * 1024 * 1024;
 
     VkDevice createVulkanLogicalDevice(uint32_t queue_count,
                                        VkPhysicalDevice physical_device,
@@ -131,6 +139,11 @@ namespace
         vkGetPhysicalDeviceProperties2(physical_device, &device_property);
         return device_id_property;
     }
+
+    bool isExtensionEnabled(const std::vector<const char*>& device_extensions, std::string_view extension_name)
+    {
+        return std::ranges::any_of(device_extensions, [&](const char* name) { return extension_name == name; });
+    }
 }
 
 namespace RenderEngine
@@ -161,14 +174,20 @@ namespace RenderEngine
     Device::StagingArea::StagingArea(std::unique_ptr<TransferEngine> transfer_engine,
                                      std::set<uint32_t> queue_family_indexes,
                                      VkPhysicalDevice physical_device,
-                                     LogicalDevice& logical_device)
-        : _scheduler(std::make_unique<DataTransferScheduler>())
+                                     LogicalDevice& logical_device,
+                                     DeviceMemoryAllocator& memory_allocator)
+        : _scheduler(std::make_unique<DataTransferScheduler>(physical_device,
+                                                             logical_device,
+                                                             memory_allocator,
+                                                             k_upload_ring_size,
+                                                             k_download_ring_size))
         , _transfer_engine(std::move(transfer_engine))
         , _texture_factory(std::make_unique<TextureFactory>(*_transfer_engine,
                                                             *_scheduler,
                                                             std::move(queue_family_indexes),
                                                             physical_device,
-                                                            logical_device))
+                                                            logical_device,
+                                                            memory_allocator))
     {
 
     }
@@ -180,6 +199,7 @@ namespace RenderEngine
     }
     void Device::StagingArea::synchronizeStagingArea(SyncOperations sync_operations)
     {
+        _transfer_engine->getTransferContext().recycleCommandBuffers();
         _scheduler->executeJobs(sync_operations, *_transfer_engine);
     }
 
@@ -207,10 +227,20 @@ namespace RenderEngine
         , _queue_family_transfer(queue_family_index_transfer)
         , _cuda_device(CudaCompute::CudaDevice::createDeviceForUUID(std::span{ &getDeviceUUID(physical_device).deviceUUID[0], VK_UUID_SIZE }, k_num_of_cuda_streams))
         , _device_info(std::move(device_info))
+        , _memory_allocator(std::make_unique<DeviceMemoryAllocator>(_physical_device, _logical_device))
         , _staging_area(createTransferEngine(),
                         std::set{ _queue_family_transfer, _queue_family_graphics },
                         _physical_device,
-                        _logical_device)
+                        _logical_device,
+                        *_memory_allocator)
+        , _transient_resource_pool(std::make_unique<TransientResourcePool>(_staging_area.getTextureFactory(),
+                                                                           _logical_device,
+                                                                           *_memory_allocator))
+        , _memory_tracker(std::make_unique<MemoryTracker>(_physical_device,
+                                                          *_memory_allocator,
+                                                          *_transient_resource_pool,
+                                                          isExtensionEnabled(device_extensions, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)))
+        , _frame_scheduler(std::make_unique<FrameScheduler>(*this))
     {}
 
     Device::~Device()
@@ -220,6 +250,7 @@ namespace RenderEngine
     void Device::destroy() noexcept
     {
         _cuda_device.reset();
+        _frame_scheduler.reset();
         _staging_area.destroy();
     }
     std::unique_ptr<Window> Device::createWindow(std::string_view name, uint32_t back_buffer_size)
@@ -265,7 +296,7 @@ namespace RenderEngine
         }
     }
 
-    std::unique_ptr<OffScreenWindow> Device::createOffScreenWindow(uint32_t back_buffer_size)
+    std::unique_ptr<OffScreenWindow> Device::createOffScreenWindow(uint32_t back_buffer_size, uint32_t readback_frames_in_flight)
     {
         VkQueue render_queue;
         VkQueue present_queue;
@@ -288,7 +319,8 @@ namespace RenderEngine
         }
         return std::make_unique<OffScreenWindow>(*this,
                                                  std::move(render_engine),
-                                                 std::move(render_target_textures));
+                                                 std::move(render_target_textures),
+                                                 readback_frames_in_flight);
     }
 
     std::unique_ptr<RenderEngine> Device::createRenderEngine(uint32_t back_buffer_size)
@@ -307,7 +339,7 @@ namespace RenderEngine
 
     void Device::waitIdle()
     {
-        _logical_device->vkDeviceWaitIdle(*_logical_device);
+        _logical_device.waitIdle();
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include <render_engine/FrameScheduler.h>
+
+#include <render_engine/Device.h>
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+namespace RenderEngine
+{
+    FrameScheduler::Batch::~Batch()
+    {
+        if (_scheduler != nullptr)
+        {
+            _scheduler->endBatch(false);
+        }
+    }
+
+    void FrameScheduler::Batch::submit()
+    {
+        assert(_scheduler != nullptr && "Frame batch is closed twice");
+        std::exchange(_scheduler, nullptr)->endBatch(true);
+    }
+
+    FrameScheduler::Batch::Batch(Batch&& o) noexcept
+        : _scheduler(std::exchange(o._scheduler, nullptr))
+    {}
+
+    FrameScheduler::FrameScheduler(Device& device)
+        : _device(device)
+    {}
+
+    FrameScheduler::~FrameScheduler()
+    {
+        assert(_open_batch_count == 0 && "Frame batches outlive their scheduler");
+        assert(_submissions.empty() && "Submissions of the frame scheduler are not flushed");
+    }
+
+    FrameScheduler::Batch FrameScheduler::createBatch()
+    {
+        std::unique_lock lock(_mutex);
+        _open_batch_count++;
+        return Batch{ *this };
+    }
+
+    void FrameScheduler::submit(Submission&& submission)
+    {
+        std::unique_lock lock(_mutex);
+        _staging_area_flush_requested = true;
+        if (submission.command_buffers.empty() == false)
+        {
+            _submissions.push_back(std::move(submission));
+        }
+        if (_open_batch_count == 0)
+        {
+            flushLocked(lock);
+        }
+    }
+
+    void FrameScheduler::flush()
+    {
+        std::unique_lock lock(_mutex);
+        flushLocked(lock);
+    }
+
+    void FrameScheduler::endBatch(bool flush)
+    {
+        std::unique_lock lock(_mutex);
+        assert(_open_batch_count > 0 && "Frame batch is closed twice");
+        _open_batch_count--;
+        if (_open_batch_count == 0 && flush)
+        {
+            flushLocked(lock);
+        }
+    }
+
+    void FrameScheduler::flushLocked(std::unique_lock<std::mutex>& lock)
+    {
+        if (std::exchange(_staging_area_flush_requested, false) == false)
+        {
+            assert(_submissions.empty() && "Submissions are queued without a flush request");
+            return;
+        }
+        // Taken before anything can fail, a failed flush never leaves submissions for the next one
+        std::vector<Submission> submissions = std::exchange(_submissions, {});
+
+        // The uploads requested while recording the frames have to be submitted before the draw calls
+        _device.getStagingArea().synchronizeStagingArea({});
+
+        auto& logical_device = _device.getLogicalDevice();
+
+        std::vector<VkQueue> visited_queues;
+        std::vector<VkQueue> submitted_queues;
+        std::vector<VkSubmitInfo2> submit_infos;
+        std::vector<VkFence> fences;
+        std::exception_ptr error;
+        for (const Submission& first_submission : submissions)
+        {
+            const VkQueue queue = first_submission.queue;
+            if (std::ranges::find(visited_queues, queue) != visited_queues.end())
+            {
+                continue;
+            }
+            visited_queues.push_back(queue);
+
+            submit_infos.clear();
+            fences.clear();
+            for (const Submission& submission : submissions
+                 | std::views::filter([&](const Submission& submission) { return submission.queue == queue; }))
+            {
+                VkSubmitInfo2 submit_info{};
+                submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+                submit_info.commandBufferInfoCount = static_cast<uint32_t>(submission.command_buffers.size());
+                submit_info.pCommandBufferInfos = submission.command_buffers.data();
+                submission.sync_operations.fillInfo(submit_info);
+                submit_infos.push_back(submit_info);
+                if (submission.sync_operations.hasAnyFence())
+                {
+                    fences.push_back(submission.sync_operations.getFence());
+                }
+            }
+
+            const VkFence batch_fence = fences.empty() ? VK_NULL_HANDLE : fences.front();
+            auto queue_lock = logical_device.lockQueue(queue);
+            if (logical_device->vkQueueSubmit2(queue, static_cast<uint32_t>(submit_infos.size()), submit_infos.data(), batch_fence) != VK_SUCCESS)
+            {
+                // The other queues are still submitted, their frames don't depend on this one
+                if (error == nullptr)
+                {
+                    error = std::make_exception_ptr(std::runtime_error("failed to submit draw command buffers!"));
+                }
+                continue;
+            }
+            submitted_queues.push_back(queue);
+            // One submit signals only one fence. The rest are signaled by empty submits, which complete with every
+            // work submitted to the queue before them.
+            for (VkFence fence : fences | std::views::drop(1))
+            {
+                if (logical_device->vkQueueSubmit2(queue, 0, nullptr, fence) != VK_SUCCESS && error == nullptr)
+                {
+                    error = std::make_exception_ptr(std::runtime_error("failed to submit frame fence!"));
+                }
+            }
+        }
+        lock.unlock();
+
+        // Presenting a frame that wasn't submitted would wait for a semaphore that is never signaled
+        for (Submission& submission : submissions)
+        {
+            if (submission.on_submitted && std::ranges::find(submitted_queues, submission.queue) != submitted_queues.end())
+            {
+                submission.on_submitted();
+            }
+        }
+        if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
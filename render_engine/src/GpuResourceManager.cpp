@@ -2,62 +2,54 @@
 
 #include <render_engine/resources/Buffer.h>
 
-#include <array>
 namespace RenderEngine
 {
 
     namespace
     {
-        BufferInfo createBufferInfoForAttributeBuffer(VkBufferUsageFlags usage, VkDeviceSize size)
+        constexpr VkDeviceSize kUniformRingBufferSizePerFrame = 4 * 1024 * 1024;
+
+        BufferInfo createBufferInfoForAttributeBuffer(VkBufferUsageFlags usage, VkDeviceSize size, MemorySubsystem subsystem)
         {
-            return { usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, size, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT };
+            return { .usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                .size = size,
+                .memory_properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                .subsystem = subsystem };
         }
-        BufferInfo createBufferInfoForUniformBuffer(VkDeviceSize size)
+        BufferInfo createBufferInfoForUniformBuffer(VkDeviceSize size, MemorySubsystem subsystem)
         {
-            return { VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, size, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT };
-
+            return { .usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                .size = size,
+                .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                .subsystem = subsystem };
         }
     }
     GpuResourceManager::GpuResourceManager(VkPhysicalDevice physical_device,
                                            LogicalDevice& logical_device,
-                                           uint32_t back_buffer_size,
-                                           uint32_t max_num_of_resources)
+                                           DeviceMemoryAllocator& memory_allocator,
+                                           uint32_t back_buffer_size)
         : _physical_device(physical_device)
         , _logical_device(logical_device)
+        , _memory_allocator(memory_allocator)
         , _back_buffer_size(back_buffer_size)
-    {
-        std::array<VkDescriptorPoolSize, 2> pool_sizes;
-
-        pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        pool_sizes[0].descriptorCount = back_buffer_size * max_num_of_resources;
-
-        pool_sizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        pool_sizes[1].descriptorCount = back_buffer_size * max_num_of_resources;
+        , _descriptor_allocator(logical_device, back_buffer_size)
+        , _uniform_ring_buffer(physical_device, logical_device, memory_allocator, back_buffer_size, kUniformRingBufferSizePerFrame)
+    {}
 
-        VkDescriptorPoolCreateInfo poolInfo{};
-        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolInfo.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
-        poolInfo.pPoolSizes = pool_sizes.data();
-        poolInfo.maxSets = back_buffer_size * max_num_of_resources;
-
-
-        if (_logical_device->vkCreateDescriptorPool(*_logical_device, &poolInfo, nullptr, &_descriptor_pool) != VK_SUCCESS)
-        {
-            throw std::runtime_error("failed to create descriptor pool!");
-        }
-    }
+    GpuResourceManager::~GpuResourceManager() = default;
 
-    GpuResourceManager::~GpuResourceManager()
+    void GpuResourceManager::onFrameBegin(uint32_t back_buffer_index)
     {
-        _logical_device->vkDestroyDescriptorPool(*_logical_device, _descriptor_pool, nullptr);
+        _descriptor_allocator.onFrameBegin(back_buffer_index);
+        _uniform_ring_buffer.onFrameBegin(back_buffer_index);
     }
 
-    std::unique_ptr<Buffer> GpuResourceManager::createAttributeBuffer(VkBufferUsageFlags usage, VkDeviceSize size)
+    std::unique_ptr<Buffer> GpuResourceManager::createAttributeBuffer(VkBufferUsageFlags usage, VkDeviceSize size, MemorySubsystem subsystem)
     {
-        return std::make_unique<Buffer>(_physical_device, _logical_device, createBufferInfoForAttributeBuffer(usage, size));
+        return std::make_unique<Buffer>(_physical_device, _logical_device, _memory_allocator, createBufferInfoForAttributeBuffer(usage, size, subsystem));
     }
-    std::unique_ptr<CoherentBuffer> GpuResourceManager::createUniformBuffer(VkDeviceSize size)
+    std::unique_ptr<CoherentBuffer> GpuResourceManager::createUniformBuffer(VkDeviceSize size, MemorySubsystem subsystem)
     {
-        return std::make_unique<CoherentBuffer>(_physical_device, _logical_device, createBufferInfoForUniformBuffer(size));
+        return std::make_unique<CoherentBuffer>(_physical_device, _logical_device, _memory_allocator, createBufferInfoForUniformBuffer(size, subsystem));
     }
 }
@@ -0,0 +1,378 @@
+#include <render_engine/JobSystem.h>
+
+#include <cassert>
+#include <utility>
+
+#include <imgui.h>
+
+#include <Windows.h>
+
+namespace RenderEngine
+{
+    namespace
+    {
+        struct CurrentWorker
+        {
+            const JobSystem* job_system{ nullptr };
+            uint32_t worker_index{ 0 };
+        };
+        thread_local CurrentWorker g_current_worker;
+
+        void pinCurrentThread(uint32_t core_index)
+        {
+            // Without processor groups only the first 64 cores can be addressed
+            if (core_index >= 64)
+            {
+                return;
+            }
+            // The affinity is only a tuning option, the worker runs on any core when it cannot be set
+            SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << core_index);
+        }
+
+        int64_t nanosecondsSince(std::chrono::steady_clock::time_point& start)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const auto result = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+            start = now;
+            return result;
+        }
+    }
+
+    JobSystem::JobSystem(InitializationInfo info)
+        : _on_worker_state_changed(std::move(info.on_worker_state_changed))
+    {
+        const uint32_t core_count = std::thread::hardware_concurrency();
+        const uint32_t worker_count = info.worker_thread_count != 0
+            ? info.worker_thread_count
+            : (core_count > 2 ? core_count - 1 : 1);
+
+        _workers.reserve(worker_count);
+        for (uint32_t i = 0; i < worker_count; ++i)
+        {
+            _workers.push_back(std::make_unique<Worker>());
+        }
+        // The workers are started after all of them exist, they steal from each other
+        for (uint32_t i = 0; i < worker_count; ++i)
+        {
+            _workers[i]->thread = std::thread([this, i, core_count, pin = info.pin_worker_threads]
+                                              {
+                                                  if (pin && core_count > 0)
+                                                  {
+                                                      pinCurrentThread((i + 1) % core_count);
+                                                  }
+                                                  run(i);
+                                              });
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::unique_lock lock(_wake_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto& worker : _workers)
+        {
+            worker->thread.join();
+        }
+    }
+
+    void JobSystem::submit(Job job, Counter* counter, Counter* dependency)
+    {
+        assert((counter == nullptr || counter != dependency) && "Job cannot depend on its own counter");
+        if (counter != nullptr)
+        {
+            counter->_value++;
+        }
+        PendingJob pending_job{ .job = std::move(job), .counter = counter };
+        if (dependency != nullptr)
+        {
+            std::unique_lock lock(dependency->_mutex);
+            if (dependency->_value != 0)
+            {
+                dependency->_dependents.push_back(std::move(pending_job));
+                return;
+            }
+        }
+        push(std::move(pending_job));
+    }
+
+    void JobSystem::wait(Counter& counter)
+    {
+        const uint32_t worker_index = getCurrentWorkerIndex();
+        while (counter.isDone() == false)
+        {
+            if (std::optional<PendingJob> pending_job = take(worker_index); pending_job != std::nullopt)
+            {
+                execute(*pending_job);
+                if (worker_index != kNotWorker)
+                {
+                    _workers[worker_index]->executed_job_count++;
+                }
+                continue;
+            }
+            // Woken by the last job of the counter or by a new job to help with
+            std::unique_lock lock(_wake_mutex);
+            _wake.wait(lock, [&] { return counter.isDone() || _queued_job_count > 0; });
+        }
+        // The last job releases the mutex after it reached zero, it doesn't use the counter afterwards
+        std::exception_ptr error;
+        {
+            std::unique_lock lock(counter._mutex);
+            error = std::exchange(counter._error, nullptr);
+        }
+        if (error == nullptr)
+        {
+            std::unique_lock lock(_uncounted_error_mutex);
+            error = std::exchange(_uncounted_error, nullptr);
+        }
+        if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void JobSystem::parallelFor(uint32_t count, const std::function<void(uint32_t)>& body, uint32_t batch_size)
+    {
+        assert(batch_size > 0 && "Batch size must be at least one");
+        Counter counter;
+        for (uint32_t begin = 0; begin < count; begin += batch_size)
+        {
+            const uint32_t end = count - begin > batch_size ? begin + batch_size : count;
+            submit([&body, begin, end]
+                   {
+                       for (uint32_t i = begin; i < end; ++i)
+                       {
+                           body(i);
+                       }
+                   },
+                   &counter);
+        }
+        wait(counter);
+    }
+
+    std::vector<JobSystem::WorkerStatistics> JobSystem::getStatistics() const
+    {
+        std::vector<WorkerStatistics> result;
+        result.reserve(_workers.size());
+        for (const auto& worker : _workers)
+        {
+            result.push_back(WorkerStatistics{ .executed_job_count = worker->executed_job_count,
+                                               .stolen_job_count = worker->stolen_job_count,
+                                               .busy_time = std::chrono::nanoseconds(worker->busy_nanoseconds),
+                                               .idle_time = std::chrono::nanoseconds(worker->idle_nanoseconds) });
+        }
+        return result;
+    }
+
+    void JobSystem::onGui() const
+    {
+        const std::vector<WorkerStatistics> statistics = getStatistics();
+
+        ImGui::Begin("Job System");
+        if (ImGui::BeginTable("Workers", 4, ImGuiTableFlags_Borders))
+        {
+            ImGui::TableSetupColumn("Worker");
+            ImGui::TableSetupColumn("Executed jobs");
+            ImGui::TableSetupColumn("Stolen jobs");
+            ImGui::TableSetupColumn("Busy");
+            ImGui::TableHeadersRow();
+            for (uint32_t i = 0; i < statistics.size(); ++i)
+            {
+                const WorkerStatistics& worker = statistics[i];
+                const auto total_time = worker.busy_time + worker.idle_time;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", i);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(worker.executed_job_count));
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(worker.stolen_job_count));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f%%", total_time.count() > 0 ? 100.0 * worker.busy_time.count() / total_time.count() : 0.0);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+    }
+
+    void JobSystem::push(PendingJob pending_job)
+    {
+        // Counted before it is queued, a woken worker retries until it finds the job
+        {
+            std::unique_lock lock(_wake_mutex);
+            _queued_job_count++;
+        }
+        if (const uint32_t worker_index = getCurrentWorkerIndex(); worker_index != kNotWorker)
+        {
+            Worker& worker = *_workers[worker_index];
+            std::unique_lock lock(worker.mutex);
+            worker.jobs.push_back(std::move(pending_job));
+        }
+        else
+        {
+            std::unique_lock lock(_shared_mutex);
+            _shared_jobs.push_back(std::move(pending_job));
+        }
+        _wake.notify_one();
+    }
+
+    std::optional<JobSystem::PendingJob> JobSystem::take(uint32_t worker_index)
+    {
+        std::optional<PendingJob> result;
+        if (worker_index != kNotWorker)
+        {
+            Worker& worker = *_workers[worker_index];
+            std::unique_lock lock(worker.mutex);
+            if (worker.jobs.empty() == false)
+            {
+                // The newest job of the worker has the hottest cache
+                result = std::move(worker.jobs.back());
+                worker.jobs.pop_back();
+            }
+        }
+        if (result == std::nullopt)
+        {
+            std::unique_lock lock(_shared_mutex);
+            if (_shared_jobs.empty() == false)
+            {
+                result = std::move(_shared_jobs.front());
+                _shared_jobs.pop_front();
+            }
+        }
+        const uint32_t worker_count = getWorkerCount();
+        const uint32_t first_victim = worker_index != kNotWorker ? worker_index + 1 : 0;
+        for (uint32_t i = 0; i < worker_count && result == std::nullopt; ++i)
+        {
+            const uint32_t victim_index = (first_victim + i) % worker_count;
+            if (victim_index == worker_index)
+            {
+                continue;
+            }
+            Worker& victim = *_workers[victim_index];
+            std::unique_lock lock(victim.mutex);
+            if (victim.jobs.empty() == false)
+            {
+                result = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                if (worker_index != kNotWorker)
+                {
+                    _workers[worker_index]->stolen_job_count++;
+                }
+            }
+        }
+        if (result != std::nullopt)
+        {
+            _queued_job_count--;
+        }
+        return result;
+    }
+
+    void JobSystem::execute(PendingJob& pending_job)
+    {
+        std::exception_ptr error;
+        try
+        {
+            pending_job.job();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        if (pending_job.counter != nullptr)
+        {
+            finish(*pending_job.counter, error);
+        }
+        else if (error != nullptr)
+        {
+            // Nobody waits for the job, the error is kept for the next wait instead of leaving the worker thread
+            std::unique_lock lock(_uncounted_error_mutex);
+            if (_uncounted_error == nullptr)
+            {
+                _uncounted_error = error;
+            }
+        }
+    }
+
+    void JobSystem::finish(Counter& counter, std::exception_ptr error)
+    {
+        std::vector<PendingJob> dependents;
+        bool done = false;
+        {
+            std::unique_lock lock(counter._mutex);
+            if (counter._error == nullptr)
+            {
+                counter._error = error;
+            }
+            if (--counter._value == 0)
+            {
+                dependents = std::exchange(counter._dependents, {});
+                done = true;
+            }
+        }
+        // The counter can be destroyed by its waiter from here
+        if (done)
+        {
+            // The waiter checks the counter under the lock before it sleeps, the notification cannot be missed
+            {
+                std::unique_lock lock(_wake_mutex);
+            }
+            _wake.notify_all();
+        }
+        for (PendingJob& dependent : dependents)
+        {
+            push(std::move(dependent));
+        }
+    }
+
+    void JobSystem::run(uint32_t worker_index)
+    {
+        g_current_worker = CurrentWorker{ .job_system = this, .worker_index = worker_index };
+        Worker& worker = *_workers[worker_index];
+
+        bool busy = false;
+        auto state_start = std::chrono::steady_clock::now();
+        while (true)
+        {
+            if (std::optional<PendingJob> pending_job = take(worker_index); pending_job != std::nullopt)
+            {
+                if (busy == false)
+                {
+                    busy = true;
+                    worker.idle_nanoseconds += nanosecondsSince(state_start);
+                    if (_on_worker_state_changed)
+                    {
+                        _on_worker_state_changed(worker_index, true);
+                    }
+                }
+                execute(*pending_job);
+                worker.executed_job_count++;
+                continue;
+            }
+            if (busy)
+            {
+                busy = false;
+                worker.busy_nanoseconds += nanosecondsSince(state_start);
+                if (_on_worker_state_changed)
+                {
+                    _on_worker_state_changed(worker_index, false);
+                }
+            }
+
+            std::unique_lock lock(_wake_mutex);
+            _wake.wait(lock, [&] { return _stop || _queued_job_count > 0; });
+            // The queued jobs are finished before stopping, somebody can wait for them
+            if (_queued_job_count == 0)
+            {
+                break;
+            }
+        }
+        worker.idle_nanoseconds += nanosecondsSince(state_start);
+    }
+
+    uint32_t JobSystem::getCurrentWorkerIndex() const
+    {
+        return g_current_worker.job_system == this ? g_current_worker.worker_index : kNotWorker;
+    }
+}
@@ -1,9 +1,12 @@
 #include <render_engine/LogicalDevice.h>
 
+#include <algorithm>
 #include <cassert>
 
 #include <format>
+#include <functional>
 #include <iostream>
+#include <vector>
 namespace RenderEngine
 {
     LogicalDevice::LogicalDevice(VkDevice logical_device)
@@ -19,4 +22,43 @@ namespace RenderEngine
             vkDestroyDevice(_logical_device, nullptr);
         }
     }
-}
\ No newline at end of file
+
+    std::unique_lock<std::mutex> LogicalDevice::lockQueue(VkQueue queue)
+    {
+        std::mutex* queue_mutex = nullptr;
+        {
+            std::unique_lock lock(_queue_locks->mutex);
+            auto& result = _queue_locks->queue_mutexes[queue];
+            if (result == nullptr)
+            {
+                result = std::make_unique<std::mutex>();
+            }
+            queue_mutex = result.get();
+        }
+        // The mutexes are never removed, the pointer stays valid after the map is unlocked
+        return std::unique_lock(*queue_mutex);
+    }
+
+    void LogicalDevice::waitIdle()
+    {
+        std::vector<std::mutex*> queue_mutexes;
+        {
+            std::unique_lock lock(_queue_locks->mutex);
+            queue_mutexes.reserve(_queue_locks->queue_mutexes.size());
+            for (auto& [queue, queue_mutex] : _queue_locks->queue_mutexes)
+            {
+                queue_mutexes.push_back(queue_mutex.get());
+            }
+        }
+        // lockQueue doesn't hold the map mutex while it waits for a queue. The queues are locked in the order of their
+        // mutexes' addresses, thus two threads waiting for idle don't deadlock.
+        std::ranges::sort(queue_mutexes, std::less{});
+        std::vector<std::unique_lock<std::mutex>> queue_locks;
+        queue_locks.reserve(queue_mutexes.size());
+        for (std::mutex* queue_mutex : queue_mutexes)
+        {
+            queue_locks.emplace_back(*queue_mutex);
+        }
+        _api.vkDeviceWaitIdle(_logical_device);
+    }
+}
@@ -3,6 +3,7 @@
 #include <volk.h>
 
 #include <render_engine/Device.h>
+#include <render_engine/memory/MemoryTracker.h>
 
 #include <algorithm>
 #include <iostream>
@@ -79,6 +80,7 @@ namespace RenderEngine
 
     void RenderContext::clearGarbage()
     {
+        std::unique_lock lock(_garbage_mutex);
         std::erase_if(_garbage, [](auto& data) { data.life_count--; return data.life_count == 0; });
     }
     RenderContext& RenderContext::context()
@@ -123,6 +125,11 @@ namespace RenderEngine
         }
 #endif
         _renderer_factory = std::move(info.renderer_factory);
+        if (_job_system == nullptr)
+        {
+            _job_system = std::make_unique<JobSystem>(std::move(info.job_system));
+            _debugger_gui_tokens.push_back(_debugger.addGuiCallback([job_system = _job_system.get()] { job_system->onGui(); }));
+        }
 
         glfwInit();
         if (isVulkanInitialized() == false)
@@ -206,6 +213,14 @@ namespace RenderEngine
             DeviceLookup::DeviceInfo device_info = device_lookup.queryDeviceInfo(physical_device);
             InitializationInfo::QueueFamilyIndexes queue_families = info.queue_family_selector(device_info);
 
+            std::vector<const char*> enabled_device_extensions = device_extensions;
+            // The memory budget is optional, it is only used for the memory statistics
+            if (std::ranges::any_of(device_info.device_extensions,
+                                    [](const DeviceLookup::DeviceExtensionInfo& extension) { return extension.name == VK_EXT_MEMORY_BUDGET_EXTENSION_NAME; }))
+            {
+                enabled_device_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+            }
+
             {
                 std::vector<const char*> enabled_layers(info.enabled_layers.size(), nullptr);
                 std::ranges::transform(info.enabled_layers, enabled_layers.begin(),
@@ -215,9 +230,10 @@ namespace RenderEngine
                                                        queue_families.graphics,
                                                        queue_families.present,
                                                        queue_families.transfer,
-                                                       device_extensions,
+                                                       enabled_device_extensions,
                                                        enabled_layers,
                                                        std::move(device_info));
+                _debugger_gui_tokens.push_back(_debugger.addGuiCallback([memory_tracker = &device->getMemoryTracker()] { memory_tracker->onGui(); }));
                 _devices.push_back(std::move(device));
             }
         }
@@ -232,10 +248,14 @@ namespace RenderEngine
         if (isVulkanInitialized())
         {
             _garbage.clear();
+            _debugger_gui_tokens.clear();
             _devices.clear();
             vkDestroyInstance(_instance, nullptr);
             _instance = nullptr;
         }
+        // The gui of the job system is registered even when vulkan is not initialized
+        _debugger_gui_tokens.clear();
+        _job_system.reset();
         glfwTerminate();
     }
     void* RenderContext::getRenderdocApi()
@@ -2,35 +2,84 @@
 
 #include <render_engine/RenderContext.h>
 #include <render_engine/RendererFactory.h>
+#include <render_engine/renderers/AbstractRenderer.h>
+
+#include <exception>
 
 namespace RenderEngine
 {
-    namespace
-    {
-        constexpr uint32_t kMaxNumOfResources = 10;
-    }
     RenderEngine::RenderEngine(Device& device, std::shared_ptr<CommandContext>&& command_context, uint32_t back_buffer_count)
         : _device(device)
-        , _gpu_resource_manager(device.getPhysicalDevice(), device.getLogicalDevice(), back_buffer_count, kMaxNumOfResources)
+        , _gpu_resource_manager(device.getPhysicalDevice(), device.getLogicalDevice(), device.getMemoryAllocator(), back_buffer_count)
         , _command_context(command_context->clone())
         , _transfer_engine(std::move(command_context))
     {
 
     }
 
-    void RenderEngine::submitDrawCalls(const std::vector<VkCommandBufferSubmitInfo>& command_buffers, const SyncOperations& sync_operations)
+    std::vector<VkCommandBufferSubmitInfo> RenderEngine::recordDrawCalls(std::span<AbstractRenderer* const> renderers,
+                                                                         uint32_t image_index)
     {
-        VkSubmitInfo2 submit_info{};
-        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        const auto recording_start = std::chrono::steady_clock::now();
 
-        submit_info.commandBufferInfoCount = static_cast<uint32_t>(command_buffers.size());
-        submit_info.pCommandBufferInfos = command_buffers.data();
+        JobSystem& job_system = RenderContext::context().getJobSystem();
+        JobSystem::Counter parallel_draws;
+        for (AbstractRenderer* drawer : renderers)
+        {
+            if (drawer->isParallelRecordingEnabled())
+            {
+                job_system.submit([drawer, image_index] { drawer->draw(image_index); }, &parallel_draws);
+            }
+        }
+        std::exception_ptr error;
+        try
+        {
+            for (AbstractRenderer* drawer : renderers)
+            {
+                if (drawer->isParallelRecordingEnabled() == false)
+                {
+                    drawer->draw(image_index);
+                }
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        // Every parallel draw has to be finished before the renderers can be used again, even when one of them failed
+        try
+        {
+            job_system.wait(parallel_draws);
+        }
+        catch (...)
+        {
+            if (error == nullptr)
+            {
+                error = std::current_exception();
+            }
+        }
+        if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
 
-        sync_operations.fillInfo(submit_info);
-        if (_device.getLogicalDevice()->vkQueueSubmit2(_command_context->getQueue(), 1, &submit_info, sync_operations.getFence()) != VK_SUCCESS)
+        std::vector<VkCommandBufferSubmitInfo> command_buffers;
+        for (AbstractRenderer* drawer : renderers)
         {
-            throw std::runtime_error("failed to submit draw command buffer!");
+            auto current_command_buffers = drawer->getCommandBuffers(image_index);
+            std::ranges::transform(current_command_buffers,
+                                   std::back_inserter(command_buffers),
+                                   [](const auto& command_buffer)
+                                   {
+                                       return VkCommandBufferSubmitInfo{
+                                                           .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+                                                           .pNext = VK_NULL_HANDLE,
+                                                           .commandBuffer = command_buffer,
+                                                           .deviceMask = 0 };
+                                   });
         }
+        _last_recording_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - recording_start);
+        return command_buffers;
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,527 @@
+#include <render_engine/RenderGraph.h>
+
+#include <render_engine/resources/Buffer.h>
+#include <render_engine/resources/Texture.h>
+#include <render_engine/synchronization/ResourceStateMachine.h>
+
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace RenderEngine
+{
+    namespace
+    {
+        // Calls the callback with every access of the task and the resource of the access
+        void forEachAccess(auto& task, auto&& callback)
+        {
+            for (auto& access : task.texture_accesses)
+            {
+                callback(access, static_cast<const void*>(access.texture));
+            }
+            for (auto& access : task.buffer_accesses)
+            {
+                callback(access, static_cast<const void*>(access.buffer));
+            }
+        }
+    }
+
+    RenderGraph::TaskBuilder& RenderGraph::TaskBuilder::read(Texture& texture, TextureState state)
+    {
+        assert(_command_context.isPipelineStageSupported(state.pipeline_stage) && "The command context of the task doesn't support the stage");
+        _task.texture_accesses.push_back({ .texture = &texture,
+                                           .state = std::move(state).setCommandContext(_command_context.getWeakReference()),
+                                           .write = false });
+        return *this;
+    }
+
+    RenderGraph::TaskBuilder& RenderGraph::TaskBuilder::write(Texture& texture, TextureState state)
+    {
+        assert(_command_context.isPipelineStageSupported(state.pipeline_stage) && "The command context of the task doesn't support the stage");
+        _task.texture_accesses.push_back({ .texture = &texture,
+                                           .state = std::move(state).setCommandContext(_command_context.getWeakReference()),
+                                           .write = true });
+        return *this;
+    }
+
+    RenderGraph::TaskBuilder& RenderGraph::TaskBuilder::read(Buffer& buffer, BufferState state)
+    {
+        assert(_command_context.isPipelineStageSupported(state.pipeline_stage) && "The command context of the task doesn't support the stage");
+        _task.buffer_accesses.push_back({ .buffer = &buffer,
+                                          .state = std::move(state).setCommandContext(_command_context.getWeakReference()),
+                                          .write = false });
+        return *this;
+    }
+
+    RenderGraph::TaskBuilder& RenderGraph::TaskBuilder::write(Buffer& buffer, BufferState state)
+    {
+        assert(_command_context.isPipelineStageSupported(state.pipeline_stage) && "The command context of the task doesn't support the stage");
+        _task.buffer_accesses.push_back({ .buffer = &buffer,
+                                          .state = std::move(state).setCommandContext(_command_context.getWeakReference()),
+                                          .write = true });
+        return *this;
+    }
+
+    RenderGraph::TaskBuilder& RenderGraph::TaskBuilder::addSyncOperations(const SyncOperations& sync_operations)
+    {
+        _task.sync_operations.unionWith(sync_operations);
+        return *this;
+    }
+
+    RenderGraph::TaskBuilder& RenderGraph::TaskBuilder::setSideEffect()
+    {
+        _task.side_effect = true;
+        return *this;
+    }
+
+    RenderGraph::RenderGraph(LogicalDevice& logical_device)
+        : _logical_device(logical_device)
+        , _sync_primitives(SyncPrimitives::CreateEmpty(logical_device))
+    {}
+
+    RenderGraph::~RenderGraph() = default;
+
+    RenderGraph::TaskId RenderGraph::addTask(std::string name,
+                                             CommandContext& command_context,
+                                             const SetupCallback& setup,
+                                             RecordCallback record)
+    {
+        Task& task = _tasks.emplace_back();
+        task.name = std::move(name);
+        task.command_context = &command_context;
+        task.record = std::move(record);
+
+        TaskBuilder builder{ task, command_context };
+        setup(builder);
+
+        _compiled = false;
+        return TaskId{ static_cast<uint32_t>(_tasks.size() - 1) };
+    }
+
+    void RenderGraph::markAsOutput(const Texture& texture)
+    {
+        _outputs.insert(&texture);
+        _compiled = false;
+    }
+
+    void RenderGraph::markAsOutput(const Buffer& buffer)
+    {
+        _outputs.insert(&buffer);
+        _compiled = false;
+    }
+
+    void RenderGraph::compile()
+    {
+        const auto dependencies = collectDependencies();
+        cullTasks(dependencies);
+        sortTasks(dependencies);
+        createBatches();
+        synchronizeBatches();
+        _compiled = true;
+    }
+
+    void RenderGraph::execute(const SyncOperations& external_operations)
+    {
+        if (_compiled == false)
+        {
+            throw std::runtime_error("Render graph has to be compiled before it is executed");
+        }
+
+        for (QueueTimeline& timeline : _queue_timelines)
+        {
+            timeline.execution_start_value = timeline.last_signaled_value;
+        }
+        for (size_t batch_index = 0; batch_index < _batches.size(); ++batch_index)
+        {
+            const Batch& batch = _batches[batch_index];
+            CommandContext& command_context = *batch.command_context;
+
+            QueueTimeline& timeline = _queue_timelines[batch.queue_index];
+            const uint64_t signal_value = timeline.execution_start_value + batch.timeline_value;
+            SyncOperations sync_operations;
+            sync_operations.addSignalOperation(_sync_primitives,
+                                               timeline.semaphore,
+                                               VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                               signal_value);
+            for (const Wait& wait : batch.waits)
+            {
+                const Batch& producer = _batches[wait.batch_index];
+                const QueueTimeline& producer_timeline = _queue_timelines[producer.queue_index];
+                uint64_t value = producer_timeline.execution_start_value + producer.timeline_value;
+                if (wait.previous_execution)
+                {
+                    // The whole previous execution on the queue of the producer is waited, that covers its producer
+                    // batch even when the graph was recompiled since then
+                    if (producer_timeline.execution_start_value == 0)
+                    {
+                        continue;
+                    }
+                    value = producer_timeline.execution_start_value;
+                }
+                sync_operations.addWaitOperation(_sync_primitives, producer_timeline.semaphore, wait.stage_mask, value);
+            }
+            for (uint32_t task_index : batch.tasks)
+            {
+                sync_operations.unionWith(_tasks[task_index].sync_operations);
+            }
+            if (batch_index == 0)
+            {
+                sync_operations.unionWith(external_operations, SyncOperations::ExtractWaitOperations);
+            }
+            if (batch_index + 1 == _batches.size())
+            {
+                sync_operations.unionWith(external_operations, SyncOperations::ExtractSignalOperations | SyncOperations::ExtractFence);
+            }
+
+            // Acquired after everything else is prepared, only the recording can fail before the submit
+            VkCommandBuffer command_buffer = command_context.createCommandBuffer(CommandContext::Usage::SingleSubmit);
+            try
+            {
+                VkCommandBufferBeginInfo begin_info{};
+                begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                if (_logical_device->vkBeginCommandBuffer(command_buffer, &begin_info) != VK_SUCCESS)
+                {
+                    throw std::runtime_error("failed to begin recording command buffer!");
+                }
+                recordBatch(command_buffer, batch);
+                if (_logical_device->vkEndCommandBuffer(command_buffer) != VK_SUCCESS)
+                {
+                    throw std::runtime_error("failed to record command buffer!");
+                }
+            }
+            catch (...)
+            {
+                command_context.abandon(command_buffer);
+                throw;
+            }
+            command_context.submit(command_buffer, sync_operations);
+            timeline.last_signaled_value = signal_value;
+        }
+    }
+
+    bool RenderGraph::isCulled(TaskId task_id) const
+    {
+        return _tasks.at(task_id.index).culled;
+    }
+
+    const std::string& RenderGraph::getTaskName(TaskId task_id) const
+    {
+        return _tasks.at(task_id.index).name;
+    }
+
+    std::vector<std::vector<uint32_t>> RenderGraph::collectDependencies() const
+    {
+        struct Hazard
+        {
+            std::optional<uint32_t> last_writer;
+            std::vector<uint32_t> readers;
+        };
+        std::unordered_map<const void*, Hazard> hazards;
+        std::vector<std::vector<uint32_t>> result(_tasks.size());
+        for (uint32_t task_index = 0; task_index < _tasks.size(); ++task_index)
+        {
+            std::vector<uint32_t>& dependencies = result[task_index];
+            forEachAccess(_tasks[task_index], [&](const auto& access, const void* resource)
+                          {
+                              Hazard& hazard = hazards[resource];
+                              if (hazard.last_writer != std::nullopt)
+                              {
+                                  dependencies.push_back(*hazard.last_writer);
+                              }
+                              if (access.write)
+                              {
+                                  dependencies.insert(dependencies.end(), hazard.readers.begin(), hazard.readers.end());
+                                  hazard.readers.clear();
+                                  hazard.last_writer = task_index;
+                              }
+                              else
+                              {
+                                  hazard.readers.push_back(task_index);
+                              }
+                          });
+            std::erase(dependencies, task_index);
+            std::ranges::sort(dependencies);
+            const auto duplicates = std::ranges::unique(dependencies);
+            dependencies.erase(duplicates.begin(), duplicates.end());
+        }
+        return result;
+    }
+
+    void RenderGraph::cullTasks(const std::vector<std::vector<uint32_t>>& dependencies)
+    {
+        std::vector<uint32_t> used_tasks;
+        for (uint32_t task_index = 0; task_index < _tasks.size(); ++task_index)
+        {
+            Task& task = _tasks[task_index];
+            bool writes_output = false;
+            forEachAccess(task, [&](const auto& access, const void* resource)
+                          {
+                              writes_output |= access.write && _outputs.contains(resource);
+                          });
+            task.culled = (task.side_effect || writes_output) == false;
+            if (task.culled == false)
+            {
+                used_tasks.push_back(task_index);
+            }
+        }
+        while (used_tasks.empty() == false)
+        {
+            const uint32_t task_index = used_tasks.back();
+            used_tasks.pop_back();
+            for (uint32_t dependency : dependencies[task_index])
+            {
+                if (_tasks[dependency].culled)
+                {
+                    _tasks[dependency].culled = false;
+                    used_tasks.push_back(dependency);
+                }
+            }
+        }
+    }
+
+    void RenderGraph::sortTasks(const std::vector<std::vector<uint32_t>>& dependencies)
+    {
+        std::vector<uint32_t> remaining_dependency_count(_tasks.size(), 0);
+        std::vector<std::vector<uint32_t>> dependents(_tasks.size());
+        std::vector<uint32_t> ready_tasks;
+        for (uint32_t task_index = 0; task_index < _tasks.size(); ++task_index)
+        {
+            if (_tasks[task_index].culled)
+            {
+                continue;
+            }
+            for (uint32_t dependency : dependencies[task_index])
+            {
+                remaining_dependency_count[task_index]++;
+                dependents[dependency].push_back(task_index);
+            }
+            if (remaining_dependency_count[task_index] == 0)
+            {
+                ready_tasks.push_back(task_index);
+            }
+        }
+
+        _execution_order.clear();
+        const CommandContext* previous_context = nullptr;
+        while (ready_tasks.empty() == false)
+        {
+            // Staying on the command context of the previous task makes the batches longer. The ready tasks are sorted,
+            // thus the declaration order is kept otherwise.
+            auto it = std::ranges::find(ready_tasks, previous_context,
+                                        [&](uint32_t task_index) { return _tasks[task_index].command_context; });
+            if (it == ready_tasks.end())
+            {
+                it = ready_tasks.begin();
+            }
+            const uint32_t task_index = *it;
+            ready_tasks.erase(it);
+            _execution_order.push_back(TaskId{ task_index });
+            previous_context = _tasks[task_index].command_context;
+
+            for (uint32_t dependent : dependents[task_index])
+            {
+                if (--remaining_dependency_count[dependent] == 0)
+                {
+                    ready_tasks.insert(std::ranges::upper_bound(ready_tasks, dependent), dependent);
+                }
+            }
+        }
+        assert(std::ranges::count(_tasks, false, &Task::culled) == static_cast<std::ptrdiff_t>(_execution_order.size())
+               && "Every used task has to be ordered");
+    }
+
+    void RenderGraph::createBatches()
+    {
+        _batches.clear();
+        for (QueueTimeline& timeline : _queue_timelines)
+        {
+            timeline.batch_count = 0;
+        }
+        for (TaskId task_id : _execution_order)
+        {
+            CommandContext* command_context = _tasks[task_id.index].command_context;
+            if (_batches.empty() || _batches.back().command_context != command_context)
+            {
+                Batch batch;
+                batch.command_context = command_context;
+                batch.queue_index = getQueueIndex(command_context->getQueue());
+                batch.timeline_value = ++_queue_timelines[batch.queue_index].batch_count;
+                _batches.push_back(std::move(batch));
+            }
+            _batches.back().tasks.push_back(task_id.index);
+        }
+    }
+
+    void RenderGraph::synchronizeBatches()
+    {
+        struct ResourceUsage
+        {
+            std::optional<uint32_t> last_writer;
+            // Batches reading the resource since the last write
+            std::vector<uint32_t> readers;
+            // The last batch using the resource, its queue family owns the resource
+            std::optional<uint32_t> owner;
+        };
+
+        auto synchronize = [&](uint32_t batch_index, const auto& access, const ResourceUsage& usage, bool previous_execution)
+            {
+                Batch& batch = _batches[batch_index];
+                auto add_wait = [&](uint32_t producer_index)
+                    {
+                        // Submission order and the barriers synchronize the batches of a queue
+                        if (_batches[producer_index].queue_index == batch.queue_index)
+                        {
+                            return;
+                        }
+                        auto it = std::ranges::find_if(batch.waits, [&](const Wait& wait)
+                                                       {
+                                                           return wait.batch_index == producer_index
+                                                               && wait.previous_execution == previous_execution;
+                                                       });
+                        if (it != batch.waits.end())
+                        {
+                            it->stage_mask |= access.state.pipeline_stage;
+                            return;
+                        }
+                        batch.waits.push_back({ .batch_index = producer_index,
+                                                .stage_mask = access.state.pipeline_stage,
+                                                .previous_execution = previous_execution });
+                    };
+
+                if (usage.owner != std::nullopt
+                    && _batches[*usage.owner].command_context->getQueueFamilyIndex() != batch.command_context->getQueueFamilyIndex())
+                {
+                    Batch& owner = _batches[*usage.owner];
+                    if constexpr (std::is_same_v<std::remove_cvref_t<decltype(access)>, TextureAccess>)
+                    {
+                        owner.texture_releases.push_back(access);
+                        batch.texture_acquires.push_back(access);
+                    }
+                    else
+                    {
+                        owner.buffer_releases.push_back(access);
+                        batch.buffer_acquires.push_back(access);
+                    }
+                    add_wait(*usage.owner);
+                }
+                if (usage.last_writer != std::nullopt)
+                {
+                    add_wait(*usage.last_writer);
+                }
+                if (access.write)
+                {
+                    for (uint32_t reader : usage.readers)
+                    {
+                        add_wait(reader);
+                    }
+                }
+            };
+
+        std::unordered_map<const void*, ResourceUsage> usages;
+        for (uint32_t batch_index = 0; batch_index < _batches.size(); ++batch_index)
+        {
+            for (uint32_t task_index : _batches[batch_index].tasks)
+            {
+                forEachAccess(_tasks[task_index], [&](const auto& access, const void* resource)
+                              {
+                                  ResourceUsage& usage = usages[resource];
+                                  synchronize(batch_index, access, usage, false);
+                                  usage.owner = batch_index;
+                                  if (access.write)
+                                  {
+                                      usage.last_writer = batch_index;
+                                      usage.readers.clear();
+                                  }
+                                  else
+                                  {
+                                      usage.readers.push_back(batch_index);
+                                  }
+                              });
+            }
+        }
+        // The first use of a resource depends on its last use in the previous execution
+        std::unordered_set<const void*> synchronized_resources;
+        for (uint32_t batch_index = 0; batch_index < _batches.size(); ++batch_index)
+        {
+            for (uint32_t task_index : _batches[batch_index].tasks)
+            {
+                forEachAccess(_tasks[task_index], [&](const auto& access, const void* resource)
+                              {
+                                  if (synchronized_resources.insert(resource).second)
+                                  {
+                                      synchronize(batch_index, access, usages.at(resource), true);
+                                  }
+                              });
+            }
+        }
+    }
+
+    uint32_t RenderGraph::getQueueIndex(VkQueue queue)
+    {
+        auto it = std::ranges::find(_queue_timelines, queue, &QueueTimeline::queue);
+        if (it != _queue_timelines.end())
+        {
+            return static_cast<uint32_t>(std::distance(_queue_timelines.begin(), it));
+        }
+        const uint32_t queue_index = static_cast<uint32_t>(_queue_timelines.size());
+        _queue_timelines.push_back({ .queue = queue,
+                                     .semaphore = _sync_primitives.createTimelineSemaphore(std::format("RenderGraphQueue{}", queue_index), 0, 1) });
+        return queue_index;
+    }
+
+    void RenderGraph::recordBatch(VkCommandBuffer command_buffer, const Batch& batch)
+    {
+        const uint32_t queue_family_index = batch.command_context->getQueueFamilyIndex();
+        auto is_owned_by_other_queue_family = [&](const auto& state)
+            {
+                const std::optional<uint32_t> owner_queue_family_index = state.getQueueFamilyIndex();
+                return owner_queue_family_index != std::nullopt && *owner_queue_family_index != queue_family_index;
+            };
+
+        ResourceStateMachine state_machine(_logical_device);
+        // The acquires are committed with the barrier of the first task. Before the first execution there is no release
+        // for the resources that are already owned by this queue family.
+        for (const TextureAccess& acquire : batch.texture_acquires)
+        {
+            if (is_owned_by_other_queue_family(acquire.texture->getResourceState()))
+            {
+                state_machine.recordStateChange(acquire.texture, acquire.state);
+            }
+        }
+        for (const BufferAccess& acquire : batch.buffer_acquires)
+        {
+            if (is_owned_by_other_queue_family(acquire.buffer->getResourceState()))
+            {
+                state_machine.recordStateChange(acquire.buffer, acquire.state);
+            }
+        }
+        for (uint32_t task_index : batch.tasks)
+        {
+            const Task& task = _tasks[task_index];
+            for (const TextureAccess& access : task.texture_accesses)
+            {
+                state_machine.recordStateChange(access.texture, access.state);
+            }
+            for (const BufferAccess& access : task.buffer_accesses)
+            {
+                state_machine.recordStateChange(access.buffer, access.state);
+            }
+            state_machine.commitChanges(command_buffer);
+            task.record(command_buffer);
+        }
+        for (const TextureAccess& release : batch.texture_releases)
+        {
+            state_machine.recordReleaseStateChange(release.texture, release.state);
+        }
+        for (const BufferAccess& release : batch.buffer_releases)
+        {
+            state_machine.recordReleaseStateChange(release.buffer, release.state);
+        }
+        state_machine.commitChanges(command_buffer);
+    }
+}
@@ -119,7 +119,7 @@ namespace RenderEngine
     {
         return BufferInfo{
                 .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                .size = getSize(),
+                .size = getSizeInBytes(),
                 .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
         };
     }
@@ -130,6 +130,11 @@ namespace RenderEngine
         return result;
     }
 
+    VkDeviceSize Image::getSizeInBytes() const
+    {
+        return getSize() * getPixelComponentSize();
+    }
+
     uint32_t Image::getPixelComponentCount() const
     {
         switch (_format)
@@ -144,6 +149,20 @@ namespace RenderEngine
         }
     }
 
+    uint32_t Image::getPixelComponentSize() const
+    {
+        switch (_format)
+        {
+            case VK_FORMAT_R8G8B8A8_SRGB:
+            case VK_FORMAT_B8G8R8A8_SRGB:
+                return sizeof(uint8_t);
+            case VK_FORMAT_R32_SFLOAT:
+                return sizeof(float);
+            default:
+                throw std::runtime_error("Unhandled image format");
+        }
+    }
+
     void Image::processData(const ImageProcessor& image_processor)
     {
         if (is3D() != image_processor.is3DProcessor())
@@ -36,6 +36,7 @@ namespace RenderEngine
         GpuResourceSet per_draw_call_resources(gpu_resource_manager,
                                                texture_assignment.getBindings(Shader::MetaData::UpdateFrequency::PerDrawCall));
         return std::make_unique<Technique>(gpu_resource_manager.getLogicalDevice(),
+                                           gpu_resource_manager.getUniformRingBuffer(),
                                            this,
                                            std::move(subpass_textures),
                                            std::move(constant_resources),
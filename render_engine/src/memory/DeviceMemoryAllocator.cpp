@@ -0,0 +1,547 @@
+#include <render_engine/memory/DeviceMemoryAllocator.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace RenderEngine
+{
+    namespace
+    {
+        constexpr VkDeviceSize kSmallBufferThreshold = 64 * 1024;
+        constexpr VkDeviceSize kSmallBufferBlockSize = 4 * 1024 * 1024;
+        constexpr VkDeviceSize kSmallBufferMinAllocationSize = 256;
+        constexpr VkDeviceSize kBlockSize = 64 * 1024 * 1024;
+        constexpr VkDeviceSize kMinAllocationSize = 4 * 1024;
+        constexpr VkDeviceSize kDedicatedImageThreshold = 16 * 1024 * 1024;
+        // A block takes at most this part of its heap, it matters for the small heaps (e.g. host visible device memory)
+        constexpr VkDeviceSize kMaxBlockCountPerHeap = 8;
+
+        std::optional<uint32_t> findMemoryTypeWithProperties(const VkPhysicalDeviceMemoryProperties& memory_properties,
+                                                             uint32_t type_filter,
+                                                             VkMemoryPropertyFlags properties)
+        {
+            for (uint32_t i = 0; i < memory_properties.memoryTypeCount; i++)
+            {
+                if ((type_filter & (1 << i)) && (memory_properties.memoryTypes[i].propertyFlags & properties) == properties)
+                {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+    }
+
+    /*
+    * One memory allocation of the driver split by a buddy allocator. Every range has the size of min_allocation_size * 2^order
+    * and its offset is a multiple of its size.
+    */
+    class DeviceMemoryAllocator::Block
+    {
+    public:
+        Block(VkDeviceMemory memory, void* mapped_memory, VkDeviceSize size, VkDeviceSize min_allocation_size)
+            : _memory(memory)
+            , _mapped_memory(mapped_memory)
+            , _size(size)
+            , _min_allocation_size(min_allocation_size)
+        {
+            assert(std::has_single_bit(size) && std::has_single_bit(min_allocation_size) && size >= min_allocation_size
+                   && "The buddy allocator works with power of two sizes");
+            _free_ranges.resize(std::countr_zero(_size / _min_allocation_size) + 1);
+            _free_ranges.back().insert(0);
+        }
+
+        std::optional<std::pair<VkDeviceSize, uint32_t>> allocate(VkDeviceSize size)
+        {
+            const VkDeviceSize range_size = std::bit_ceil(std::max(size, _min_allocation_size));
+            if (range_size > _size)
+            {
+                return std::nullopt;
+            }
+            const uint32_t order = std::countr_zero(range_size / _min_allocation_size);
+            uint32_t free_order = order;
+            while (free_order < _free_ranges.size() && _free_ranges[free_order].empty())
+            {
+                ++free_order;
+            }
+            if (free_order == _free_ranges.size())
+            {
+                return std::nullopt;
+            }
+            const VkDeviceSize offset = *_free_ranges[free_order].begin();
+            _free_ranges[free_order].erase(_free_ranges[free_order].begin());
+            // The upper halves of the split ranges become free
+            while (free_order > order)
+            {
+                --free_order;
+                _free_ranges[free_order].insert(offset + (_min_allocation_size << free_order));
+            }
+            _reserved_bytes += range_size;
+            _allocation_count++;
+            return std::make_pair(offset, order);
+        }
+
+        void free(VkDeviceSize offset, uint32_t order)
+        {
+            assert(_allocation_count > 0 && "Block has no allocation to free");
+            _reserved_bytes -= _min_allocation_size << order;
+            _allocation_count--;
+            // Merge with the buddy while it is free
+            while (order + 1 < _free_ranges.size())
+            {
+                const VkDeviceSize buddy_offset = offset ^ (_min_allocation_size << order);
+                if (_free_ranges[order].erase(buddy_offset) == 0)
+                {
+                    break;
+                }
+                offset = std::min(offset, buddy_offset);
+                ++order;
+            }
+            _free_ranges[order].insert(offset);
+        }
+
+        VkDeviceSize getLargestFreeRange() const
+        {
+            for (size_t order = _free_ranges.size(); order > 0; --order)
+            {
+                if (_free_ranges[order - 1].empty() == false)
+                {
+                    return _min_allocation_size << (order - 1);
+                }
+            }
+            return 0;
+        }
+
+        VkDeviceMemory getMemory() const { return _memory; }
+        void* getMappedMemory() const { return _mapped_memory; }
+        VkDeviceSize getSize() const { return _size; }
+        VkDeviceSize getFreeBytes() const { return _size - _reserved_bytes; }
+        bool isEmpty() const { return _allocation_count == 0; }
+    private:
+        VkDeviceMemory _memory{ VK_NULL_HANDLE };
+        void* _mapped_memory{ nullptr };
+        VkDeviceSize _size{ 0 };
+        VkDeviceSize _min_allocation_size{ 0 };
+        // Offsets of the free ranges per order
+        std::vector<std::set<VkDeviceSize>> _free_ranges;
+        VkDeviceSize _reserved_bytes{ 0 };
+        uint32_t _allocation_count{ 0 };
+    };
+
+    DeviceMemoryAllocator::Allocation::~Allocation()
+    {
+        release();
+    }
+
+    DeviceMemoryAllocator::Allocation::Allocation(Allocation&& o) noexcept
+    {
+        *this = std::move(o);
+    }
+
+    DeviceMemoryAllocator::Allocation& DeviceMemoryAllocator::Allocation::operator=(Allocation&& o) noexcept
+    {
+        if (this != &o)
+        {
+            release();
+            _allocator = std::exchange(o._allocator, nullptr);
+            _block = std::exchange(o._block, nullptr);
+            _order = o._order;
+            _memory = std::exchange(o._memory, VK_NULL_HANDLE);
+            _offset = o._offset;
+            _size = o._size;
+            _requested_size = o._requested_size;
+            _mapped_memory = std::exchange(o._mapped_memory, nullptr);
+            _memory_type_index = o._memory_type_index;
+            _memory_properties = o._memory_properties;
+            _subsystem = o._subsystem;
+        }
+        return *this;
+    }
+
+    void DeviceMemoryAllocator::Allocation::release() noexcept
+    {
+        if (_allocator != nullptr)
+        {
+            _allocator->free(*this);
+        }
+        _allocator = nullptr;
+        _block = nullptr;
+        _memory = VK_NULL_HANDLE;
+        _mapped_memory = nullptr;
+        _offset = 0;
+        _size = 0;
+        _requested_size = 0;
+    }
+
+    DeviceMemoryAllocator::DeviceMemoryAllocator(VkPhysicalDevice physical_device, LogicalDevice& logical_device)
+        : _physical_device(physical_device)
+        , _logical_device(logical_device)
+    {
+        vkGetPhysicalDeviceMemoryProperties(_physical_device, &_memory_properties);
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(_physical_device, &properties);
+        _non_coherent_atom_size = properties.limits.nonCoherentAtomSize;
+
+        _memory_types.resize(_memory_properties.memoryTypeCount);
+        for (uint32_t i = 0; i < _memory_properties.memoryTypeCount; ++i)
+        {
+            const VkDeviceSize heap_size = _memory_properties.memoryHeaps[_memory_properties.memoryTypes[i].heapIndex].size;
+            const VkDeviceSize max_block_size = std::max(std::bit_floor(heap_size / kMaxBlockCountPerHeap), kMinAllocationSize);
+            auto& pools = _memory_types[i].pools;
+            pools[kSmallBufferPool] = Pool{ .block_size = std::min(kSmallBufferBlockSize, max_block_size),
+                .min_allocation_size = kSmallBufferMinAllocationSize };
+            pools[kBufferPool] = Pool{ .block_size = std::min(kBlockSize, max_block_size),
+                .min_allocation_size = kMinAllocationSize };
+            pools[kImagePool] = Pool{ .block_size = std::min(kBlockSize, max_block_size),
+                .min_allocation_size = kMinAllocationSize };
+        }
+    }
+
+    DeviceMemoryAllocator::~DeviceMemoryAllocator()
+    {
+        for (auto& memory_type : _memory_types)
+        {
+            assert(memory_type.live_allocation_count == 0 && "Device memory allocations are still alive");
+            for (auto& pool : memory_type.pools)
+            {
+                for (auto& block : pool.blocks)
+                {
+                    _logical_device->vkFreeMemory(*_logical_device, block->getMemory(), nullptr);
+                }
+            }
+        }
+    }
+
+    DeviceMemoryAllocator::Allocation DeviceMemoryAllocator::allocateForBuffer(VkBuffer buffer,
+                                                                               MemorySubsystem subsystem,
+                                                                               VkMemoryPropertyFlags required_properties,
+                                                                               VkMemoryPropertyFlags preferred_properties)
+    {
+        VkBufferMemoryRequirementsInfo2 requirements_info{};
+        requirements_info.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+        requirements_info.buffer = buffer;
+        VkMemoryDedicatedRequirements dedicated_requirements{};
+        dedicated_requirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+        VkMemoryRequirements2 requirements{};
+        requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        requirements.pNext = &dedicated_requirements;
+        _logical_device->vkGetBufferMemoryRequirements2(*_logical_device, &requirements_info, &requirements);
+
+        const uint32_t memory_type_index = findMemoryType(requirements.memoryRequirements.memoryTypeBits,
+                                                          required_properties,
+                                                          preferred_properties);
+        const PoolType pool_type = requirements.memoryRequirements.size <= kSmallBufferThreshold ? kSmallBufferPool : kBufferPool;
+
+        std::unique_lock lock(_mutex);
+        Allocation result;
+        if (dedicated_requirements.prefersDedicatedAllocation
+            || requirements.memoryRequirements.size > _memory_types[memory_type_index].pools[pool_type].block_size / 2)
+        {
+            result = allocateDedicated(requirements.memoryRequirements, memory_type_index, DedicatedTarget{ .buffer = buffer });
+        }
+        else
+        {
+            result = allocateFromPool(requirements.memoryRequirements, memory_type_index, pool_type);
+        }
+        registerAllocation(result, subsystem);
+        return result;
+    }
+
+    DeviceMemoryAllocator::Allocation DeviceMemoryAllocator::allocateForImage(VkImage image,
+                                                                              MemorySubsystem subsystem,
+                                                                              VkMemoryPropertyFlags required_properties,
+                                                                              VkMemoryPropertyFlags preferred_properties,
+                                                                              const VkExportMemoryAllocateInfo* export_info)
+    {
+        VkImageMemoryRequirementsInfo2 requirements_info{};
+        requirements_info.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+        requirements_info.image = image;
+        VkMemoryDedicatedRequirements dedicated_requirements{};
+        dedicated_requirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+        VkMemoryRequirements2 requirements{};
+        requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        requirements.pNext = &dedicated_requirements;
+        _logical_device->vkGetImageMemoryRequirements2(*_logical_device, &requirements_info, &requirements);
+
+        const uint32_t memory_type_index = findMemoryType(requirements.memoryRequirements.memoryTypeBits,
+                                                          required_properties,
+                                                          preferred_properties);
+        // The driver commits lazily allocated memory per memory object
+        const bool lazily_allocated = _memory_properties.memoryTypes[memory_type_index].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+        std::unique_lock lock(_mutex);
+        Allocation result;
+        if (export_info != nullptr
+            || lazily_allocated
+            || dedicated_requirements.prefersDedicatedAllocation
+            || requirements.memoryRequirements.size >= kDedicatedImageThreshold
+            || requirements.memoryRequirements.size > _memory_types[memory_type_index].pools[kImagePool].block_size / 2)
+        {
+            result = allocateDedicated(requirements.memoryRequirements,
+                                       memory_type_index,
+                                       DedicatedTarget{ .image = image, .next = export_info });
+        }
+        else
+        {
+            result = allocateFromPool(requirements.memoryRequirements, memory_type_index, kImagePool);
+        }
+        registerAllocation(result, subsystem);
+        return result;
+    }
+
+    DeviceMemoryAllocator::Allocation DeviceMemoryAllocator::allocateForAliasedImages(const VkMemoryRequirements& requirements,
+                                                                                      MemorySubsystem subsystem,
+                                                                                      VkMemoryPropertyFlags required_properties,
+                                                                                      VkMemoryPropertyFlags preferred_properties)
+    {
+        const uint32_t memory_type_index = findMemoryType(requirements.memoryTypeBits,
+                                                          required_properties,
+                                                          preferred_properties);
+        const bool lazily_allocated = _memory_properties.memoryTypes[memory_type_index].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+        std::unique_lock lock(_mutex);
+        Allocation result;
+        if (lazily_allocated
+            || requirements.size >= kDedicatedImageThreshold
+            || requirements.size > _memory_types[memory_type_index].pools[kImagePool].block_size / 2)
+        {
+            result = allocateDedicated(requirements, memory_type_index, DedicatedTarget{});
+        }
+        else
+        {
+            result = allocateFromPool(requirements, memory_type_index, kImagePool);
+        }
+        registerAllocation(result, subsystem);
+        return result;
+    }
+
+    std::vector<DeviceMemoryAllocator::MemoryTypeStatistics> DeviceMemoryAllocator::getStatistics() const
+    {
+        std::unique_lock lock(_mutex);
+        std::vector<MemoryTypeStatistics> result;
+        for (uint32_t i = 0; i < _memory_types.size(); ++i)
+        {
+            const MemoryType& memory_type = _memory_types[i];
+            if (memory_type.used == false)
+            {
+                continue;
+            }
+            MemoryTypeStatistics statistics{ .memory_type_index = i,
+                .heap_index = _memory_properties.memoryTypes[i].heapIndex,
+                .memory_properties = _memory_properties.memoryTypes[i].propertyFlags,
+                .dedicated_allocation_count = memory_type.dedicated_allocation_count,
+                .live_allocation_count = memory_type.live_allocation_count,
+                .reserved_bytes = memory_type.dedicated_bytes,
+                .used_bytes = memory_type.used_bytes };
+            for (const Pool& pool : memory_type.pools)
+            {
+                for (const auto& block : pool.blocks)
+                {
+                    statistics.block_count++;
+                    statistics.reserved_bytes += block->getSize();
+                    statistics.free_bytes_in_blocks += block->getFreeBytes();
+                    statistics.largest_free_range = std::max(statistics.largest_free_range, block->getLargestFreeRange());
+                }
+            }
+            if (statistics.free_bytes_in_blocks > 0)
+            {
+                statistics.fragmentation = 1.0f - static_cast<float>(statistics.largest_free_range) / static_cast<float>(statistics.free_bytes_in_blocks);
+            }
+            result.push_back(statistics);
+        }
+        return result;
+    }
+
+    std::array<DeviceMemoryAllocator::SubsystemStatistics, kMemorySubsystemCount> DeviceMemoryAllocator::getSubsystemStatistics() const
+    {
+        std::unique_lock lock(_mutex);
+        return _subsystem_statistics;
+    }
+
+    uint32_t DeviceMemoryAllocator::findMemoryType(uint32_t type_filter,
+                                                   VkMemoryPropertyFlags properties,
+                                                   VkMemoryPropertyFlags preferred_properties) const
+    {
+        if (auto memory_type = findMemoryTypeWithProperties(_memory_properties, type_filter, properties | preferred_properties))
+        {
+            return *memory_type;
+        }
+        if (auto memory_type = findMemoryTypeWithProperties(_memory_properties, type_filter, properties))
+        {
+            return *memory_type;
+        }
+
+        throw std::runtime_error("failed to find suitable memory type!");
+    }
+
+    VkDeviceSize DeviceMemoryAllocator::getMinimalAlignment(uint32_t memory_type_index) const
+    {
+        // The mapped ranges of non coherent memory are flushed and invalidated in atoms
+        const VkMemoryPropertyFlags properties = _memory_properties.memoryTypes[memory_type_index].propertyFlags;
+        if ((properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && (properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == 0)
+        {
+            return _non_coherent_atom_size;
+        }
+        return 1;
+    }
+
+    DeviceMemoryAllocator::Allocation DeviceMemoryAllocator::allocateFromPool(const VkMemoryRequirements& requirements,
+                                                                              uint32_t memory_type_index,
+                                                                              PoolType pool_type)
+    {
+        MemoryType& memory_type = _memory_types[memory_type_index];
+        Pool& pool = memory_type.pools[pool_type];
+        // Buddy ranges are aligned to their size
+        const VkDeviceSize size = std::max({ requirements.size, requirements.alignment, getMinimalAlignment(memory_type_index) });
+
+        Block* block = nullptr;
+        std::optional<std::pair<VkDeviceSize, uint32_t>> range;
+        for (auto& pool_block : pool.blocks)
+        {
+            range = pool_block->allocate(size);
+            if (range != std::nullopt)
+            {
+                block = pool_block.get();
+                break;
+            }
+        }
+        if (block == nullptr)
+        {
+            void* mapped_memory = nullptr;
+            VkDeviceMemory memory = allocateMemory(pool.block_size, memory_type_index, nullptr, &mapped_memory);
+            pool.blocks.push_back(std::make_unique<Block>(memory, mapped_memory, pool.block_size, pool.min_allocation_size));
+            block = pool.blocks.back().get();
+            range = block->allocate(size);
+            assert(range != std::nullopt && "Allocation must fit into an empty block");
+        }
+
+        Allocation result;
+        result._allocator = this;
+        result._block = block;
+        result._order = range->second;
+        result._memory = block->getMemory();
+        result._offset = range->first;
+        result._size = pool.min_allocation_size << range->second;
+        result._requested_size = requirements.size;
+        result._mapped_memory = block->getMappedMemory() != nullptr ? static_cast<uint8_t*>(block->getMappedMemory()) + range->first : nullptr;
+        result._memory_type_index = memory_type_index;
+        result._memory_properties = _memory_properties.memoryTypes[memory_type_index].propertyFlags;
+        return result;
+    }
+
+    DeviceMemoryAllocator::Allocation DeviceMemoryAllocator::allocateDedicated(const VkMemoryRequirements& requirements,
+                                                                               uint32_t memory_type_index,
+                                                                               const DedicatedTarget& target)
+    {
+        VkMemoryDedicatedAllocateInfo dedicated_info{};
+        dedicated_info.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+        dedicated_info.buffer = target.buffer;
+        dedicated_info.image = target.image;
+        // Exported memory is imported by other APIs (e.g. CUDA) as a plain allocation, thus it is not marked as dedicated.
+        // Memory without a target is shared by aliased images.
+        const bool has_target = target.buffer != VK_NULL_HANDLE || target.image != VK_NULL_HANDLE;
+        const void* next = target.next != nullptr ? target.next : (has_target ? &dedicated_info : nullptr);
+
+        void* mapped_memory = nullptr;
+        VkDeviceMemory memory = allocateMemory(requirements.size, memory_type_index, next, &mapped_memory);
+
+        Allocation result;
+        result._allocator = this;
+        result._memory = memory;
+        result._size = requirements.size;
+        result._requested_size = requirements.size;
+        result._mapped_memory = mapped_memory;
+        result._memory_type_index = memory_type_index;
+        result._memory_properties = _memory_properties.memoryTypes[memory_type_index].propertyFlags;
+
+        MemoryType& memory_type = _memory_types[memory_type_index];
+        memory_type.dedicated_allocation_count++;
+        memory_type.dedicated_bytes += requirements.size;
+        return result;
+    }
+
+    void DeviceMemoryAllocator::registerAllocation(Allocation& allocation, MemorySubsystem subsystem)
+    {
+        allocation._subsystem = subsystem;
+        MemoryType& memory_type = _memory_types[allocation._memory_type_index];
+        memory_type.used = true;
+        memory_type.live_allocation_count++;
+        memory_type.used_bytes += allocation._requested_size;
+        SubsystemStatistics& subsystem_statistics = _subsystem_statistics[static_cast<size_t>(subsystem)];
+        subsystem_statistics.live_allocation_count++;
+        subsystem_statistics.used_bytes += allocation._requested_size;
+    }
+
+    VkDeviceMemory DeviceMemoryAllocator::allocateMemory(VkDeviceSize size,
+                                                         uint32_t memory_type_index,
+                                                         const void* next,
+                                                         void** mapped_memory)
+    {
+        VkMemoryAllocateInfo allocate_info{};
+        allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocate_info.pNext = next;
+        allocate_info.allocationSize = size;
+        allocate_info.memoryTypeIndex = memory_type_index;
+
+        VkDeviceMemory memory{ VK_NULL_HANDLE };
+        if (_logical_device->vkAllocateMemory(*_logical_device, &allocate_info, nullptr, &memory) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to allocate device memory!");
+        }
+        *mapped_memory = nullptr;
+        if (_memory_properties.memoryTypes[memory_type_index].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+        {
+            if (_logical_device->vkMapMemory(*_logical_device, memory, 0, VK_WHOLE_SIZE, 0, mapped_memory) != VK_SUCCESS)
+            {
+                _logical_device->vkFreeMemory(*_logical_device, memory, nullptr);
+                throw std::runtime_error("failed to map device memory!");
+            }
+        }
+        return memory;
+    }
+
+    void DeviceMemoryAllocator::free(Allocation& allocation) noexcept
+    {
+        std::unique_lock lock(_mutex);
+        MemoryType& memory_type = _memory_types[allocation._memory_type_index];
+        memory_type.live_allocation_count--;
+        memory_type.used_bytes -= allocation._requested_size;
+        SubsystemStatistics& subsystem_statistics = _subsystem_statistics[static_cast<size_t>(allocation._subsystem)];
+        subsystem_statistics.live_allocation_count--;
+        subsystem_statistics.used_bytes -= allocation._requested_size;
+        if (allocation._block == nullptr)
+        {
+            memory_type.dedicated_allocation_count--;
+            memory_type.dedicated_bytes -= allocation._size;
+            _logical_device->vkFreeMemory(*_logical_device, allocation._memory, nullptr);
+            return;
+        }
+
+        Block* block = allocation._block;
+        block->free(allocation._offset, allocation._order);
+        if (block->isEmpty() == false)
+        {
+            return;
+        }
+        // One empty block is kept per pool to not allocate from the driver when the usage oscillates
+        for (Pool& pool : memory_type.pools)
+        {
+            auto it = std::ranges::find_if(pool.blocks, [&](const auto& pool_block) { return pool_block.get() == block; });
+            if (it == pool.blocks.end())
+            {
+                continue;
+            }
+            const auto empty_block_count = std::ranges::count_if(pool.blocks, [](const auto& pool_block) { return pool_block->isEmpty(); });
+            if (empty_block_count > 1)
+            {
+                _logical_device->vkFreeMemory(*_logical_device, block->getMemory(), nullptr);
+                pool.blocks.erase(it);
+            }
+            return;
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#include <render_engine/memory/MemoryTracker.h>
+
+#include <imgui.h>
+
+#include <format>
+#include <string>
+
+namespace RenderEngine
+{
+    namespace
+    {
+        std::string formatBytes(VkDeviceSize bytes)
+        {
+            constexpr double kMebibyte = 1024.0 * 1024.0;
+            return std::format("{:.1f} MiB", static_cast<double>(bytes) / kMebibyte);
+        }
+
+        const char* getSubsystemName(MemorySubsystem subsystem)
+        {
+            switch (subsystem)
+            {
+                case MemorySubsystem::Renderer: return "Renderer";
+                case MemorySubsystem::Transfer: return "Transfer";
+                case MemorySubsystem::Volume: return "Volume";
+            }
+            return "Unknown";
+        }
+
+        std::string getMemoryPropertyNames(VkMemoryPropertyFlags properties)
+        {
+            std::string result;
+            auto append = [&](VkMemoryPropertyFlags flag, const char* name)
+                {
+                    if (properties & flag)
+                    {
+                        result += result.empty() ? name : std::string{ " | " } + name;
+                    }
+                };
+            append(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, "device local");
+            append(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, "host visible");
+            append(VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "host coherent");
+            append(VK_MEMORY_PROPERTY_HOST_CACHED_BIT, "host cached");
+            return result;
+        }
+    }
+
+    MemoryTracker::Report MemoryTracker::createReport() const
+    {
+        Report result;
+        result.memory_types = _memory_allocator.getStatistics();
+        result.subsystems = _memory_allocator.getSubsystemStatistics();
+        result.transient_resources = _transient_resource_pool.getStatistics();
+
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget_properties{};
+        budget_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+        VkPhysicalDeviceMemoryProperties2 memory_properties{};
+        memory_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memory_properties.pNext = _memory_budget_supported ? &budget_properties : nullptr;
+        vkGetPhysicalDeviceMemoryProperties2(_physical_device, &memory_properties);
+
+        const VkPhysicalDeviceMemoryProperties& properties = memory_properties.memoryProperties;
+        result.heaps.reserve(properties.memoryHeapCount);
+        for (uint32_t i = 0; i < properties.memoryHeapCount; ++i)
+        {
+            HeapStatistics heap{ .heap_index = i,
+                .flags = properties.memoryHeaps[i].flags,
+                .size = properties.memoryHeaps[i].size };
+            if (_memory_budget_supported)
+            {
+                heap.budget = budget_properties.heapBudget[i];
+                heap.process_usage = budget_properties.heapUsage[i];
+            }
+            result.heaps.push_back(heap);
+        }
+        for (const auto& memory_type : result.memory_types)
+        {
+            HeapStatistics& heap = result.heaps[memory_type.heap_index];
+            heap.reserved_bytes += memory_type.reserved_bytes;
+            heap.used_bytes += memory_type.used_bytes;
+        }
+        return result;
+    }
+
+    void MemoryTracker::onGui() const
+    {
+        const Report report = createReport();
+
+        ImGui::Begin("Device Memory");
+        if (_memory_budget_supported == false)
+        {
+            ImGui::Text("VK_EXT_memory_budget is not supported, the budget is not known");
+        }
+        if (ImGui::BeginTable("Heaps", 6, ImGuiTableFlags_Borders))
+        {
+            ImGui::TableSetupColumn("Heap");
+            ImGui::TableSetupColumn("Size");
+            ImGui::TableSetupColumn("Budget");
+            ImGui::TableSetupColumn("Process usage");
+            ImGui::TableSetupColumn("Reserved");
+            ImGui::TableSetupColumn("Used");
+            ImGui::TableHeadersRow();
+            for (const auto& heap : report.heaps)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%u%s", heap.heap_index, (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? " (device local)" : "");
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatBytes(heap.size).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(heap.budget ? formatBytes(*heap.budget).c_str() : "-");
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(heap.process_usage ? formatBytes(*heap.process_usage).c_str() : "-");
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatBytes(heap.reserved_bytes).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatBytes(heap.used_bytes).c_str());
+            }
+            ImGui::EndTable();
+        }
+        ImGui::Separator();
+        if (ImGui::BeginTable("Memory types", 7, ImGuiTableFlags_Borders))
+        {
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Properties");
+            ImGui::TableSetupColumn("Blocks");
+            ImGui::TableSetupColumn("Allocations");
+            ImGui::TableSetupColumn("Reserved");
+            ImGui::TableSetupColumn("Used");
+            ImGui::TableSetupColumn("Fragmentation");
+            ImGui::TableHeadersRow();
+            for (const auto& memory_type : report.memory_types)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%u (heap %u)", memory_type.memory_type_index, memory_type.heap_index);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(getMemoryPropertyNames(memory_type.memory_properties).c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%u + %u dedicated", memory_type.block_count, memory_type.dedicated_allocation_count);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", memory_type.live_allocation_count);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatBytes(memory_type.reserved_bytes).c_str());
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatBytes(memory_type.used_bytes).c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", memory_type.fragmentation);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::Separator();
+        if (ImGui::BeginTable("Subsystems", 3, ImGuiTableFlags_Borders))
+        {
+            ImGui::TableSetupColumn("Subsystem");
+            ImGui::TableSetupColumn("Allocations");
+            ImGui::TableSetupColumn("Used");
+            ImGui::TableHeadersRow();
+            for (size_t i = 0; i < report.subsystems.size(); ++i)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(getSubsystemName(static_cast<MemorySubsystem>(i)));
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", report.subsystems[i].live_allocation_count);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(formatBytes(report.subsystems[i].used_bytes).c_str());
+            }
+            ImGui::EndTable();
+        }
+        ImGui::Separator();
+        const TransientResourcePool::Statistics& transient_resources = report.transient_resources;
+        ImGui::Text("Transient textures: %u in %u memory", transient_resources.texture_count, transient_resources.memory_count);
+        ImGui::Text("Allocated: %s, saved by aliasing: %s",
+                    formatBytes(transient_resources.allocated_bytes).c_str(),
+                    formatBytes(transient_resources.getSavedBytes()).c_str());
+        ImGui::End();
+    }
+}
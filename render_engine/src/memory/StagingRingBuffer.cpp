@@ -0,0 +1,211 @@
+#include <render_engine/memory/StagingRingBuffer.h>
+
+#include <render_engine/resources/Buffer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace RenderEngine
+{
+    namespace
+    {
+        constexpr VkDeviceSize kMinimalAlignment = 16;
+
+        BufferInfo createStagingBufferInfo(VkDeviceSize size, StagingRingBuffer::Usage usage)
+        {
+            switch (usage)
+            {
+                case StagingRingBuffer::Usage::Upload:
+                    return BufferInfo{
+                        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                        .size = size,
+                        .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                        .subsystem = MemorySubsystem::Transfer
+                    };
+                case StagingRingBuffer::Usage::Download:
+                    return BufferInfo{
+                        .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        .size = size,
+                        .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                        .preferred_memory_properties = VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+                        .subsystem = MemorySubsystem::Transfer
+                    };
+            }
+            assert(false && "Unhandled staging usage");
+            return {};
+        }
+    }
+
+    StagingRingBuffer::Allocation::~Allocation()
+    {
+        release();
+    }
+
+    StagingRingBuffer::Allocation& StagingRingBuffer::Allocation::operator=(Allocation&& o) noexcept
+    {
+        if (this != &o)
+        {
+            release();
+            _ring = std::move(o._ring);
+            _region_id = o._region_id;
+            _buffer = o._buffer;
+            _offset = o._offset;
+            _size = o._size;
+            _memory = o._memory;
+            _dedicated_buffer = std::move(o._dedicated_buffer);
+        }
+        return *this;
+    }
+
+    void StagingRingBuffer::Allocation::upload(std::span<const uint8_t> data_view)
+    {
+        assert(data_view.size() <= _size && "Data doesn't fit into the staging allocation");
+        std::memcpy(_memory, data_view.data(), data_view.size());
+    }
+
+    void StagingRingBuffer::Allocation::invalidate()
+    {
+        if (_dedicated_buffer != nullptr)
+        {
+            _dedicated_buffer->invalidate(0, _size);
+        }
+        else if (auto ring = _ring.lock())
+        {
+            ring->_buffer->invalidate(_offset, _size);
+        }
+    }
+
+    void StagingRingBuffer::Allocation::release() noexcept
+    {
+        if (auto ring = _ring.lock())
+        {
+            ring->release(_region_id);
+        }
+        _ring.reset();
+        _dedicated_buffer.reset();
+        _buffer = VK_NULL_HANDLE;
+        _memory = nullptr;
+        _offset = 0;
+        _size = 0;
+    }
+
+    StagingRingBuffer::StagingRingBuffer(VkPhysicalDevice physical_device,
+                                         LogicalDevice& logical_device,
+                                         DeviceMemoryAllocator& memory_allocator,
+                                         VkDeviceSize capacity,
+                                         Usage usage,
+                                         CreationToken)
+        : _physical_device(physical_device)
+        , _logical_device(logical_device)
+        , _memory_allocator(memory_allocator)
+        , _usage(usage)
+        , _buffer(std::make_unique<CoherentBuffer>(physical_device, logical_device, memory_allocator, createStagingBufferInfo(capacity, usage)))
+    {
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(_physical_device, &properties);
+        _alignment = std::max({ kMinimalAlignment,
+                              properties.limits.optimalBufferCopyOffsetAlignment,
+                              properties.limits.nonCoherentAtomSize });
+        _statistics.capacity = capacity;
+    }
+
+    StagingRingBuffer::~StagingRingBuffer() = default;
+
+    StagingRingBuffer::Allocation StagingRingBuffer::allocate(VkDeviceSize size)
+    {
+        assert(size > 0 && "Empty staging allocation is not supported");
+        std::unique_lock lock(_mutex);
+        Allocation result;
+        result._size = size;
+        _statistics.allocation_count++;
+
+        const std::optional<VkDeviceSize> offset = findSpace(size);
+        if (offset == std::nullopt)
+        {
+            _statistics.dedicated_allocation_count++;
+            result._dedicated_buffer = std::make_unique<CoherentBuffer>(_physical_device, _logical_device, _memory_allocator, createStagingBufferInfo(size, _usage));
+            result._buffer = result._dedicated_buffer->getBuffer();
+            result._memory = static_cast<uint8_t*>(result._dedicated_buffer->getMemory());
+            return result;
+        }
+        if (_regions.empty())
+        {
+            _tail = *offset;
+        }
+        _head = *offset + size;
+        result._ring = weak_from_this();
+        result._region_id = _first_region_id + _regions.size();
+        result._buffer = _buffer->getBuffer();
+        result._offset = *offset;
+        result._memory = static_cast<uint8_t*>(_buffer->getMemory()) + *offset;
+        _regions.push_back(Region{ .end = _head });
+
+        _statistics.used = calculateUsedSize();
+        _statistics.high_water_mark = std::max(_statistics.high_water_mark, _statistics.used);
+        return result;
+    }
+
+    void StagingRingBuffer::release(uint64_t region_id)
+    {
+        std::unique_lock lock(_mutex);
+        assert(region_id >= _first_region_id && region_id - _first_region_id < _regions.size() && "Invalid staging region");
+        _regions[region_id - _first_region_id].released = true;
+        while (_regions.empty() == false && _regions.front().released)
+        {
+            _tail = _regions.front().end;
+            _regions.pop_front();
+            _first_region_id++;
+        }
+        _statistics.used = calculateUsedSize();
+    }
+
+    std::optional<VkDeviceSize> StagingRingBuffer::findSpace(VkDeviceSize size) const
+    {
+        const VkDeviceSize capacity = _statistics.capacity;
+        if (_regions.empty())
+        {
+            return size <= capacity ? std::optional<VkDeviceSize>{ 0 } : std::nullopt;
+        }
+        if (_head > _tail)
+        {
+            const VkDeviceSize offset = alignOffset(_head);
+            if (offset + size <= capacity)
+            {
+                return offset;
+            }
+            // Wrap around. The end of the buffer is reclaimed together with the last region before it
+            if (size <= _tail)
+            {
+                return 0;
+            }
+            return std::nullopt;
+        }
+        if (_head < _tail)
+        {
+            const VkDeviceSize offset = alignOffset(_head);
+            if (offset + size <= _tail)
+            {
+                return offset;
+            }
+        }
+        // head == tail with living regions: the ring is full
+        return std::nullopt;
+    }
+
+    VkDeviceSize StagingRingBuffer::alignOffset(VkDeviceSize offset) const
+    {
+        return (offset + _alignment - 1) / _alignment * _alignment;
+    }
+
+    VkDeviceSize StagingRingBuffer::calculateUsedSize() const
+    {
+        if (_regions.empty())
+        {
+            return 0;
+        }
+        return _head > _tail
+            ? _head - _tail
+            : _statistics.capacity - _tail + _head;
+    }
+}
@@ -0,0 +1,191 @@
+#include <render_engine/memory/TransientResourcePool.h>
+
+#include <render_engine/resources/Texture.h>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace RenderEngine
+{
+    TransientResourcePool::TransientTexture::TransientTexture(TransientResourcePool& pool, std::unique_ptr<Texture> texture)
+        : _pool(&pool)
+        , _texture(std::move(texture))
+    {}
+
+    TransientResourcePool::TransientTexture::~TransientTexture()
+    {
+        reset();
+    }
+
+    TransientResourcePool::TransientTexture::TransientTexture(TransientTexture&& o) noexcept
+        : _pool(std::exchange(o._pool, nullptr))
+        , _texture(std::move(o._texture))
+    {}
+
+    TransientResourcePool::TransientTexture& TransientResourcePool::TransientTexture::operator=(TransientTexture&& o) noexcept
+    {
+        if (this != &o)
+        {
+            reset();
+            _pool = std::exchange(o._pool, nullptr);
+            _texture = std::move(o._texture);
+        }
+        return *this;
+    }
+
+    void TransientResourcePool::TransientTexture::reset() noexcept
+    {
+        if (_texture == nullptr)
+        {
+            return;
+        }
+        _pool->release(*_texture);
+        _texture.reset();
+        _pool = nullptr;
+    }
+
+    TransientResourcePool::TransientResourcePool(TextureFactory& texture_factory,
+                                                 LogicalDevice& logical_device,
+                                                 DeviceMemoryAllocator& memory_allocator)
+        : _texture_factory(texture_factory)
+        , _logical_device(logical_device)
+        , _memory_allocator(memory_allocator)
+    {}
+
+    TransientResourcePool::~TransientResourcePool()
+    {
+        assert(_memories.empty() && "Transient textures outlive their pool");
+    }
+
+    TransientResourcePool::LiveRange TransientResourcePool::reserveSteps(uint32_t step_count)
+    {
+        assert(step_count > 0 && "At least one step has to be reserved");
+        std::unique_lock lock(_mutex);
+        LiveRange result{ .first_step = _next_step, .last_step = _next_step + step_count - 1 };
+        _next_step += step_count;
+        return result;
+    }
+
+    TransientResourcePool::TransientTexture TransientResourcePool::createTexture(Image image,
+                                                                                 VkImageAspectFlags aspect,
+                                                                                 VkShaderStageFlags shader_usage,
+                                                                                 VkImageUsageFlags image_usage,
+                                                                                 VkQueue queue,
+                                                                                 LiveRange live_range,
+                                                                                 MemorySubsystem subsystem)
+    {
+        assert(live_range.first_step <= live_range.last_step && "Live range ends before it starts");
+
+        std::unique_ptr<Texture> texture = _texture_factory.createWithoutMemory(std::move(image), aspect, shader_usage, image_usage);
+        const VkMemoryRequirements& requirements = texture->getMemoryRequirements();
+        // The driver commits lazily allocated memory only for the attachments which need it
+        const VkMemoryPropertyFlags preferred_properties = (image_usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+            ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT
+            : 0;
+
+        std::unique_lock lock(_mutex);
+        Memory* memory = findMemory(requirements, preferred_properties, subsystem, queue, live_range);
+        if (memory == nullptr)
+        {
+            auto new_memory = std::make_unique<Memory>();
+            new_memory->allocation = _memory_allocator.allocateForAliasedImages(requirements,
+                                                                                subsystem,
+                                                                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                                                preferred_properties);
+            new_memory->size = requirements.size;
+            new_memory->preferred_properties = preferred_properties;
+            new_memory->queue = queue;
+            memory = new_memory.get();
+            _memories.push_back(std::move(new_memory));
+        }
+        if (_logical_device->vkBindImageMemory(*_logical_device,
+                                               texture->getVkImage(),
+                                               memory->allocation.getMemory(),
+                                               memory->allocation.getOffset()) != VK_SUCCESS)
+        {
+            if (memory->textures.empty())
+            {
+                std::erase_if(_memories, [&](const auto& pool_memory) { return pool_memory.get() == memory; });
+            }
+            throw std::runtime_error("Cannot bind the memory of a transient texture");
+        }
+        memory->textures.push_back(AliasedTexture{ .texture = texture.get(), .live_range = live_range, .size = requirements.size });
+        return TransientTexture{ *this, std::move(texture) };
+    }
+
+    TransientResourcePool::Statistics TransientResourcePool::getStatistics() const
+    {
+        std::unique_lock lock(_mutex);
+        Statistics result;
+        for (const auto& memory : _memories)
+        {
+            result.memory_count++;
+            result.allocated_bytes += memory->size;
+            for (const AliasedTexture& texture : memory->textures)
+            {
+                result.texture_count++;
+                result.texture_bytes += texture.size;
+            }
+        }
+        return result;
+    }
+
+    TransientResourcePool::Memory* TransientResourcePool::findMemory(const VkMemoryRequirements& requirements,
+                                                                     VkMemoryPropertyFlags preferred_properties,
+                                                                     MemorySubsystem subsystem,
+                                                                     VkQueue queue,
+                                                                     const LiveRange& live_range)
+    {
+        Memory* result = nullptr;
+        for (const auto& memory : _memories)
+        {
+            const DeviceMemoryAllocator::Allocation& allocation = memory->allocation;
+            const bool compatible = memory->size >= requirements.size
+                && (requirements.memoryTypeBits & (1u << allocation.getMemoryTypeIndex())) != 0
+                && allocation.getOffset() % requirements.alignment == 0
+                && allocation.getSubsystem() == subsystem
+                && memory->preferred_properties == preferred_properties
+                && memory->queue == queue;
+            if (compatible == false)
+            {
+                continue;
+            }
+            const bool overlaps = std::ranges::any_of(memory->textures,
+                                                      [&](const AliasedTexture& texture) { return texture.live_range.overlaps(live_range); });
+            if (overlaps)
+            {
+                continue;
+            }
+            // The smallest memory wastes the least when a larger texture comes later
+            if (result == nullptr || memory->size < result->size)
+            {
+                result = memory.get();
+            }
+        }
+        return result;
+    }
+
+    void TransientResourcePool::release(const Texture& texture) noexcept
+    {
+        std::unique_lock lock(_mutex);
+        for (auto memory_it = _memories.begin(); memory_it != _memories.end(); ++memory_it)
+        {
+            Memory& memory = **memory_it;
+            const auto texture_it = std::ranges::find(memory.textures, &texture, &AliasedTexture::texture);
+            if (texture_it == memory.textures.end())
+            {
+                continue;
+            }
+            memory.textures.erase(texture_it);
+            // The memory is freed with its last texture, thus its size follows the current textures
+            if (memory.textures.empty())
+            {
+                _memories.erase(memory_it);
+            }
+            return;
+        }
+        assert(false && "Texture is not allocated from the transient resource pool");
+    }
+}
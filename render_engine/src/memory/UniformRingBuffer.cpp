@@ -0,0 +1,64 @@
+#include <render_engine/memory/UniformRingBuffer.h>
+
+#include <render_engine/resources/Buffer.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace RenderEngine
+{
+    UniformRingBuffer::UniformRingBuffer(VkPhysicalDevice physical_device,
+                                         LogicalDevice& logical_device,
+                                         DeviceMemoryAllocator& memory_allocator,
+                                         uint32_t back_buffer_size,
+                                         VkDeviceSize size_per_frame)
+        : _size_per_frame(size_per_frame)
+    {
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(physical_device, &properties);
+        _alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment, 1);
+
+        for (uint32_t i = 0; i < back_buffer_size; ++i)
+        {
+            auto frame = std::make_unique<Frame>();
+            frame->buffer = std::make_unique<CoherentBuffer>(physical_device,
+                                                             logical_device,
+                                                             memory_allocator,
+                                                             BufferInfo{ .usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                                                 .size = size_per_frame,
+                                                                 .memory_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT });
+            _frames.push_back(std::move(frame));
+        }
+    }
+
+    UniformRingBuffer::~UniformRingBuffer() = default;
+
+    UniformRingBuffer::Allocation UniformRingBuffer::allocate(uint32_t back_buffer_index, VkDeviceSize size)
+    {
+        Frame& frame = *_frames[back_buffer_index];
+        const VkDeviceSize aligned_size = (size + _alignment - 1) / _alignment * _alignment;
+        const VkDeviceSize offset = frame.head.fetch_add(aligned_size, std::memory_order_relaxed);
+        if (offset + size > _size_per_frame)
+        {
+            throw std::runtime_error("Uniform ring buffer of the frame is full");
+        }
+
+        VkDeviceSize high_water_mark = _high_water_mark.load(std::memory_order_relaxed);
+        while (high_water_mark < offset + aligned_size
+               && _high_water_mark.compare_exchange_weak(high_water_mark, offset + aligned_size, std::memory_order_relaxed) == false)
+        {}
+
+        return Allocation{ .memory = static_cast<uint8_t*>(frame.buffer->getMemory()) + offset,
+            .offset = static_cast<uint32_t>(offset) };
+    }
+
+    void UniformRingBuffer::onFrameBegin(uint32_t back_buffer_index)
+    {
+        _frames[back_buffer_index]->head.store(0, std::memory_order_relaxed);
+    }
+
+    VkBuffer UniformRingBuffer::getBuffer(uint32_t back_buffer_index) const
+    {
+        return _frames[back_buffer_index]->buffer->getBuffer();
+    }
+}
@@ -352,6 +352,7 @@ namespace RenderEngine
                                      uint32_t back_buffer_size,
                                      bool last_ExampleRenderer)
         : _window(window)
+        , _command_context(window.getRenderEngine().getCommandContext().clone())
     {
         auto& logical_device = window.getDevice().getLogicalDevice();
         auto [vert_shader, frag_shader] = loadShaders(logical_device, BASE_VERT_SHADER, BASE_FRAG_SHADER);
@@ -431,7 +432,7 @@ namespace RenderEngine
 
     void ExampleRenderer::draw(const VkFramebuffer& frame_buffer, FrameData& frame_data)
     {
-        frame_data.color_offset->upload(std::span(&_color_offset, 1));
+        frame_data.color_offset->upload(std::span(&_frame_color_offset, 1));
 
         getLogicalDevice()->vkResetCommandBuffer(frame_data.command_buffer, /*VkCommandBufferResetFlagBits*/ 0);
         VkCommandBufferBeginInfo begin_info{};
@@ -557,7 +558,7 @@ namespace RenderEngine
 
     void ExampleRenderer::createCommandBuffer()
     {
-        std::vector<VkCommandBuffer> command_buffers = _window.getRenderEngine().getCommandContext().createCommandBuffers(static_cast<uint32_t>(_back_buffer.size()), CommandContext::Usage::MultipleSubmit);
+        std::vector<VkCommandBuffer> command_buffers = _command_context->createCommandBuffers(static_cast<uint32_t>(_back_buffer.size()), CommandContext::Usage::MultipleSubmit);
         for (uint32_t i = 0; i < _back_buffer.size(); ++i)
         {
             _back_buffer[i].command_buffer = command_buffers[i];
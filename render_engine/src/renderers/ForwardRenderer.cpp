@@ -10,11 +10,13 @@
 #include <render_engine/assets/Mesh.h>
 #include <render_engine/assets/Shader.h>
 #include <render_engine/GpuResourceManager.h>
+#include <render_engine/RenderContext.h>
 #include <render_engine/resources/Buffer.h>
 #include <render_engine/resources/PushConstantsUpdater.h>
 #include <render_engine/resources/RenderTarget.h>
 #include <render_engine/resources/Technique.h>
 
+#include <algorithm>
 #include <ranges>
 
 namespace RenderEngine
@@ -145,64 +147,149 @@ namespace RenderEngine
         render_pass_info.clearValueCount = 1;
         render_pass_info.pClearValues = &clearColor;
 
-        getLogicalDevice()->vkCmdBeginRenderPass(frame_data.command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+        // The frames begin without command buffer, the chunks record the push constants of their frame
+        std::vector<MaterialInstance::UpdateContext> frame_contexts;
+        frame_contexts.reserve(_meshes.size());
+        size_t draw_call_count = 0;
         for (auto& mesh_group : _meshes)
         {
-            auto technique_marker = _performance_markers.createMarker(frame_data.command_buffer,
-                                                                      mesh_group.technique->getMaterialInstance().getMaterial().getName());
+            frame_contexts.push_back(mesh_group.technique->onFrameBegin(swap_chain_image_index, VK_NULL_HANDLE));
+            draw_call_count += mesh_group.mesh_instances.size();
+        }
+        const std::vector<DrawCallChunk> chunks = createDrawCallChunks(frame_contexts);
+        // A few draw calls are recorded faster inline than by the job system
+        const bool record_in_parallel = _draw_call_chunk_size > 0 && draw_call_count > _draw_call_chunk_size;
+        if (record_in_parallel)
+        {
+            getLogicalDevice()->vkCmdBeginRenderPass(frame_data.command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+            recordDrawCallChunksInParallel(frame_data.command_buffer, chunks, swap_chain_image_index);
+        }
+        else
+        {
+            getLogicalDevice()->vkCmdBeginRenderPass(frame_data.command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+            for (const DrawCallChunk& chunk : chunks)
+            {
+                recordDrawCallChunk(frame_data.command_buffer, chunk);
+            }
+        }
+        getLogicalDevice()->vkCmdEndRenderPass(frame_data.command_buffer);
 
-            MaterialInstance::UpdateContext material_update_context = mesh_group.technique->onFrameBegin(swap_chain_image_index, frame_data.command_buffer);
+        if (getLogicalDevice()->vkEndCommandBuffer(frame_data.command_buffer) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to record command buffer!");
+        }
+    }
 
-            getLogicalDevice()->vkCmdBindPipeline(frame_data.command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mesh_group.technique->getPipeline());
+    std::vector<ForwardRenderer::DrawCallChunk> ForwardRenderer::createDrawCallChunks(std::span<MaterialInstance::UpdateContext> frame_contexts)
+    {
+        std::vector<DrawCallChunk> result;
+        for (size_t i = 0; i < _meshes.size(); ++i)
+        {
+            MeshGroup& mesh_group = _meshes[i];
+            const std::span<const MeshInstance* const> mesh_instances = mesh_group.mesh_instances;
+            const size_t chunk_size = _draw_call_chunk_size > 0 ? _draw_call_chunk_size : mesh_instances.size();
+            for (size_t offset = 0; offset < mesh_instances.size(); offset += chunk_size)
+            {
+                result.push_back(DrawCallChunk{ .mesh_group = &mesh_group,
+                                                .frame_context = &frame_contexts[i],
+                                                .mesh_instances = mesh_instances.subspan(offset, std::min(chunk_size, mesh_instances.size() - offset)) });
+            }
+        }
+        return result;
+    }
 
-            VkViewport viewport{};
-            viewport.x = 0.0f;
-            viewport.y = 0.0f;
-            viewport.width = (float)render_area.extent.width;
-            viewport.height = (float)render_area.extent.height;
-            viewport.minDepth = 0.0f;
-            viewport.maxDepth = 1.0f;
-            getLogicalDevice()->vkCmdSetViewport(frame_data.command_buffer, 0, 1, &viewport);
+    void ForwardRenderer::recordDrawCallChunk(VkCommandBuffer command_buffer, const DrawCallChunk& chunk)
+    {
+        Technique& technique = *chunk.mesh_group->technique;
+        auto technique_marker = _performance_markers.createMarker(command_buffer,
+                                                                  technique.getMaterialInstance().getMaterial().getName());
 
-            VkRect2D scissor{};
-            scissor.offset = { 0, 0 };
-            scissor.extent = render_area.extent;
-            getLogicalDevice()->vkCmdSetScissor(frame_data.command_buffer, 0, 1, &scissor);
-            auto descriptor_sets = mesh_group.technique->collectDescriptorSets(swap_chain_image_index);
+        // The secondary command buffers don't inherit the state, every chunk records the push constants of the frame
+        MaterialInstance::UpdateContext material_update_context = technique.continueFrame(*chunk.frame_context, command_buffer);
 
-            if (descriptor_sets.empty() == false)
-            {
-                getLogicalDevice()->vkCmdBindDescriptorSets(frame_data.command_buffer,
-                                                            VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                            mesh_group.technique->getPipelineLayout(),
-                                                            0,
-                                                            static_cast<uint32_t>(descriptor_sets.size()),
-                                                            descriptor_sets.data(),
-                                                            0,
-                                                            nullptr);
-            }
+        getLogicalDevice()->vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, technique.getPipeline());
 
-            for (auto& mesh_instance : mesh_group.mesh_instances)
-            {
-                mesh_group.technique->onDraw(material_update_context, mesh_instance);
-                auto& mesh_buffers = _mesh_buffers.at(mesh_instance->getMesh());
+        auto render_area = getRenderArea();
+        VkViewport viewport{};
+        viewport.x = 0.0f;
+        viewport.y = 0.0f;
+        viewport.width = (float)render_area.extent.width;
+        viewport.height = (float)render_area.extent.height;
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+        getLogicalDevice()->vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+
+        VkRect2D scissor{};
+        scissor.offset = { 0, 0 };
+        scissor.extent = render_area.extent;
+        getLogicalDevice()->vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+        technique.bindDescriptorSets(material_update_context.getUniformBufferUpdater());
+
+        for (const MeshInstance* mesh_instance : chunk.mesh_instances)
+        {
+            technique.onDraw(material_update_context, mesh_instance);
+            auto& mesh_buffers = _mesh_buffers.at(mesh_instance->getMesh());
 
-                VkBuffer vertexBuffers[] = { mesh_buffers.vertex_buffer->getBuffer() };
-                VkDeviceSize offsets[] = { 0 };
-                getLogicalDevice()->vkCmdBindVertexBuffers(frame_data.command_buffer, 0, 1, vertexBuffers, offsets);
-                getLogicalDevice()->vkCmdBindIndexBuffer(frame_data.command_buffer, mesh_buffers.index_buffer->getBuffer(), 0, VK_INDEX_TYPE_UINT16);
+            VkBuffer vertexBuffers[] = { mesh_buffers.vertex_buffer->getBuffer() };
+            VkDeviceSize offsets[] = { 0 };
+            getLogicalDevice()->vkCmdBindVertexBuffers(command_buffer, 0, 1, vertexBuffers, offsets);
+            getLogicalDevice()->vkCmdBindIndexBuffer(command_buffer, mesh_buffers.index_buffer->getBuffer(), 0, VK_INDEX_TYPE_UINT16);
 
 
-                getLogicalDevice()->vkCmdDrawIndexed(frame_data.command_buffer, static_cast<uint32_t>(mesh_buffers.index_buffer->getDeviceSize() / sizeof(uint16_t)), 1, 0, 0, 0);
-            }
-            technique_marker.finish();
+            getLogicalDevice()->vkCmdDrawIndexed(command_buffer, static_cast<uint32_t>(mesh_buffers.index_buffer->getDeviceSize() / sizeof(uint16_t)), 1, 0, 0, 0);
         }
-        getLogicalDevice()->vkCmdEndRenderPass(frame_data.command_buffer);
+        technique_marker.finish();
+    }
 
-        if (getLogicalDevice()->vkEndCommandBuffer(frame_data.command_buffer) != VK_SUCCESS)
+    void ForwardRenderer::recordDrawCallChunksInParallel(VkCommandBuffer command_buffer,
+                                                         const std::vector<DrawCallChunk>& chunks,
+                                                         uint32_t swap_chain_image_index)
+    {
+        const uint32_t back_buffer_size = getWindow().getRenderEngine().getGpuResourceManager().getBackBufferSize();
+        while (_chunk_recorders.size() < chunks.size())
         {
-            throw std::runtime_error("failed to record command buffer!");
+            ChunkRecorder chunk_recorder;
+            chunk_recorder.command_context = getWindow().getRenderEngine().getCommandContext().clone();
+            chunk_recorder.command_buffers = chunk_recorder.command_context->createSecondaryCommandBuffers(back_buffer_size);
+            _chunk_recorders.push_back(std::move(chunk_recorder));
+        }
+
+        VkCommandBufferInheritanceInfo inheritance_info{};
+        inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance_info.renderPass = getRenderPass();
+        inheritance_info.subpass = 0;
+        inheritance_info.framebuffer = getFrameBuffer(swap_chain_image_index);
+
+        auto record_chunk = [&](uint32_t chunk_index)
+            {
+                VkCommandBuffer secondary_command_buffer = _chunk_recorders[chunk_index].command_buffers[swap_chain_image_index];
+
+                VkCommandBufferBeginInfo begin_info{};
+                begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                begin_info.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+                begin_info.pInheritanceInfo = &inheritance_info;
+                if (getLogicalDevice()->vkBeginCommandBuffer(secondary_command_buffer, &begin_info) != VK_SUCCESS)
+                {
+                    throw std::runtime_error("failed to begin recording secondary command buffer!");
+                }
+                recordDrawCallChunk(secondary_command_buffer, chunks[chunk_index]);
+                if (getLogicalDevice()->vkEndCommandBuffer(secondary_command_buffer) != VK_SUCCESS)
+                {
+                    throw std::runtime_error("failed to record secondary command buffer!");
+                }
+            };
+        RenderContext::context().getJobSystem().parallelFor(static_cast<uint32_t>(chunks.size()), record_chunk);
+
+        // Executed in the order of the chunks, thus the result is the same as the one recorded on a single thread
+        std::vector<VkCommandBuffer> secondary_command_buffers;
+        secondary_command_buffers.reserve(chunks.size());
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            secondary_command_buffers.push_back(_chunk_recorders[i].command_buffers[swap_chain_image_index]);
         }
+        getLogicalDevice()->vkCmdExecuteCommands(command_buffer,
+                                                 static_cast<uint32_t>(secondary_command_buffers.size()),
+                                                 secondary_command_buffers.data());
     }
 
     void ForwardRenderer::onFrameBegin(uint32_t frame_number)
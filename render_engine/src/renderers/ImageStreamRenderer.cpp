@@ -6,14 +6,92 @@
 #include <render_engine/resources/RenderTarget.h>
 #include <render_engine/resources/Technique.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <format>
+#include <functional>
 #include <iostream>
+#include <ranges>
+#include <span>
+#include <vector>
 
 namespace RenderEngine
 {
     namespace
     {
+        // Granularity of the change detection between two frames of the stream
+        constexpr uint32_t kDirtyTileSize = 64;
+
+        std::vector<bool> findChangedTiles(std::span<const uint8_t> old_data,
+                                           std::span<const uint8_t> new_data,
+                                           uint32_t width,
+                                           uint32_t height,
+                                           uint32_t tile_column_count,
+                                           uint32_t tile_row_count)
+        {
+            if (old_data.size() != new_data.size())
+            {
+                return std::vector<bool>(tile_column_count * tile_row_count, true);
+            }
+            std::vector<bool> result(tile_column_count * tile_row_count, false);
+            const size_t texel_size = new_data.size() / (static_cast<size_t>(width) * height);
+            for (uint32_t y = 0; y < height; ++y)
+            {
+                const uint32_t tile_row = y / kDirtyTileSize;
+                for (uint32_t tile_column = 0; tile_column < tile_column_count; ++tile_column)
+                {
+                    const size_t tile_index = tile_row * tile_column_count + tile_column;
+                    if (result[tile_index])
+                    {
+                        continue;
+                    }
+                    const uint32_t x_begin = tile_column * kDirtyTileSize;
+                    const uint32_t x_end = std::min(width, x_begin + kDirtyTileSize);
+                    const size_t offset = (static_cast<size_t>(y) * width + x_begin) * texel_size;
+                    const size_t size = (x_end - x_begin) * texel_size;
+                    result[tile_index] = std::memcmp(old_data.data() + offset, new_data.data() + offset, size) != 0;
+                }
+            }
+            return result;
+        }
+
+        /*
+        * Merges the neighbouring dirty tiles of a tile row into one region. The regions don't overlap.
+        */
+        std::vector<VkRect2D> createRegionsFromTiles(const std::vector<bool>& dirty_tiles,
+                                                     uint32_t width,
+                                                     uint32_t height,
+                                                     uint32_t tile_column_count,
+                                                     uint32_t tile_row_count)
+        {
+            std::vector<VkRect2D> result;
+            for (uint32_t tile_row = 0; tile_row < tile_row_count; ++tile_row)
+            {
+                const uint32_t y_begin = tile_row * kDirtyTileSize;
+                const uint32_t y_end = std::min(height, y_begin + kDirtyTileSize);
+                uint32_t tile_column = 0;
+                while (tile_column < tile_column_count)
+                {
+                    if (dirty_tiles[tile_row * tile_column_count + tile_column] == false)
+                    {
+                        ++tile_column;
+                        continue;
+                    }
+                    const uint32_t first_column = tile_column;
+                    while (tile_column < tile_column_count && dirty_tiles[tile_row * tile_column_count + tile_column])
+                    {
+                        ++tile_column;
+                    }
+                    const uint32_t x_begin = first_column * kDirtyTileSize;
+                    const uint32_t x_end = std::min(width, tile_column * kDirtyTileSize);
+                    result.push_back(VkRect2D{ .offset = { static_cast<int32_t>(x_begin), static_cast<int32_t>(y_begin) },
+                                     .extent = { x_end - x_begin, y_end - y_begin } });
+                }
+            }
+            return result;
+        }
+
         /*
         #version 450
 
@@ -171,6 +249,8 @@ namespace RenderEngine
         , _image_cache(image_stream.getImageDescription().width,
                        image_stream.getImageDescription().height,
                        image_stream.getImageDescription().format)
+        , _tile_column_count((image_stream.getImageDescription().width + kDirtyTileSize - 1) / kDirtyTileSize)
+        , _tile_row_count((image_stream.getImageDescription().height + kDirtyTileSize - 1) / kDirtyTileSize)
     {
         VkAttachmentDescription color_attachment{};
         color_attachment.format = render_target.getImageFormat();
@@ -276,7 +356,7 @@ namespace RenderEngine
         }
         auto& texture = _texture_container[image_index];
         auto it = _upload_data.find(texture.get());
-        if (it == _upload_data.end())
+        if (it == _upload_data.end() || it->second.upload_scheduled == false)
         {
             return {};
         }
@@ -295,12 +375,29 @@ namespace RenderEngine
 
     void ImageStreamRenderer::draw(uint32_t swap_chain_image_index)
     {
-        static std::vector<uint8_t> image_data;
+        std::vector<uint8_t>& image_data = _image_buffer;
         image_data.clear();
         _image_stream >> image_data;
         if (image_data.empty() == false)
         {
-            _image_cache.setData(image_data);
+            // Without previous byte data every tile counts as changed
+            const auto* previous_data = std::get_if<std::vector<uint8_t>>(&_image_cache.getData());
+            const std::vector<bool> changed_tiles = findChangedTiles(previous_data != nullptr ? std::span<const uint8_t>(*previous_data) : std::span<const uint8_t>{},
+                                                                     image_data,
+                                                                     _image_cache.getWidth(),
+                                                                     _image_cache.getHeight(),
+                                                                     _tile_column_count,
+                                                                     _tile_row_count);
+            for (auto& upload_data : _upload_data | std::ranges::views::values)
+            {
+                std::ranges::transform(upload_data.dirty_tiles, changed_tiles, upload_data.dirty_tiles.begin(), std::logical_or<bool>{});
+            }
+            // The previous frame's buffer is given back to the image stream by the next read
+            Image::RawData previous_data = _image_cache.exchangeData(std::move(image_data));
+            if (auto* previous_bytes = std::get_if<std::vector<uint8_t>>(&previous_data))
+            {
+                image_data = std::move(*previous_bytes);
+            }
         }
         auto& logical_device = getLogicalDevice();
 
@@ -311,14 +408,14 @@ namespace RenderEngine
             {
                 SyncObject sync_objcet = SyncObject::CreateEmpty(logical_device);
 
-                sync_objcet.createSemaphore("copy-finished");
+                const SemaphoreId copy_finished = sync_objcet.createSemaphore("copy-finished");
                 sync_objcet.addSignalOperationToGroup(SyncGroups::kInternal,
-                                                      "copy-finished",
+                                                      copy_finished,
                                                       VK_PIPELINE_STAGE_2_COPY_BIT);
 
 
                 sync_objcet.addWaitOperationToGroup(SyncGroups::kExternal,
-                                                    "copy-finished",
+                                                    copy_finished,
                                                     VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT); // TODO add as pipeline dependency
 
                 getWindow().getDevice().getStagingArea().getScheduler().upload(upload_texture.get(),
@@ -331,18 +428,31 @@ namespace RenderEngine
                                                                                sync_objcet.getOperationsGroup(SyncGroups::kInternal));
 
                 _upload_data.insert(std::make_pair(upload_texture.get(),
-                                                   UploadData(std::move(sync_objcet))));
+                                                   UploadData(std::move(sync_objcet), _tile_column_count * _tile_row_count)));
             }
             else
             {
-                getWindow().getDevice().getStagingArea().getScheduler().upload(upload_texture.get(),
-                                                                               _image_cache,
-                                                                               getWindow().getRenderEngine().getCommandContext(),
-                                                                               upload_texture->getResourceState().clone()
-                                                                               .setPipelineStage(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)
-                                                                               .setAccessFlag(VK_ACCESS_2_SHADER_READ_BIT)
-                                                                               .setImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL),
-                                                                               it->second.synchronization_object.getOperationsGroup(SyncGroups::kInternal));
+                // Only the tiles that changed since the last upload of this texture are uploaded
+                UploadData& upload_data = it->second;
+                const std::vector<VkRect2D> regions = createRegionsFromTiles(upload_data.dirty_tiles,
+                                                                             _image_cache.getWidth(),
+                                                                             _image_cache.getHeight(),
+                                                                             _tile_column_count,
+                                                                             _tile_row_count);
+                std::ranges::fill(upload_data.dirty_tiles, false);
+                upload_data.upload_scheduled = regions.empty() == false;
+                if (upload_data.upload_scheduled)
+                {
+                    getWindow().getDevice().getStagingArea().getScheduler().upload(upload_texture.get(),
+                                                                                   _image_cache,
+                                                                                   regions,
+                                                                                   getWindow().getRenderEngine().getCommandContext(),
+                                                                                   upload_texture->getResourceState().clone()
+                                                                                   .setPipelineStage(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)
+                                                                                   .setAccessFlag(VK_ACCESS_2_SHADER_READ_BIT)
+                                                                                   .setImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL),
+                                                                                   upload_data.synchronization_object.getOperationsGroup(SyncGroups::kInternal));
+                }
             }
         }
         _draw_call_recorded = false;
@@ -393,19 +503,7 @@ namespace RenderEngine
             scissor.offset = { 0, 0 };
             scissor.extent = render_area.extent;
             getLogicalDevice()->vkCmdSetScissor(frame_data.command_buffer, 0, 1, &scissor);
-            auto descriptor_sets = technique->collectDescriptorSets(swap_chain_image_index);
-
-            if (descriptor_sets.empty() == false)
-            {
-                getLogicalDevice()->vkCmdBindDescriptorSets(frame_data.command_buffer,
-                                                            VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                            technique->getPipelineLayout(),
-                                                            0,
-                                                            static_cast<uint32_t>(descriptor_sets.size()),
-                                                            descriptor_sets.data(),
-                                                            0,
-                                                            nullptr);
-            }
+            technique->bindDescriptorSets(frame_data.command_buffer, swap_chain_image_index);
 
             // Draw nothing just 3 'empty' vertexes trick is in the vertex shader
             getLogicalDevice()->vkCmdDraw(frame_data.command_buffer, 3, 1, 0, 0);
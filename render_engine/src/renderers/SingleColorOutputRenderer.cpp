@@ -7,6 +7,7 @@ namespace RenderEngine
 {
     SingleColorOutputRenderer::SingleColorOutputRenderer(IWindow& window)
         : _window(window)
+        , _command_context(window.getRenderEngine().getCommandContext().clone())
     {
 
     }
@@ -98,8 +99,8 @@ namespace RenderEngine
     }
     void SingleColorOutputRenderer::createCommandBuffer()
     {
-        std::vector<VkCommandBuffer> command_buffers = _window.getRenderEngine().getCommandContext().createCommandBuffers(static_cast<uint32_t>(_back_buffer.size()),
-                                                                                                                          CommandContext::Usage::MultipleSubmit);
+        std::vector<VkCommandBuffer> command_buffers = _command_context->createCommandBuffers(static_cast<uint32_t>(_back_buffer.size()),
+                                                                                              CommandContext::Usage::MultipleSubmit);
         for (uint32_t i = 0; i < _back_buffer.size(); ++i)
         {
             _back_buffer[i].command_buffer = command_buffers[i];
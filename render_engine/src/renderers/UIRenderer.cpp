@@ -1,6 +1,7 @@
 #include <render_engine/renderers/UIRenderer.h>
 
 #include <render_engine/Device.h>
+#include <render_engine/RenderContext.h>
 #include <render_engine/resources/RenderTarget.h>
 #include <render_engine/window/Window.h>
 
@@ -263,29 +264,31 @@ namespace RenderEngine
         getLogicalDevice()->vkDestroyDescriptorPool(*getLogicalDevice(), _descriptor_pool, nullptr);
     }
 
-    void UIRenderer::draw(const VkFramebuffer& frame_buffer, FrameData& frame_data)
+    void UIRenderer::handleEvents()
     {
-        if (_on_gui == nullptr)
+        _gui_frame_built = _on_gui != nullptr && glfwGetWindowAttrib(_window_handle, GLFW_FOCUSED);
+        if (_gui_frame_built == false)
         {
             return;
         }
-        const int focused = glfwGetWindowAttrib(_window_handle, GLFW_FOCUSED);
-
-        if (focused)
+        std::unique_lock lock(getGlobals().mutex);
+        if (ImGui::GetCurrentContext() != _imgui_context)
         {
-            if (ImGui::GetCurrentContext() != _imgui_context)
-            {
-                ImGui::SetCurrentContext(_imgui_context);
-            }
+            ImGui::SetCurrentContext(_imgui_context);
+        }
+        ImGui_ImplVulkan_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+        ImGui::NewFrame();
+        _on_gui();
+        RenderContext::context().getDebugger().callGuiCallbacks();
+        ImGui::Render();
+    }
 
-            VkDevice prev_device = getGlobals().loadedDevicePrototypes.exchange(*getLogicalDevice());
-            if (prev_device != *getLogicalDevice())
-            {
-                loadVulkanPrototypes();
-            }
-            ImGui_ImplVulkan_NewFrame();
-            ImGui_ImplGlfw_NewFrame();
-            ImGui::NewFrame();
+    void UIRenderer::draw(const VkFramebuffer& frame_buffer, FrameData& frame_data)
+    {
+        if (_on_gui == nullptr)
+        {
+            return;
         }
         VkCommandBufferBeginInfo begin_info{};
         begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -308,10 +311,18 @@ namespace RenderEngine
         render_pass_info.pClearValues = &clearColor;
 
         getLogicalDevice()->vkCmdBeginRenderPass(frame_data.command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
-        if (focused)
+        if (_gui_frame_built)
         {
-            _on_gui();
-            ImGui::Render();
+            std::unique_lock lock(getGlobals().mutex);
+            if (ImGui::GetCurrentContext() != _imgui_context)
+            {
+                ImGui::SetCurrentContext(_imgui_context);
+            }
+            VkDevice prev_device = getGlobals().loadedDevicePrototypes.exchange(*getLogicalDevice());
+            if (prev_device != *getLogicalDevice())
+            {
+                loadVulkanPrototypes();
+            }
             ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), frame_data.command_buffer);
         }
         getLogicalDevice()->vkCmdEndRenderPass(frame_data.command_buffer);
@@ -9,6 +9,8 @@ namespace RenderEngine
 {
     namespace
     {
+        // Front face, back face and volume
+        constexpr uint32_t kSubpassCount = 3;
 
         class DistanceFieldFinishedCallback : public CudaCompute::IComputeCallback
         {
@@ -16,13 +18,14 @@ namespace RenderEngine
             static constexpr auto kSemaphoreName = "distance_field_ready";
             static constexpr auto kReadyValue = 2;
             static constexpr auto kProcessValue = 1;
-            explicit DistanceFieldFinishedCallback(SyncObject& sync_object)
+            DistanceFieldFinishedCallback(SyncObject& sync_object, SemaphoreId semaphore)
                 : _sync_object(sync_object)
+                , _semaphore(semaphore)
             {}
 
             void call() final
             {
-                _sync_object.signalSemaphore(kSemaphoreName, kReadyValue);
+                _sync_object.signalSemaphore(_semaphore, kReadyValue);
                 _is_called = true;
             }
             bool isCalled() const final
@@ -31,6 +34,7 @@ namespace RenderEngine
             }
         private:
             SyncObject& _sync_object;
+            SemaphoreId _semaphore;
             std::atomic_bool _is_called{ false };
         };
         /*
@@ -103,7 +107,7 @@ namespace RenderEngine
     VolumeRenderer::VolumeRenderer(IWindow& window, RenderTarget render_target, bool last_renderer)
         try : SingleColorOutputRenderer(window)
         , _render_target(render_target)
-
+        , _render_pass_steps(window.getDevice().getTransientResourcePool().reserveSteps(kSubpassCount))
     {
         std::array<VkAttachmentDescription, 3> attachments = {
             VkAttachmentDescription{},
@@ -127,7 +131,8 @@ namespace RenderEngine
             front_face_attachment.format = render_target.getImageFormat();
             front_face_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
             front_face_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-            front_face_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            // Only read as input attachment in the volume subpass
+            front_face_attachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             front_face_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
             front_face_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             front_face_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -138,13 +143,13 @@ namespace RenderEngine
             back_face_attachment.format = render_target.getImageFormat();
             back_face_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
             back_face_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-            back_face_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            back_face_attachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             back_face_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
             back_face_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             back_face_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
             back_face_attachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
         }
-        std::array<VkSubpassDescription, 3> subpass_descriptions = {
+        std::array<VkSubpassDescription, kSubpassCount> subpass_descriptions = {
             VkSubpassDescription{},
             VkSubpassDescription{},
             VkSubpassDescription{}
@@ -178,7 +183,7 @@ namespace RenderEngine
         subpass_descriptions[2].pInputAttachments = input_references.data();
         subpass_descriptions[2].pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 
-        std::array<VkSubpassDependency, 3> dependencies;
+        std::array<VkSubpassDependency, 5> dependencies;
         // This dependency transitions the input attachment from color attachment to shader read
         dependencies[0] = VkSubpassDependency{};
         dependencies[0].srcSubpass = 0;
@@ -207,6 +212,20 @@ namespace RenderEngine
         dependencies[2].dstAccessMask = VK_ACCESS_NONE;
         dependencies[2].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
+        // The memory of the front and back face attachments is aliased with the transient textures of the other render
+        // passes on the queue. These dependencies wait for every previously submitted access of the queue, whatever
+        // texture of the memory it used, before the attachments are cleared.
+        dependencies[3] = VkSubpassDependency{};
+        dependencies[3].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[3].dstSubpass = 0;
+        dependencies[3].srcStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        dependencies[3].srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        dependencies[3].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[3].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+        dependencies[4] = dependencies[3];
+        dependencies[4].dstSubpass = 1;
+
         VkRenderPassCreateInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
         renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
@@ -262,7 +281,8 @@ namespace RenderEngine
         {
             std::vector vertex_buffer = mesh->createVertexBuffer();
             mesh_buffers.vertex_buffer = gpu_resource_manager.createAttributeBuffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                                                                                    vertex_buffer.size());
+                                                                                    vertex_buffer.size(),
+                                                                                    MemorySubsystem::Volume);
             getWindow().getDevice().getStagingArea().getScheduler().upload(mesh_buffers.vertex_buffer.get(),
                                                                            std::span(vertex_buffer),
                                                                            getWindow().getRenderEngine().getCommandContext(),
@@ -272,7 +292,8 @@ namespace RenderEngine
         if (geometry.indexes.empty() == false)
         {
             mesh_buffers.index_buffer = gpu_resource_manager.createAttributeBuffer(VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                                                                                   geometry.indexes.size() * sizeof(int16_t));
+                                                                                   geometry.indexes.size() * sizeof(int16_t),
+                                                                                   MemorySubsystem::Volume);
             getWindow().getDevice().getStagingArea().getScheduler().upload(mesh_buffers.index_buffer.get(),
                                                                            std::span(geometry.indexes),
                                                                            getWindow().getRenderEngine().getCommandContext(),
@@ -320,7 +341,7 @@ namespace RenderEngine
         SyncOperations result;
         for (auto& mesh_group : _meshes_with_distance_field)
         {
-            result = result.createUnionWith(mesh_group.technique_data.synchronization_objects[image_index].getOperationsGroup(SyncGroups::kExternal));
+            result.unionWith(mesh_group.technique_data.synchronization_objects[image_index].getOperationsGroup(SyncGroups::kExternal));
         }
         return result;
     }
@@ -351,14 +372,17 @@ namespace RenderEngine
         };
         render_pass_info.clearValueCount = static_cast<uint32_t>(clearColors.size());
         render_pass_info.pClearValues = clearColors.data();
-        for (auto& mesh_group : _meshes_with_distance_field)
         {
+            // The distance fields of every mesh group are transitioned with one barrier
             ResourceStateMachine resource_state_machine{ getLogicalDevice() };
-            resource_state_machine.recordStateChange(mesh_group.technique_data.distance_field_textures[swap_chain_image_index].get(),
-                                                     mesh_group.technique_data.distance_field_textures[swap_chain_image_index]->getResourceState().clone()
-                                                     .setImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-                                                     .setPipelineStage(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)
-                                                     .setAccessFlag(VK_ACCESS_2_SHADER_SAMPLED_READ_BIT));
+            for (auto& mesh_group : _meshes_with_distance_field)
+            {
+                resource_state_machine.recordStateChange(mesh_group.technique_data.distance_field_textures[swap_chain_image_index].get(),
+                                                         mesh_group.technique_data.distance_field_textures[swap_chain_image_index]->getResourceState().clone()
+                                                         .setImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+                                                         .setPipelineStage(VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT)
+                                                         .setAccessFlag(VK_ACCESS_2_SHADER_SAMPLED_READ_BIT));
+            }
             resource_state_machine.commitChanges(frame_data.command_buffer);
         }
         getLogicalDevice()->vkCmdBeginRenderPass(frame_data.command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
@@ -417,10 +441,10 @@ namespace RenderEngine
     {
         auto& synchronization_object = mesh_group.technique_data.synchronization_objects[swap_chain_image_index];
 
-        synchronization_object.waitSemaphore(DistanceFieldFinishedCallback::kSemaphoreName,
+        synchronization_object.waitSemaphore(mesh_group.technique_data.distance_field_ready,
                                              DistanceFieldFinishedCallback::kReadyValue);
 
-        synchronization_object.stepTimeline(DistanceFieldFinishedCallback::kSemaphoreName);
+        synchronization_object.stepTimeline(mesh_group.technique_data.distance_field_ready);
 
         const auto* input_surface = mesh_group.technique_data.intensity_surface[swap_chain_image_index].get();
         const auto& intensity_image = mesh_group.technique_data.distance_field_textures[swap_chain_image_index]->getImage();
@@ -430,7 +454,8 @@ namespace RenderEngine
         task_description.depth = intensity_image.getDepth();
         task_description.input_data = input_surface->getSurface();
         task_description.output_data = mesh_group.technique_data.distance_field_surface[swap_chain_image_index]->getSurface();
-        task_description.on_finished_callback = std::make_unique<DistanceFieldFinishedCallback>(mesh_group.technique_data.synchronization_objects[swap_chain_image_index]);
+        task_description.on_finished_callback = std::make_unique<DistanceFieldFinishedCallback>(mesh_group.technique_data.synchronization_objects[swap_chain_image_index],
+                                                                                                mesh_group.technique_data.distance_field_ready);
 
         task_description.segmentation_threshold = mesh_group.technique_data.segmentation_threshold;
 
@@ -475,19 +500,7 @@ namespace RenderEngine
         scissor.offset = { 0, 0 };
         scissor.extent = render_area.extent;
         getLogicalDevice()->vkCmdSetScissor(frame_data.command_buffer, 0, 1, &scissor);
-        auto descriptor_sets = technique.collectDescriptorSets(swap_chain_image_index);
-
-        if (descriptor_sets.empty() == false)
-        {
-            getLogicalDevice()->vkCmdBindDescriptorSets(frame_data.command_buffer,
-                                                        VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                        technique.getPipelineLayout(),
-                                                        0,
-                                                        static_cast<uint32_t>(descriptor_sets.size()),
-                                                        descriptor_sets.data(),
-                                                        0,
-                                                        nullptr);
-        }
+        technique.bindDescriptorSets(material_update_context.getUniformBufferUpdater());
 
         for (auto& mesh_instance : meshes)
         {
@@ -504,29 +517,41 @@ namespace RenderEngine
         marker.finish();
     }
 
-    void VolumeRenderer::initializeFrameBuffers(uint32_t back_buffer_count, const Image& ethalon_image)
-    {
-        initializeFrameBufferData(back_buffer_count, ethalon_image, &_front_face_frame_buffer);
-        initializeFrameBufferData(back_buffer_count, ethalon_image, &_back_face_frame_buffer);
-    }
-    void VolumeRenderer::initializeFrameBufferData(uint32_t back_buffer_count, const Image& ethalon_image, FrameBufferData* frame_buffer_data)
+    void VolumeRenderer::initializeFrameBuffers(const Image& ethalon_image, uint32_t back_buffer_size)
     {
-        frame_buffer_data->textures_per_back_buffer.clear();
-        frame_buffer_data->texture_views_per_back_buffer.clear();
-
-        Texture::SamplerData sampler_data{};
-        for (uint32_t i = 0; i < back_buffer_count; ++i)
+        // The old attachments give their memory back before the new ones are created
+        _front_face_frame_buffers.clear();
+        _back_face_frame_buffers.clear();
+        _front_face_frame_buffers.resize(back_buffer_size);
+        _back_face_frame_buffers.resize(back_buffer_size);
+        for (uint32_t i = 0; i < back_buffer_size; ++i)
         {
-            frame_buffer_data->textures_per_back_buffer.push_back(getTextureFactory().createNoUpload(ethalon_image,
-                                                                                                     VK_IMAGE_ASPECT_COLOR_BIT,
-                                                                                                     VK_SHADER_STAGE_FRAGMENT_BIT,
-                                                                                                     VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT));
-            auto& texture = frame_buffer_data->textures_per_back_buffer.back();
-            auto texture_view = texture->createTextureView(Texture::ImageViewData{}, sampler_data);
-
-            frame_buffer_data->texture_views_per_back_buffer.push_back(std::move(texture_view));
+            // The front face is written in the first subpass, the back face in the second one and both are read in the last one.
+            // The attachments of the back buffers have the same steps, thus they never share a memory.
+            initializeFrameBufferData(ethalon_image,
+                                      _render_pass_steps,
+                                      &_front_face_frame_buffers[i]);
+            initializeFrameBufferData(ethalon_image,
+                                      TransientResourcePool::LiveRange{ .first_step = _render_pass_steps.first_step + 1,
+                                          .last_step = _render_pass_steps.last_step },
+                                      &_back_face_frame_buffers[i]);
         }
     }
+    void VolumeRenderer::initializeFrameBufferData(const Image& ethalon_image,
+                                                   TransientResourcePool::LiveRange live_range,
+                                                   FrameBufferData* frame_buffer_data)
+    {
+        frame_buffer_data->texture = getWindow().getDevice().getTransientResourcePool().createTexture(ethalon_image,
+                                                                                                      VK_IMAGE_ASPECT_COLOR_BIT,
+                                                                                                      VK_SHADER_STAGE_FRAGMENT_BIT,
+                                                                                                      VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+                                                                                                      | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT
+                                                                                                      | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+                                                                                                      getWindow().getRenderEngine().getCommandContext().getQueue(),
+                                                                                                      live_range,
+                                                                                                      MemorySubsystem::Volume);
+        frame_buffer_data->texture_view = frame_buffer_data->texture->createTextureView(Texture::ImageViewData{}, std::nullopt);
+    }
 
     VolumeRenderer::TechniqueData VolumeRenderer::createTechniqueDataFor(const VolumetricObjectInstance& mesh)
     {
@@ -570,12 +595,12 @@ namespace RenderEngine
             {
 
                 result.synchronization_objects.emplace_back(SyncObject::CreateEmpty(getLogicalDevice()));
-                result.synchronization_objects.back().createTimelineSemaphore(DistanceFieldFinishedCallback::kSemaphoreName,
-                                                                              DistanceFieldFinishedCallback::kReadyValue,
-                                                                              DistanceFieldFinishedCallback::kReadyValue - DistanceFieldFinishedCallback::kProcessValue + 1);
+                result.distance_field_ready = result.synchronization_objects.back().createTimelineSemaphore(DistanceFieldFinishedCallback::kSemaphoreName,
+                                                                                                            DistanceFieldFinishedCallback::kReadyValue,
+                                                                                                            DistanceFieldFinishedCallback::kReadyValue - DistanceFieldFinishedCallback::kProcessValue + 1);
 
                 result.synchronization_objects.back().addWaitOperationToGroup(SyncGroups::kExternal,
-                                                                              DistanceFieldFinishedCallback::kSemaphoreName,
+                                                                              result.distance_field_ready,
                                                                               VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
                                                                               DistanceFieldFinishedCallback::kReadyValue);
 
@@ -584,7 +609,8 @@ namespace RenderEngine
                                                                                                     VK_SHADER_STAGE_FRAGMENT_BIT,
                                                                                                     VK_IMAGE_USAGE_SAMPLED_BIT
                                                                                                     | VK_IMAGE_USAGE_TRANSFER_DST_BIT
-                                                                                                    | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
+                                                                                                    | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                                                                                    MemorySubsystem::Volume));
                 result.distance_field_texture_views.push_back(
                     result.distance_field_textures.back()->createTextureView(
                         Texture::ImageViewData{ },
@@ -630,8 +656,8 @@ namespace RenderEngine
         }
         for (uint32_t i = 0; i < back_buffer_size; ++i)
         {
-            subpass_texture_bindings[VolumeShader::MetaDataExtension::kFrontFaceTextureBinding].push_back(_front_face_frame_buffer.texture_views_per_back_buffer[i]->createReference());
-            subpass_texture_bindings[VolumeShader::MetaDataExtension::kBackFaceTextureBinding].push_back(_back_face_frame_buffer.texture_views_per_back_buffer[i]->createReference());
+            subpass_texture_bindings[VolumeShader::MetaDataExtension::kFrontFaceTextureBinding].push_back(_front_face_frame_buffers[i].texture_view->createReference());
+            subpass_texture_bindings[VolumeShader::MetaDataExtension::kBackFaceTextureBinding].push_back(_back_face_frame_buffers[i].texture_view->createReference());
             if (need_distance_field)
             {
                 additional_texture_bindings[VolumeShader::MetaDataExtension::kDistanceFieldBinding].push_back(result.distance_field_texture_views[i]->createReference());
@@ -664,14 +690,14 @@ namespace RenderEngine
         auto& gpu_resource_manager = getWindow().getRenderEngine().getGpuResourceManager();
         const uint32_t back_buffer_size = gpu_resource_manager.getBackBufferSize();
 
-        initializeFrameBuffers(back_buffer_size, render_target.getImage(0));
+        initializeFrameBuffers(render_target.getImage(0), back_buffer_size);
         std::vector<AttachmentInfo> render_pass_attachments;
         for (uint32_t i = 0; i < back_buffer_size; ++i)
         {
             AttachmentInfo attachment_info{
                 .attachments = {
-                    _front_face_frame_buffer.texture_views_per_back_buffer[i].get(),
-                    _back_face_frame_buffer.texture_views_per_back_buffer[i].get()
+                    _front_face_frame_buffers[i].texture_view.get(),
+                    _back_face_frame_buffers[i].texture_view.get()
             }
             };
             render_pass_attachments.push_back(std::move(attachment_info));
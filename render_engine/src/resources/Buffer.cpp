@@ -4,42 +4,23 @@
 #include <render_engine/TransferEngine.h>
 
 #include <cassert>
-#include <map>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 
 namespace RenderEngine
 {
     namespace
     {
-        uint32_t findMemoryType(VkPhysicalDevice physical_device, uint32_t typeFilter, VkMemoryPropertyFlags properties)
-        {
-            VkPhysicalDeviceMemoryProperties memProperties;
-            vkGetPhysicalDeviceMemoryProperties(physical_device, &memProperties);
-
-            for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
-            {
-                if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
-                {
-                    return i;
-                }
-            }
-
-            throw std::runtime_error("failed to find suitable memory type!");
-        }
-        std::pair<VkBuffer, VkDeviceMemory> createBuffer(
-            VkPhysicalDevice physical_device,
-            LogicalDevice& logical_device,
-            VkDeviceSize size,
-            VkBufferUsageFlags usage,
-            VkMemoryPropertyFlags properties)
+        std::pair<VkBuffer, DeviceMemoryAllocator::Allocation> createBuffer(LogicalDevice& logical_device,
+                                                                            DeviceMemoryAllocator& memory_allocator,
+                                                                            const BufferInfo& buffer_info)
         {
             VkBuffer buffer;
-            VkDeviceMemory buffer_memory;
             VkBufferCreateInfo bufferInfo{};
             bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            bufferInfo.size = size;
-            bufferInfo.usage = usage;
+            bufferInfo.size = buffer_info.size;
+            bufferInfo.usage = buffer_info.usage;
             bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
             if (logical_device->vkCreateBuffer(*logical_device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
@@ -47,38 +28,34 @@ namespace RenderEngine
                 throw std::runtime_error("failed to create buffer!");
             }
 
-            VkMemoryRequirements mem_requirements;
-            logical_device->vkGetBufferMemoryRequirements(*logical_device, buffer, &mem_requirements);
-
-            VkMemoryAllocateInfo allocInfo{};
-
-            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocInfo.allocationSize = mem_requirements.size;
-            allocInfo.memoryTypeIndex = findMemoryType(physical_device, mem_requirements.memoryTypeBits, properties);
-
-            if (logical_device->vkAllocateMemory(*logical_device, &allocInfo, nullptr, &buffer_memory) != VK_SUCCESS)
+            DeviceMemoryAllocator::Allocation allocation;
+            try
+            {
+                allocation = memory_allocator.allocateForBuffer(buffer,
+                                                                buffer_info.subsystem,
+                                                                buffer_info.memory_properties,
+                                                                buffer_info.preferred_memory_properties);
+            }
+            catch (const std::exception&)
             {
                 logical_device->vkDestroyBuffer(*logical_device, buffer, nullptr);
-                throw std::runtime_error("failed to allocate buffer memory!");
+                throw;
             }
 
-            logical_device->vkBindBufferMemory(*logical_device, buffer, buffer_memory, 0);
-            return { buffer, buffer_memory };
+            logical_device->vkBindBufferMemory(*logical_device, buffer, allocation.getMemory(), allocation.getOffset());
+            return { buffer, std::move(allocation) };
         }
     }
 
     Buffer::Buffer(VkPhysicalDevice physical_device,
                    LogicalDevice& logical_device,
+                   DeviceMemoryAllocator& memory_allocator,
                    BufferInfo&& buffer_info)
         : _physical_device(physical_device)
         , _logical_device(logical_device)
         , _buffer_info(std::move(buffer_info))
     {
-        std::tie(_buffer, _buffer_memory) = createBuffer(_physical_device,
-                                                         _logical_device,
-                                                         _buffer_info.size,
-                                                         _buffer_info.usage,
-                                                         _buffer_info.memory_properties);
+        std::tie(_buffer, _allocation) = createBuffer(_logical_device, memory_allocator, _buffer_info);
     }
 
     Buffer::~Buffer()
@@ -86,7 +63,7 @@ namespace RenderEngine
         assert(_ongoing_upload == nullptr || _ongoing_upload->isFinished());
         assert(_ongoing_download == nullptr || _ongoing_download->isFinished());
         _logical_device->vkDestroyBuffer(*_logical_device, _buffer, nullptr);
-        _logical_device->vkFreeMemory(*_logical_device, _buffer_memory, nullptr);
+        _allocation.release();
     }
 
     void Buffer::assignUploadTask(std::shared_ptr<UploadTask> task)
@@ -128,27 +105,54 @@ namespace RenderEngine
 
     CoherentBuffer::CoherentBuffer(VkPhysicalDevice physical_device,
                                    LogicalDevice& logical_device,
+                                   DeviceMemoryAllocator& memory_allocator,
                                    BufferInfo&& buffer_info)
         : _physical_device(physical_device)
         , _logical_device(logical_device)
         , _buffer_info(std::move(buffer_info))
     {
-        std::tie(_buffer, _buffer_memory) = createBuffer(_physical_device,
-                                                         _logical_device,
-                                                         _buffer_info.size,
-                                                         _buffer_info.usage,
-                                                         _buffer_info.memory_properties);
-        _logical_device->vkMapMemory(*_logical_device, _buffer_memory, 0, getDeviceSize(), 0, &_mapped_memory);
+        assert((_buffer_info.memory_properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && "Coherent buffer needs to be host visible");
+        std::tie(_buffer, _allocation) = createBuffer(_logical_device, memory_allocator, _buffer_info);
+        _host_coherent = (_allocation.getMemoryProperties() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+        if (_host_coherent == false)
+        {
+            VkPhysicalDeviceProperties properties{};
+            vkGetPhysicalDeviceProperties(_physical_device, &properties);
+            _non_coherent_atom_size = properties.limits.nonCoherentAtomSize;
+        }
+        // The allocator keeps the host visible memory mapped
+        _mapped_memory = _allocation.getMappedMemory();
     }
 
     CoherentBuffer::~CoherentBuffer()
     {
         _logical_device->vkDestroyBuffer(*_logical_device, _buffer, nullptr);
-        _logical_device->vkFreeMemory(*_logical_device, _buffer_memory, nullptr);
+        _allocation.release();
     }
 
     void CoherentBuffer::upload(std::span<const uint8_t> data_view)
     {
         memcpy(_mapped_memory, data_view.data(), data_view.size());
     }
+
+    void CoherentBuffer::invalidate(VkDeviceSize offset, VkDeviceSize size)
+    {
+        if (_host_coherent)
+        {
+            return;
+        }
+        assert(offset % _non_coherent_atom_size == 0 && "The invalidated range needs to start at a non coherent atom boundary");
+        VkMappedMemoryRange range{};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = _allocation.getMemory();
+        // The allocator aligns the non coherent allocations to the atom size
+        range.offset = _allocation.getOffset() + offset;
+        // The size needs to be a multiple of the atom size unless the range ends at the end of the memory
+        const VkDeviceSize aligned_size = (size + _non_coherent_atom_size - 1) / _non_coherent_atom_size * _non_coherent_atom_size;
+        range.size = offset + aligned_size <= _allocation.getSize() ? aligned_size : VK_WHOLE_SIZE;
+        if (_logical_device->vkInvalidateMappedMemoryRanges(*_logical_device, 1, &range) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to invalidate mapped memory!");
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include <render_engine/resources/DescriptorAllocator.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace RenderEngine
+{
+    namespace
+    {
+        constexpr uint32_t kInitialPoolSize = 64;
+        constexpr uint32_t kMaxPoolSize = 4096;
+
+        struct PoolSizeRatio
+        {
+            VkDescriptorType type;
+            uint32_t descriptors_per_set;
+        };
+        // Every descriptor type the resource sets use
+        constexpr std::array kPoolSizeRatios = {
+            PoolSizeRatio{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2 },
+            PoolSizeRatio{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 },
+            PoolSizeRatio{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 },
+            PoolSizeRatio{ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1 }
+        };
+    }
+
+    DescriptorAllocator::DescriptorSets::~DescriptorSets()
+    {
+        release();
+    }
+
+    DescriptorAllocator::DescriptorSets::DescriptorSets(DescriptorSets&& o) noexcept
+    {
+        *this = std::move(o);
+    }
+
+    DescriptorAllocator::DescriptorSets& DescriptorAllocator::DescriptorSets::operator=(DescriptorSets&& o) noexcept
+    {
+        if (this != &o)
+        {
+            release();
+            _allocator = std::exchange(o._allocator, nullptr);
+            _pool = std::exchange(o._pool, nullptr);
+            _sets = std::move(o._sets);
+            o._sets.clear();
+        }
+        return *this;
+    }
+
+    void DescriptorAllocator::DescriptorSets::release() noexcept
+    {
+        if (_allocator == nullptr)
+        {
+            return;
+        }
+        _allocator->free(*this);
+        _allocator = nullptr;
+        _pool = nullptr;
+        _sets.clear();
+    }
+
+    DescriptorAllocator::DescriptorAllocator(LogicalDevice& logical_device, uint32_t back_buffer_size)
+        : _logical_device(logical_device)
+        , _transient_pools(back_buffer_size)
+        , _next_pool_size(kInitialPoolSize)
+    {}
+
+    DescriptorAllocator::~DescriptorAllocator()
+    {
+        for (const auto& pool : _pools)
+        {
+            assert(pool->live_set_count == 0 && "Descriptor sets outlive their allocator");
+            _logical_device->vkDestroyDescriptorPool(*_logical_device, pool->descriptor_pool, nullptr);
+        }
+    }
+
+    DescriptorAllocator::DescriptorSets DescriptorAllocator::allocate(std::span<const VkDescriptorSetLayout> layouts)
+    {
+        DescriptorSets result;
+        if (layouts.empty())
+        {
+            return result;
+        }
+        result._sets.resize(layouts.size());
+
+        std::unique_lock lock(_mutex);
+        if (_current_pool == nullptr || tryAllocate(*_current_pool, layouts, result._sets.data()) == false)
+        {
+            if (_current_pool != nullptr && _current_pool->live_set_count == 0)
+            {
+                _free_pools.push_back(_current_pool);
+            }
+            _current_pool = acquirePool(static_cast<uint32_t>(layouts.size()));
+            if (tryAllocate(*_current_pool, layouts, result._sets.data()) == false)
+            {
+                throw std::runtime_error("failed to allocate descriptor sets!");
+            }
+        }
+        _current_pool->live_set_count += static_cast<uint32_t>(layouts.size());
+        result._allocator = this;
+        result._pool = _current_pool;
+        return result;
+    }
+
+    VkDescriptorSet DescriptorAllocator::allocateTransient(VkDescriptorSetLayout layout, uint32_t back_buffer_index)
+    {
+        VkDescriptorSet result{ VK_NULL_HANDLE };
+
+        std::unique_lock lock(_mutex);
+        TransientPools& transient_pools = _transient_pools[back_buffer_index];
+        if (transient_pools.pools.empty() || tryAllocate(*transient_pools.pools.back(), { &layout, 1 }, &result) == false)
+        {
+            transient_pools.pools.push_back(acquirePool(1));
+            if (tryAllocate(*transient_pools.pools.back(), { &layout, 1 }, &result) == false)
+            {
+                throw std::runtime_error("failed to allocate transient descriptor set!");
+            }
+        }
+        transient_pools.set_count++;
+        return result;
+    }
+
+    void DescriptorAllocator::onFrameBegin(uint32_t back_buffer_index)
+    {
+        std::unique_lock lock(_mutex);
+        TransientPools& transient_pools = _transient_pools[back_buffer_index];
+        for (Pool* pool : transient_pools.pools)
+        {
+            resetPool(*pool);
+            _free_pools.push_back(pool);
+        }
+        transient_pools.pools.clear();
+        transient_pools.set_count = 0;
+    }
+
+    DescriptorAllocator::Statistics DescriptorAllocator::getStatistics() const
+    {
+        std::unique_lock lock(_mutex);
+        Statistics result{ .pool_count = static_cast<uint32_t>(_pools.size()),
+            .free_pool_count = static_cast<uint32_t>(_free_pools.size()) };
+        for (const auto& pool : _pools)
+        {
+            result.live_set_count += pool->live_set_count;
+            result.set_capacity += pool->max_sets;
+        }
+        for (const TransientPools& transient_pools : _transient_pools)
+        {
+            result.transient_pool_count += static_cast<uint32_t>(transient_pools.pools.size());
+            result.transient_set_count += transient_pools.set_count;
+        }
+        return result;
+    }
+
+    DescriptorAllocator::Pool* DescriptorAllocator::createPool(uint32_t min_set_count)
+    {
+        auto pool = std::make_unique<Pool>();
+        pool->max_sets = std::max(_next_pool_size, min_set_count);
+        _next_pool_size = std::min(_next_pool_size * 2, kMaxPoolSize);
+
+        std::array<VkDescriptorPoolSize, kPoolSizeRatios.size()> pool_sizes;
+        std::ranges::transform(kPoolSizeRatios, pool_sizes.begin(),
+                               [&](const PoolSizeRatio& ratio)
+                               {
+                                   return VkDescriptorPoolSize{ .type = ratio.type,
+                                       .descriptorCount = ratio.descriptors_per_set * pool->max_sets };
+                               });
+
+        VkDescriptorPoolCreateInfo pool_info{};
+        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+        pool_info.pPoolSizes = pool_sizes.data();
+        pool_info.maxSets = pool->max_sets;
+
+        if (_logical_device->vkCreateDescriptorPool(*_logical_device, &pool_info, nullptr, &pool->descriptor_pool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create descriptor pool!");
+        }
+        _pools.push_back(std::move(pool));
+        return _pools.back().get();
+    }
+
+    DescriptorAllocator::Pool* DescriptorAllocator::acquirePool(uint32_t min_set_count)
+    {
+        auto it = std::ranges::find_if(_free_pools, [&](const Pool* pool) { return pool->max_sets >= min_set_count; });
+        if (it == _free_pools.end())
+        {
+            return createPool(min_set_count);
+        }
+        Pool* result = *it;
+        _free_pools.erase(it);
+        return result;
+    }
+
+    bool DescriptorAllocator::tryAllocate(Pool& pool, std::span<const VkDescriptorSetLayout> layouts, VkDescriptorSet* descriptor_sets)
+    {
+        VkDescriptorSetAllocateInfo alloc_info{};
+        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        alloc_info.descriptorPool = pool.descriptor_pool;
+        alloc_info.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+        alloc_info.pSetLayouts = layouts.data();
+
+        switch (_logical_device->vkAllocateDescriptorSets(*_logical_device, &alloc_info, descriptor_sets))
+        {
+            case VK_SUCCESS:
+                return true;
+            case VK_ERROR_OUT_OF_POOL_MEMORY:
+            case VK_ERROR_FRAGMENTED_POOL:
+                return false;
+            default:
+                throw std::runtime_error("failed to allocate descriptor sets!");
+        }
+    }
+
+    void DescriptorAllocator::resetPool(Pool& pool)
+    {
+        _logical_device->vkResetDescriptorPool(*_logical_device, pool.descriptor_pool, 0);
+        pool.live_set_count = 0;
+    }
+
+    void DescriptorAllocator::free(DescriptorSets& descriptor_sets) noexcept
+    {
+        std::unique_lock lock(_mutex);
+        Pool& pool = *descriptor_sets._pool;
+        assert(pool.live_set_count >= descriptor_sets._sets.size() && "Descriptor sets are released twice");
+        pool.live_set_count -= static_cast<uint32_t>(descriptor_sets._sets.size());
+        if (pool.live_set_count > 0)
+        {
+            return;
+        }
+        // Sets cannot be freed one by one, the pool is reused when all of its sets are released
+        resetPool(pool);
+        if (&pool != _current_pool)
+        {
+            _free_pools.push_back(&pool);
+        }
+    }
+}
@@ -9,7 +9,19 @@ namespace RenderEngine
         {
             BackBuffer<UniformBinding::FrameData> back_buffer;
             int32_t binding{ -1 };
+            VkDeviceSize dynamic_uniform_size{ 0 };
         };
+
+        // Uniform buffers that are updated by the frames are sub-allocated from the uniform ring buffer
+        bool isDynamicUniformBuffer(const Shader::MetaData::UniformBuffer& buffer)
+        {
+            return buffer.update_frequency == Shader::MetaData::UpdateFrequency::PerFrame
+                || buffer.update_frequency == Shader::MetaData::UpdateFrequency::PerDrawCall;
+        }
+        VkDescriptorType getUniformBufferDescriptorType(const Shader::MetaData::UniformBuffer& buffer)
+        {
+            return isDynamicUniformBuffer(buffer) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        }
     }
     GpuResourceSet::GpuResourceSet(GpuResourceManager& gpu_resource_manager,
                                    const std::vector<TextureAssignment::BindingSlot>& binding_slots)
@@ -20,7 +32,6 @@ namespace RenderEngine
             return;
         }
         uint32_t back_buffer_size = gpu_resource_manager.getBackBufferSize();
-        auto descriptor_pool = gpu_resource_manager.getDescriptorPool();
         // Create resources' layout
         const uint32_t num_of_bindings = static_cast<uint32_t>(binding_slots.size());
 
@@ -36,7 +47,7 @@ namespace RenderEngine
             set_layout_binding.descriptorType =
                 std::visit(overloaded{
                     [](const Shader::MetaData::Sampler&) { return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; },
-                    [](const Shader::MetaData::UniformBuffer&) { return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; },
+                    [](const Shader::MetaData::UniformBuffer& buffer) { return getUniformBufferDescriptorType(buffer); },
                     [](const Shader::MetaData::InputAttachment&) { return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT; },
                            }, slot.data);
             set_layout_binding.binding = slot.binding;
@@ -57,19 +68,16 @@ namespace RenderEngine
         std::vector<VkDescriptorSetLayout> layouts(back_buffer_size, _resource_layout);
         std::vector<UniformCreationData> uniform_buffer_creation_data{};
 
-        VkDescriptorSetAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        alloc_info.descriptorPool = descriptor_pool;
-        alloc_info.descriptorSetCount = static_cast<uint32_t>(back_buffer_size);
-        alloc_info.pSetLayouts = layouts.data();
-
-        std::vector<VkDescriptorSet> descriptor_sets;
-        descriptor_sets.resize(back_buffer_size);
-        if (getLogicalDevice()->vkAllocateDescriptorSets(*getLogicalDevice(), &alloc_info, descriptor_sets.data()) != VK_SUCCESS)
+        try
+        {
+            _descriptor_sets = gpu_resource_manager.getDescriptorAllocator().allocate(layouts);
+        }
+        catch (const std::exception&)
         {
             getLogicalDevice()->vkDestroyDescriptorSetLayout(*getLogicalDevice(), _resource_layout, nullptr);
-            throw std::runtime_error("failed to allocate descriptor sets!");
+            throw;
         }
+        const std::vector<VkDescriptorSet>& descriptor_sets = _descriptor_sets.getSets();
         std::vector<VkWriteDescriptorSet> descriptor_writers;
         std::list<VkDescriptorImageInfo> image_info_holder;
         std::list<VkDescriptorBufferInfo> buffer_info_holder;
@@ -77,6 +85,7 @@ namespace RenderEngine
         for (const TextureAssignment::BindingSlot& slot : binding_slots)
         {
             BackBuffer<UniformBinding::FrameData> back_buffer(back_buffer_size);
+            VkDeviceSize dynamic_uniform_size{ 0 };
 
             for (size_t i = 0; i < back_buffer_size; ++i)
             {
@@ -106,20 +115,28 @@ namespace RenderEngine
                     },
                     [&](const Shader::MetaData::UniformBuffer& buffer)
                     {
-                        back_buffer[i].coherent_buffer = gpu_resource_manager.createUniformBuffer(buffer.size);
+                        VkDescriptorBufferInfo buffer_info{};
+                        if (isDynamicUniformBuffer(buffer))
                         {
-                            VkDescriptorBufferInfo buffer_info{};
+                            // The offset of the frame's data is given when the set is bound
+                            dynamic_uniform_size = buffer.size;
+                            buffer_info.buffer = gpu_resource_manager.getUniformRingBuffer().getBuffer(static_cast<uint32_t>(i));
+                        }
+                        else
+                        {
+                            back_buffer[i].coherent_buffer = gpu_resource_manager.createUniformBuffer(buffer.size);
                             buffer_info.buffer = back_buffer[i].coherent_buffer->getBuffer();
-                            buffer_info.offset = 0;
-                            buffer_info.range = buffer.size;
-                            buffer_info_holder.push_back(buffer_info);
                         }
+                        buffer_info.offset = 0;
+                        buffer_info.range = buffer.size;
+                        buffer_info_holder.push_back(buffer_info);
+
                         VkWriteDescriptorSet writer{};
                         writer.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
                         writer.dstSet = descriptor_sets[i];
                         writer.dstBinding = slot.binding;
                         writer.dstArrayElement = 0;
-                        writer.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                        writer.descriptorType = getUniformBufferDescriptorType(buffer);
                         writer.descriptorCount = 1;
                         writer.pBufferInfo = &buffer_info_holder.back();
 
@@ -148,18 +165,19 @@ namespace RenderEngine
                     }
                            }, slot.data);
             }
-            uniform_buffer_creation_data.emplace_back(std::move(back_buffer), slot.binding);
+            uniform_buffer_creation_data.emplace_back(std::move(back_buffer), slot.binding, dynamic_uniform_size);
         }
         getLogicalDevice()->vkUpdateDescriptorSets(*getLogicalDevice(),
                                                    static_cast<uint32_t>(descriptor_writers.size()),
                                                    descriptor_writers.data(),
                                                    0,
                                                    nullptr);
-        for (auto& [created_back_buffer, binding] : uniform_buffer_creation_data)
+        for (auto& [created_back_buffer, binding, dynamic_uniform_size] : uniform_buffer_creation_data)
         {
             _resources.emplace_back(std::make_unique<UniformBinding>(std::move(created_back_buffer),
                                                                      binding,
-                                                                     gpu_resource_manager.getLogicalDevice()));
+                                                                     gpu_resource_manager.getLogicalDevice(),
+                                                                     dynamic_uniform_size));
         }
     }
     GpuResourceSet::~GpuResourceSet()
@@ -4,6 +4,15 @@ namespace RenderEngine
 {
     void PushConstantsUpdater::update(VkShaderStageFlags shader_stages, uint32_t offset, std::span<const uint8_t> data)
     {
+        if (_command_buffer == VK_NULL_HANDLE)
+        {
+            _kept_updates.push_back(KeptUpdate{ .shader_stages = shader_stages,
+                                                .offset = offset,
+                                                .data_offset = static_cast<uint32_t>(_kept_data.size()),
+                                                .data_size = static_cast<uint32_t>(data.size()) });
+            _kept_data.insert(_kept_data.end(), data.begin(), data.end());
+            return;
+        }
         _logical_device->vkCmdPushConstants(_command_buffer,
                                             _layout,
                                             shader_stages,
@@ -11,4 +20,16 @@ namespace RenderEngine
                                             static_cast<uint32_t>(data.size()),
                                             data.data());
     }
-}
\ No newline at end of file
+
+    PushConstantsUpdater PushConstantsUpdater::continueOn(VkCommandBuffer command_buffer) const
+    {
+        PushConstantsUpdater result(_logical_device, command_buffer, _layout);
+        for (const KeptUpdate& kept_update : _kept_updates)
+        {
+            result.update(kept_update.shader_stages,
+                          kept_update.offset,
+                          std::span(_kept_data).subspan(kept_update.data_offset, kept_update.data_size));
+        }
+        return result;
+    }
+}
@@ -2,9 +2,15 @@
 
 #include <render_engine/resources/ShaderModule.h>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <iterator>
+
 namespace RenderEngine
 {
     Technique::Technique(LogicalDevice& logical_device,
+                         UniformRingBuffer& uniform_ring_buffer,
                          const MaterialInstance* material_instance,
                          TextureBindingMap&& subpass_textures,
                          GpuResourceSet&& constant_resources,
@@ -17,9 +23,35 @@ namespace RenderEngine
         , _constant_resources(std::move(constant_resources))
         , _per_frame_resources(std::move(per_frame_resources))
         , _per_draw_call_resources(std::move(per_draw_call_resources))
+        , _uniform_ring_buffer(uniform_ring_buffer)
         , _logical_device(logical_device)
         , _corresponding_subpass(corresponding_subpass)
     {
+        for (const GpuResourceSet* resource_set : { &_per_frame_resources, &_per_draw_call_resources })
+        {
+            const std::vector<UniformBinding*> resources = resource_set->getResources();
+            if (resources.empty())
+            {
+                continue;
+            }
+            _uniform_bindings.insert(_uniform_bindings.end(), resources.begin(), resources.end());
+
+            std::vector<UniformBinding*> dynamic_bindings;
+            std::ranges::copy_if(resources, std::back_inserter(dynamic_bindings), &UniformBinding::isDynamicUniform);
+            std::ranges::sort(dynamic_bindings, {}, &UniformBinding::getBinding);
+            _dynamic_uniform_bindings.insert(_dynamic_uniform_bindings.end(), dynamic_bindings.begin(), dynamic_bindings.end());
+
+            const std::vector<VkDescriptorSet>& descriptor_sets = resource_set->getDescriptorSets();
+            _descriptor_sets.resize(descriptor_sets.size());
+            for (size_t i = 0; i < descriptor_sets.size(); ++i)
+            {
+                _descriptor_sets[i].push_back(descriptor_sets[i]);
+            }
+        }
+        if (_dynamic_uniform_bindings.size() > UniformBufferUpdater::kMaxDynamicBindings)
+        {
+            throw std::runtime_error("Too many per frame and per draw call uniform buffers in a technique");
+        }
         const auto& material = _material_instance->getMaterial();
         auto vertex_shader = material.getVertexShader().loadOn(logical_device);
         auto fragment_shader = material.getFragmentShader().loadOn(logical_device);
@@ -201,6 +233,39 @@ namespace RenderEngine
 
     }
 
+    void Technique::bindDescriptorSets(VkCommandBuffer command_buffer, uint32_t frame_number)
+    {
+        const std::array<uint32_t, UniformBufferUpdater::kMaxDynamicBindings> dynamic_offsets{};
+        bindDescriptorSets(command_buffer, frame_number, std::span(dynamic_offsets).first(_dynamic_uniform_bindings.size()));
+    }
+
+    void Technique::bindDescriptorSets(const UniformBufferUpdater& uniform_buffer_updater)
+    {
+        bindDescriptorSets(uniform_buffer_updater.getCommandBuffer(),
+                           uniform_buffer_updater.getFrameNumber(),
+                           uniform_buffer_updater.getDynamicOffsets());
+    }
+
+    void Technique::bindDescriptorSets(VkCommandBuffer command_buffer,
+                                       uint32_t frame_number,
+                                       std::span<const uint32_t> dynamic_offsets)
+    {
+        const std::span<const VkDescriptorSet> descriptor_sets = getDescriptorSets(frame_number);
+        if (descriptor_sets.empty())
+        {
+            return;
+        }
+        assert(dynamic_offsets.size() == _dynamic_uniform_bindings.size() && "Every dynamic uniform buffer needs an offset");
+        _logical_device->vkCmdBindDescriptorSets(command_buffer,
+                                                 VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                                 _pipeline_layout,
+                                                 0,
+                                                 static_cast<uint32_t>(descriptor_sets.size()),
+                                                 descriptor_sets.data(),
+                                                 static_cast<uint32_t>(_dynamic_uniform_bindings.size()),
+                                                 dynamic_offsets.data());
+    }
+
     VkShaderStageFlags Technique::getPushConstantsUsageFlag() const
     {
         VkShaderStageFlags result{ 0 };
@@ -10,26 +10,9 @@ namespace RenderEngine
 {
     namespace
     {
-        uint32_t findMemoryType(VkPhysicalDevice physical_device, uint32_t typeFilter, VkMemoryPropertyFlags properties)
-        {
-            VkPhysicalDeviceMemoryProperties memProperties;
-            vkGetPhysicalDeviceMemoryProperties(physical_device, &memProperties);
-
-            for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
-            {
-                if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
-                {
-                    return i;
-                }
-            }
-
-            throw std::runtime_error("failed to find suitable memory type!");
-        }
-
         // TODO fixed values for now
         constexpr uint32_t kMipLevel = 1;
         constexpr uint32_t kArrayLayers = 1;
-        constexpr uint32_t kLayerCount = 1;
     }
 
     bool Texture::isImageCompatible(const Image& image) const
@@ -42,14 +25,16 @@ namespace RenderEngine
     Texture::Texture(Image image,
                      VkPhysicalDevice physical_device,
                      LogicalDevice& logical_device,
+                     DeviceMemoryAllocator& memory_allocator,
                      VkImageAspectFlags aspect,
                      VkShaderStageFlags shader_usage,
                      std::set<uint32_t> compatible_queue_family_indexes,
                      VkImageUsageFlags image_usage,
-                     bool support_external_usage)
+                     bool support_external_usage,
+                     bool allocate_memory,
+                     MemorySubsystem subsystem)
         try : _physical_device(physical_device)
         , _logical_device(logical_device)
-        , _staging_buffer(physical_device, logical_device, image.createBufferInfo())
         , _image(std::move(image))
         , _aspect(aspect)
         , _shader_usage(shader_usage)
@@ -69,9 +54,14 @@ namespace RenderEngine
         image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED; // TODO add initial layout for opimization
         image_info.imageType = _image.is3D() ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
         image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
-        image_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT // for download
-            | VK_BUFFER_USAGE_TRANSFER_DST_BIT // for upload
-            | image_usage;
+        image_info.usage = image_usage;
+        // Transient attachments only live inside a render pass, they cannot be copied
+        const bool transient_attachment = image_usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        if (transient_attachment == false)
+        {
+            image_info.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT // for download
+                | VK_IMAGE_USAGE_TRANSFER_DST_BIT; // for upload
+        }
         image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         image_info.samples = VK_SAMPLE_COUNT_1_BIT;
         image_info.queueFamilyIndexCount = static_cast<uint32_t>(queue_family_indices.size());
@@ -85,7 +75,9 @@ namespace RenderEngine
             image_info.pNext = &external_create_info;
         }
 
-        _texture_state.layout = image_info.initialLayout;
+        _mip_level_count = image_info.mipLevels;
+        _array_layer_count = image_info.arrayLayers;
+        _subresource_states.assign(_mip_level_count * _array_layer_count, TextureState{ .layout = image_info.initialLayout });
 
         if (_logical_device->vkCreateImage(*_logical_device, &image_info, nullptr, &_texture) != VK_SUCCESS)
         {
@@ -93,24 +85,23 @@ namespace RenderEngine
         }
 
         _logical_device->vkGetImageMemoryRequirements(*_logical_device, _texture, &_memory_requirements);
+        if (allocate_memory == false)
+        {
+            return;
+        }
 
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = _memory_requirements.size;
-        alloc_info.memoryTypeIndex = findMemoryType(_physical_device, _memory_requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
         VkExportMemoryAllocateInfo export_alloc_info{};
-
         if (support_external_usage)
         {
             export_alloc_info.sType = VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO;
             export_alloc_info.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
-            alloc_info.pNext = &export_alloc_info;
-        }
-        if (_logical_device->vkAllocateMemory(*_logical_device, &alloc_info, nullptr, &_texture_memory) != VK_SUCCESS)
-        {
-            throw std::runtime_error("Cannot allocate memory for image");
         }
-        _logical_device->vkBindImageMemory(*_logical_device, _texture, _texture_memory, 0);
+        _allocation = memory_allocator.allocateForImage(_texture,
+                                                        subsystem,
+                                                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                        transient_attachment ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : 0,
+                                                        support_external_usage ? &export_alloc_info : nullptr);
+        _logical_device->vkBindImageMemory(*_logical_device, _texture, _allocation.getMemory(), _allocation.getOffset());
     }
     catch (const std::exception&)
     {
@@ -125,21 +116,24 @@ namespace RenderEngine
         : _physical_device(physical_device)
         , _logical_device(logical_device)
         , _texture(texture)
-        , _staging_buffer(physical_device, logical_device, image.createBufferInfo())
         , _image(std::move(image))
         , _aspect(aspect)
         , _vkimage_owner(false)
+        , _subresource_states(1)
     {
         _logical_device->vkGetImageMemoryRequirements(*_logical_device, _texture, &_memory_requirements);
     }
 
     void Texture::setInitialCommandContext(std::weak_ptr<CommandContext> command_context)
     {
-        if (_texture_state.command_context.expired() == false)
+        for (TextureState& state : _subresource_states)
         {
-            throw std::runtime_error("Texture has a command context which shouldn't be overwritten");
+            if (state.command_context.expired() == false)
+            {
+                throw std::runtime_error("Texture has a command context which shouldn't be overwritten");
+            }
+            state.command_context = command_context;
         }
-        _texture_state.command_context = command_context;
     }
 
     std::shared_ptr<DownloadTask> Texture::clearDownloadTask()
@@ -155,11 +149,25 @@ namespace RenderEngine
         result.aspectMask = _aspect;
         result.baseMipLevel = 0;
         result.baseArrayLayer = 0;
-        result.layerCount = kLayerCount;
-        result.levelCount = 1;
+        result.layerCount = _array_layer_count;
+        result.levelCount = _mip_level_count;
         return result;
     }
 
+    void Texture::overrideResourceState(TextureState value, const VkImageSubresourceRange& range, ResourceAccessToken)
+    {
+        assert(range.baseMipLevel + range.levelCount <= _mip_level_count
+               && range.baseArrayLayer + range.layerCount <= _array_layer_count
+               && "Subresource range is out of the texture");
+        for (uint32_t mip_level = range.baseMipLevel; mip_level < range.baseMipLevel + range.levelCount; ++mip_level)
+        {
+            for (uint32_t array_layer = range.baseArrayLayer; array_layer < range.baseArrayLayer + range.layerCount; ++array_layer)
+            {
+                _subresource_states[getSubresourceIndex(mip_level, array_layer)] = value;
+            }
+        }
+    }
+
     VkImageView Texture::createImageView(const ImageViewData&)
     {
         VkImageViewCreateInfo create_info{};
@@ -223,8 +231,8 @@ namespace RenderEngine
     {
         if (_vkimage_owner)
         {
-            _logical_device->vkFreeMemory(*_logical_device, _texture_memory, nullptr);
             _logical_device->vkDestroyImage(*_logical_device, _texture, nullptr);
+            _allocation.release();
         }
     }
 
@@ -234,7 +242,7 @@ namespace RenderEngine
 
         VkMemoryGetWin32HandleInfoKHR memory_handle_info{};
         memory_handle_info.sType = VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR;
-        memory_handle_info.memory = _texture_memory;
+        memory_handle_info.memory = _allocation.getMemory();
         memory_handle_info.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
 
         assert(_logical_device->vkGetMemoryWin32HandleKHR != nullptr);
@@ -286,18 +294,23 @@ namespace RenderEngine
                                                     const SyncOperations& sync_operations,
                                                     CommandContext* dst_context,
                                                     VkImageUsageFlagBits image_usage,
-                                                    TextureState final_state)
+                                                    TextureState final_state,
+                                                    MemorySubsystem subsystem)
     {
         constexpr bool support_external_usage = false;
+        constexpr bool allocate_memory = true;
         std::unique_ptr<Texture> result{ new Texture(image,
             _physical_device, _logical_device,
+            _memory_allocator,
             aspect,
             shader_usage,
             _compatible_queue_family_indexes,
             image_usage,
-            support_external_usage) };
+            support_external_usage,
+            allocate_memory,
+            subsystem) };
         _data_transfer_scheduler.upload(result.get(),
-                                        std::move(image),
+                                        image,
                                         *dst_context,
                                         final_state,
                                         sync_operations);
@@ -310,18 +323,23 @@ namespace RenderEngine
                                                             const SyncOperations& sync_operations,
                                                             CommandContext* dst_context,
                                                             VkImageUsageFlagBits image_usage,
-                                                            TextureState final_state)
+                                                            TextureState final_state,
+                                                            MemorySubsystem subsystem)
     {
         constexpr bool support_external_usage = true;
+        constexpr bool allocate_memory = true;
         std::unique_ptr<Texture> result{ new Texture(image,
             _physical_device, _logical_device,
+            _memory_allocator,
             aspect,
             shader_usage,
             _compatible_queue_family_indexes,
             image_usage,
-            support_external_usage) };
+            support_external_usage,
+            allocate_memory,
+            subsystem) };
         _data_transfer_scheduler.upload(result.get(),
-                                        std::move(image),
+                                        image,
                                         *dst_context,
                                         final_state,
                                         sync_operations);
@@ -331,34 +349,65 @@ namespace RenderEngine
     std::unique_ptr<Texture> TextureFactory::createNoUpload(Image image,
                                                             VkImageAspectFlags aspect,
                                                             VkShaderStageFlags shader_usage,
-                                                            VkImageUsageFlags image_usage)
+                                                            VkImageUsageFlags image_usage,
+                                                            MemorySubsystem subsystem)
     {
         constexpr bool support_external_usage = false;
+        constexpr bool allocate_memory = true;
 
         std::unique_ptr<Texture> result{ new Texture(image,
             _physical_device, _logical_device,
+            _memory_allocator,
             aspect,
             shader_usage,
             _compatible_queue_family_indexes,
             image_usage,
-            support_external_usage) };
+            support_external_usage,
+            allocate_memory,
+            subsystem) };
         return result;
     }
 
     std::unique_ptr<Texture> TextureFactory::createExternalNoUpload(Image image,
                                                                     VkImageAspectFlags aspect,
                                                                     VkShaderStageFlags shader_usage,
-                                                                    VkImageUsageFlags image_usage)
+                                                                    VkImageUsageFlags image_usage,
+                                                                    MemorySubsystem subsystem)
     {
         constexpr bool support_external_usage = true;
+        constexpr bool allocate_memory = true;
+
+        std::unique_ptr<Texture> result{ new Texture(image,
+            _physical_device, _logical_device,
+            _memory_allocator,
+            aspect,
+            shader_usage,
+            _compatible_queue_family_indexes,
+            image_usage,
+            support_external_usage,
+            allocate_memory,
+            subsystem) };
+        return result;
+    }
+
+    std::unique_ptr<Texture> TextureFactory::createWithoutMemory(Image image,
+                                                                 VkImageAspectFlags aspect,
+                                                                 VkShaderStageFlags shader_usage,
+                                                                 VkImageUsageFlags image_usage)
+    {
+        constexpr bool support_external_usage = false;
+        constexpr bool allocate_memory = false;
 
         std::unique_ptr<Texture> result{ new Texture(image,
             _physical_device, _logical_device,
+            _memory_allocator,
             aspect,
             shader_usage,
             _compatible_queue_family_indexes,
             image_usage,
-            support_external_usage) };
+            support_external_usage,
+            allocate_memory,
+            MemorySubsystem::Renderer) };
         return result;
     }
 
@@ -0,0 +1,27 @@
+#include <render_engine/resources/UniformBufferUpdater.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace RenderEngine
+{
+    void UniformBufferUpdater::update(int32_t binding, std::span<const uint8_t> data)
+    {
+        auto it = std::ranges::find(_dynamic_bindings, binding, &UniformBinding::getBinding);
+        if (it == _dynamic_bindings.end())
+        {
+            throw std::runtime_error("Binding is not a per frame or per draw call uniform buffer");
+        }
+        UniformBinding& uniform_binding = **it;
+        assert(data.size() <= uniform_binding.getDynamicUniformSize() && "Uniform data is larger than the uniform buffer");
+
+        // The whole range of the descriptor is allocated, the shader can read it even if only a part is updated
+        UniformRingBuffer::Allocation allocation = _uniform_ring_buffer->allocate(_frame_number, uniform_binding.getDynamicUniformSize());
+        std::memcpy(allocation.memory, data.data(), data.size());
+        _dynamic_offsets[std::distance(_dynamic_bindings.begin(), it)] = allocation.offset;
+        _changed = true;
+    }
+}
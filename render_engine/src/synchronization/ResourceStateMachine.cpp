@@ -3,14 +3,80 @@
 #include <render_engine/resources/Buffer.h>
 #include <render_engine/resources/Texture.h>
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 namespace RenderEngine
 {
+    namespace
+    {
+        bool isSameRange(const VkImageSubresourceRange& lhs, const VkImageSubresourceRange& rhs)
+        {
+            return lhs.aspectMask == rhs.aspectMask
+                && lhs.baseMipLevel == rhs.baseMipLevel
+                && lhs.levelCount == rhs.levelCount
+                && lhs.baseArrayLayer == rhs.baseArrayLayer
+                && lhs.layerCount == rhs.layerCount;
+        }
+
+        bool areRangesOverlapping(const VkImageSubresourceRange& lhs, const VkImageSubresourceRange& rhs)
+        {
+            auto overlaps = [](uint32_t lhs_base, uint32_t lhs_count, uint32_t rhs_base, uint32_t rhs_count)
+                {
+                    return lhs_base < rhs_base + rhs_count && rhs_base < lhs_base + lhs_count;
+                };
+            return (lhs.aspectMask & rhs.aspectMask) != 0
+                && overlaps(lhs.baseMipLevel, lhs.levelCount, rhs.baseMipLevel, rhs.levelCount)
+                && overlaps(lhs.baseArrayLayer, lhs.layerCount, rhs.baseArrayLayer, rhs.layerCount);
+        }
+
+        bool haveSameTransition(const VkImageMemoryBarrier2& lhs, const VkImageMemoryBarrier2& rhs)
+        {
+            return lhs.image == rhs.image
+                && lhs.srcStageMask == rhs.srcStageMask
+                && lhs.srcAccessMask == rhs.srcAccessMask
+                && lhs.dstStageMask == rhs.dstStageMask
+                && lhs.dstAccessMask == rhs.dstAccessMask
+                && lhs.oldLayout == rhs.oldLayout
+                && lhs.newLayout == rhs.newLayout
+                && lhs.srcQueueFamilyIndex == rhs.srcQueueFamilyIndex
+                && lhs.dstQueueFamilyIndex == rhs.dstQueueFamilyIndex
+                && lhs.subresourceRange.aspectMask == rhs.subresourceRange.aspectMask;
+        }
+
+        /**
+        * Extends the last barrier when the new one covers the next array layers of the same mip levels or the next mip
+        * levels of the same array layers with the same transition.
+        */
+        void appendImageBarrier(std::vector<VkImageMemoryBarrier2>& barriers, const VkImageMemoryBarrier2& barrier)
+        {
+            if (barriers.empty() == false && haveSameTransition(barriers.back(), barrier))
+            {
+                VkImageSubresourceRange& last_range = barriers.back().subresourceRange;
+                const VkImageSubresourceRange& range = barrier.subresourceRange;
+                if (last_range.baseMipLevel == range.baseMipLevel
+                    && last_range.levelCount == range.levelCount
+                    && last_range.baseArrayLayer + last_range.layerCount == range.baseArrayLayer)
+                {
+                    last_range.layerCount += range.layerCount;
+                    return;
+                }
+                if (last_range.baseArrayLayer == range.baseArrayLayer
+                    && last_range.layerCount == range.layerCount
+                    && last_range.baseMipLevel + last_range.levelCount == range.baseMipLevel)
+                {
+                    last_range.levelCount += range.levelCount;
+                    return;
+                }
+            }
+            barriers.push_back(barrier);
+        }
+    }
+
     namespace SyncGroups
     {
-        constexpr auto* kRelease = "Release";
-        constexpr auto* kAcquire = "Acquire";
+        const GroupId kRelease = GroupId::fromName("Release");
+        const GroupId kAcquire = GroupId::fromName("Acquire");
     }
     void ResourceStateMachine::resetStages(Texture& texture)
     {
@@ -25,19 +91,74 @@ namespace RenderEngine
                                       .setPipelineStage(VK_PIPELINE_STAGE_2_NONE)
                                       .setAccessFlag(VK_ACCESS_2_NONE), {});
     }
-    void ResourceStateMachine::recordStateChange(Texture* image, TextureState next_state)
+    void ResourceStateMachine::recordStateChange(Texture* texture, TextureState next_state, const VkImageSubresourceRange& range)
     {
-        if (next_state.layout == VK_IMAGE_LAYOUT_UNDEFINED)
+        VkImageSubresourceRange resolved_range = range;
+        if (resolved_range.levelCount == VK_REMAINING_MIP_LEVELS)
         {
-            assert(image->getResourceState().layout != VK_IMAGE_LAYOUT_UNDEFINED);
-            next_state.layout = image->getResourceState().layout;
+            resolved_range.levelCount = texture->getMipLevelCount() - range.baseMipLevel;
         }
-        _images[image] = std::move(next_state);
+        if (resolved_range.layerCount == VK_REMAINING_ARRAY_LAYERS)
+        {
+            resolved_range.layerCount = texture->getArrayLayerCount() - range.baseArrayLayer;
+        }
+        addStateChange(TextureStateChange{ .texture = texture, .range = resolved_range, .next_state = std::move(next_state) });
+    }
+
+    void ResourceStateMachine::recordStateChange(Texture* texture, TextureState next_state)
+    {
+        recordStateChange(texture, std::move(next_state), texture->createSubresourceRange());
     }
 
     void ResourceStateMachine::recordStateChange(Buffer* buffer, BufferState next_state)
     {
-        _buffers[buffer] = std::move(next_state);
+        addStateChange(BufferStateChange{ .buffer = buffer, .next_state = std::move(next_state) });
+    }
+
+    void ResourceStateMachine::recordReleaseStateChange(Texture* texture, TextureState next_state)
+    {
+        addStateChange(TextureStateChange{ .texture = texture,
+            .range = texture->createSubresourceRange(),
+            .next_state = std::move(next_state),
+            .apply_state_change = false });
+    }
+
+    void ResourceStateMachine::recordReleaseStateChange(Buffer* buffer, BufferState next_state)
+    {
+        addStateChange(BufferStateChange{ .buffer = buffer, .next_state = std::move(next_state), .apply_state_change = false });
+    }
+
+    void ResourceStateMachine::addStateChange(TextureStateChange change)
+    {
+        // A later change of the same subresources overrides the earlier one
+        auto it = std::ranges::find_if(_images, [&](const TextureStateChange& recorded_change)
+                                       {
+                                           return recorded_change.texture == change.texture
+                                               && isSameRange(recorded_change.range, change.range);
+                                       });
+        if (it != _images.end())
+        {
+            *it = std::move(change);
+            return;
+        }
+        assert(std::ranges::none_of(_images, [&](const TextureStateChange& recorded_change)
+                                    {
+                                        return recorded_change.texture == change.texture
+                                            && areRangesOverlapping(recorded_change.range, change.range);
+                                    })
+               && "Overlapping state changes of a texture must be committed separately");
+        _images.push_back(std::move(change));
+    }
+
+    void ResourceStateMachine::addStateChange(BufferStateChange change)
+    {
+        auto it = std::ranges::find(_buffers, change.buffer, &BufferStateChange::buffer);
+        if (it != _buffers.end())
+        {
+            *it = std::move(change);
+            return;
+        }
+        _buffers.push_back(std::move(change));
     }
 
     SyncObject ResourceStateMachine::transferOwnershipImpl(ResourceStateHolder auto* resource,
@@ -53,8 +174,7 @@ namespace RenderEngine
         assert(dst->isPipelineStageSupported(new_state.pipeline_stage));
         SyncObject sync_object = SyncObject::CreateEmpty(src->getLogicalDevice());
 
-        const std::string texture_semaphore_name = std::format("{:#x}", reinterpret_cast<intptr_t>(resource));
-        sync_object.createTimelineSemaphore(texture_semaphore_name, 0, 2);
+        const SemaphoreId texture_semaphore = sync_object.createTimelineSemaphore(std::format("{:#x}", reinterpret_cast<intptr_t>(resource)), 0, 2);
 
         // make ownership transform
         new_state = new_state.clone()
@@ -63,18 +183,16 @@ namespace RenderEngine
 
         if (src->isPipelineStageSupported(new_state.pipeline_stage))
         {
-            sync_object.addSignalOperationToGroup(SyncGroups::kRelease, texture_semaphore_name, new_state.pipeline_stage, 1);
-            sync_object.addWaitOperationToGroup(SyncGroups::kAcquire, texture_semaphore_name, new_state.pipeline_stage, 1);
+            sync_object.addSignalOperationToGroup(SyncGroups::kRelease, texture_semaphore, new_state.pipeline_stage, 1);
+            sync_object.addWaitOperationToGroup(SyncGroups::kAcquire, texture_semaphore, new_state.pipeline_stage, 1);
             ownershipTransformRelease(src_command_buffer,
-                                      src->getQueue(),
-                                      src->getLogicalDevice(),
+                                      *src,
                                       resource,
                                       new_state,
                                       sync_object,
                                       sync_operations.restrict(*src));
             ownershipTransformAcquire(dst_command_buffer,
-                                      dst->getQueue(),
-                                      dst->getLogicalDevice(),
+                                      *dst,
                                       resource,
                                       new_state,
                                       sync_object,
@@ -92,8 +210,8 @@ namespace RenderEngine
                 setCommandContext(dst->getWeakReference())
                 .setAccessFlag(0); // Access flag is ignored during queue family transition
 
-            sync_object.addSignalOperationToGroup(SyncGroups::kRelease, texture_semaphore_name, transition_state.pipeline_stage, 1);
-            sync_object.addWaitOperationToGroup(SyncGroups::kAcquire, texture_semaphore_name, transition_state.pipeline_stage, 1);
+            sync_object.addSignalOperationToGroup(SyncGroups::kRelease, texture_semaphore, transition_state.pipeline_stage, 1);
+            sync_object.addWaitOperationToGroup(SyncGroups::kAcquire, texture_semaphore, transition_state.pipeline_stage, 1);
 
             auto extra_state_transition = [&](VkCommandBuffer command_buffer, ResourceStateMachine& state_machine)
                 {
@@ -102,15 +220,13 @@ namespace RenderEngine
                 };
 
             ownershipTransformRelease(src_command_buffer,
-                                      src->getQueue(),
-                                      src->getLogicalDevice(),
+                                      *src,
                                       resource,
                                       transition_state,
                                       sync_object,
                                       sync_operations.restrict(*src));
             ownershipTransformAcquire(dst_command_buffer,
-                                      dst->getQueue(),
-                                      dst->getLogicalDevice(),
+                                      *dst,
                                       resource,
                                       transition_state,
                                       sync_object,
@@ -121,13 +237,13 @@ namespace RenderEngine
     }
 
     void ResourceStateMachine::ownershipTransformRelease(VkCommandBuffer src_command_buffer,
-                                                         VkQueue src_queue,
-                                                         LogicalDevice& logical_device,
+                                                         CommandContext& src,
                                                          ResourceStateHolder auto* resource,
                                                          const ResourceState auto& transition_state,
                                                          const SyncObject& transformation_sync_object,
                                                          const SyncOperations& external_operations)
     {
+        LogicalDevice& logical_device = src.getLogicalDevice();
         ResourceStateMachine src_state_machine(logical_device);
 
         VkCommandBufferBeginInfo src_begin_info{};
@@ -142,32 +258,22 @@ namespace RenderEngine
 
         logical_device->vkEndCommandBuffer(src_command_buffer);
 
-        VkCommandBufferSubmitInfo src_command_buffer_info{};
-        src_command_buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-        src_command_buffer_info.commandBuffer = src_command_buffer;
-
-        VkSubmitInfo2 src_submit_info{};
-        src_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
-        src_submit_info.commandBufferInfoCount = 1;
-
-        src_submit_info.pCommandBufferInfos = &src_command_buffer_info;
         auto release_operations =
             transformation_sync_object.query()
             .select(SyncGroups::kRelease)
             .join(external_operations.extract(SyncOperations::ExtractWaitOperations)).get();
-        release_operations.fillInfo(src_submit_info);
-        logical_device->vkQueueSubmit2(src_queue, 1, &src_submit_info, VK_NULL_HANDLE);
+        src.submit(src_command_buffer, release_operations);
     }
 
     void ResourceStateMachine::ownershipTransformAcquire(VkCommandBuffer dst_command_buffer,
-                                                         VkQueue dst_queue,
-                                                         LogicalDevice& logical_device,
+                                                         CommandContext& dst,
                                                          ResourceStateHolder auto* resource,
                                                          const ResourceState auto& transition_state,
                                                          const SyncObject& transformation_sync_object,
                                                          const SyncOperations& external_operations,
                                                          const std::function<void(VkCommandBuffer, ResourceStateMachine&)>& additional_command)
     {
+        LogicalDevice& logical_device = dst.getLogicalDevice();
         ResourceStateMachine dst_state_machine(logical_device);
 
         VkCommandBufferBeginInfo dst_begin_info{};
@@ -186,20 +292,10 @@ namespace RenderEngine
         }
         logical_device->vkEndCommandBuffer(dst_command_buffer);
 
-        VkCommandBufferSubmitInfo dst_command_buffer_info{};
-        dst_command_buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-        dst_command_buffer_info.commandBuffer = dst_command_buffer;
-
-        VkSubmitInfo2 dst_submit_info{};
-        dst_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
-        dst_submit_info.commandBufferInfoCount = 1;
-
-        dst_submit_info.pCommandBufferInfos = &dst_command_buffer_info;
         auto acquire_operations = transformation_sync_object.query()
             .select({ SyncGroups::kInternal, SyncGroups::kAcquire })
             .join(external_operations.extract(SyncOperations::ExtractSignalOperations | SyncOperations::ExtractFence)).get();
-        acquire_operations.fillInfo(dst_submit_info);
-        logical_device->vkQueueSubmit2(dst_queue, 1, &dst_submit_info, acquire_operations.getFence());
+        dst.submit(dst_command_buffer, acquire_operations);
     }
 
     [[nodiscard]]
@@ -242,13 +338,13 @@ namespace RenderEngine
                                                  const SyncOperations& sync_operations)
     {
         SyncObject result = SyncObject::CreateEmpty(src.getLogicalDevice());
-        result.createTimelineSemaphore("BarrierFinished", 0, 2);
+        const SemaphoreId barrier_finished = result.createTimelineSemaphore("BarrierFinished", 0, 2);
         result.addSignalOperationToGroup(SyncGroups::kInternal,
-                                         "BarrierFinished",
+                                         barrier_finished,
                                          resource.getResourceState().pipeline_stage,
                                          1);
         result.addWaitOperationToGroup(SyncGroups::kExternal,
-                                       "BarrierFinished",
+                                       barrier_finished,
                                        resource.getResourceState().pipeline_stage,
                                        1);
 
@@ -267,21 +363,11 @@ namespace RenderEngine
 
         src.getLogicalDevice()->vkEndCommandBuffer(command_buffer);
 
-        VkCommandBufferSubmitInfo command_buffer_info{};
-        command_buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
-        command_buffer_info.commandBuffer = command_buffer;
-
-        VkSubmitInfo2 submit_info{};
-        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
-        submit_info.commandBufferInfoCount = 1;
-
-        submit_info.pCommandBufferInfos = &command_buffer_info;
         auto operations =
             result.query()
             .select(SyncGroups::kInternal)
             .join(sync_operations.extract(SyncOperations::ExtractWaitOperations)).get();
-        operations.fillInfo(submit_info);
-        src.getLogicalDevice()->vkQueueSubmit2(src.getQueue(), 1, &submit_info, VK_NULL_HANDLE);
+        src.submit(command_buffer, operations);
         return result;
     }
 
@@ -308,40 +394,63 @@ namespace RenderEngine
     std::vector<VkImageMemoryBarrier2> ResourceStateMachine::createImageBarriers(bool apply_state_change_on_texture)
     {
         std::vector<VkImageMemoryBarrier2> image_barriers;
-        for (auto& [texture, next_state] : _images)
+        std::vector<VkImageMemoryBarrier2> mip_level_barriers;
+        for (auto& [texture, range, next_state, apply_state_change] : _images)
         {
-            auto state_description = texture->getResourceState();
-
-            if (next_state == state_description)
-            {
-                continue;
-            }
-            VkImageMemoryBarrier2 barrier{};
-            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
-            barrier.image = texture->getVkImage();
-            barrier.srcStageMask = state_description.pipeline_stage;
-            barrier.srcAccessMask = state_description.access_flag;
-            barrier.dstStageMask = next_state.pipeline_stage;
-            barrier.dstAccessMask = next_state.access_flag;
-
-            std::optional<uint32_t> current_queue_family_index = state_description.getQueueFamilyIndex();
-            std::optional<uint32_t> next_queue_family_index = next_state.getQueueFamilyIndex();
-            assert(current_queue_family_index.has_value() == next_queue_family_index.has_value()
-                   && "During family queue ownership transfer both states need a family queue index");
-
-            if (current_queue_family_index != std::nullopt && next_queue_family_index != std::nullopt)
+            for (uint32_t mip_level = range.baseMipLevel; mip_level < range.baseMipLevel + range.levelCount; ++mip_level)
             {
-                barrier.srcQueueFamilyIndex = *current_queue_family_index;
-                barrier.dstQueueFamilyIndex = *next_queue_family_index;
-            }
-
-            barrier.oldLayout = state_description.layout;
-            barrier.newLayout = next_state.layout;
-            barrier.subresourceRange = texture->createSubresourceRange();
-            image_barriers.emplace_back(barrier);
-            if (apply_state_change_on_texture)
-            {
-                texture->overrideResourceState(next_state, {});
+                mip_level_barriers.clear();
+                for (uint32_t array_layer = range.baseArrayLayer; array_layer < range.baseArrayLayer + range.layerCount; ++array_layer)
+                {
+                    const TextureState& state_description = texture->getResourceState(mip_level, array_layer);
+                    TextureState subresource_next_state = next_state;
+                    if (subresource_next_state.layout == VK_IMAGE_LAYOUT_UNDEFINED)
+                    {
+                        assert(state_description.layout != VK_IMAGE_LAYOUT_UNDEFINED);
+                        subresource_next_state.layout = state_description.layout;
+                    }
+                    // The writes still have to be made visible for the next access in the same state
+                    if (subresource_next_state == state_description
+                        && stateCanMakeChangesOnMemory(state_description.access_flag) == false)
+                    {
+                        continue;
+                    }
+                    VkImageMemoryBarrier2 barrier{};
+                    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+                    barrier.image = texture->getVkImage();
+                    barrier.srcStageMask = state_description.pipeline_stage;
+                    barrier.srcAccessMask = state_description.access_flag;
+                    barrier.dstStageMask = subresource_next_state.pipeline_stage;
+                    barrier.dstAccessMask = subresource_next_state.access_flag;
+
+                    std::optional<uint32_t> current_queue_family_index = state_description.getQueueFamilyIndex();
+                    std::optional<uint32_t> next_queue_family_index = subresource_next_state.getQueueFamilyIndex();
+                    assert((current_queue_family_index.has_value() == false || next_queue_family_index.has_value())
+                           && "During family queue ownership transfer both states need a family queue index");
+
+                    if (current_queue_family_index != std::nullopt && next_queue_family_index != std::nullopt)
+                    {
+                        barrier.srcQueueFamilyIndex = *current_queue_family_index;
+                        barrier.dstQueueFamilyIndex = *next_queue_family_index;
+                    }
+
+                    barrier.oldLayout = state_description.layout;
+                    barrier.newLayout = subresource_next_state.layout;
+                    barrier.subresourceRange = VkImageSubresourceRange{ .aspectMask = range.aspectMask,
+                        .baseMipLevel = mip_level,
+                        .levelCount = 1,
+                        .baseArrayLayer = array_layer,
+                        .layerCount = 1 };
+                    appendImageBarrier(mip_level_barriers, barrier);
+                    if (apply_state_change_on_texture && apply_state_change)
+                    {
+                        texture->overrideResourceState(std::move(subresource_next_state), barrier.subresourceRange, {});
+                    }
+                }
+                for (const VkImageMemoryBarrier2& barrier : mip_level_barriers)
+                {
+                    appendImageBarrier(image_barriers, barrier);
+                }
             }
         }
         _images.clear();
@@ -351,11 +460,12 @@ namespace RenderEngine
     std::vector<VkBufferMemoryBarrier2> ResourceStateMachine::createBufferBarriers(bool apply_state_change_on_buffer)
     {
         std::vector<VkBufferMemoryBarrier2> buffer_barriers;
-        for (auto& [buffer, next_state] : _buffers)
+        for (auto& [buffer, next_state, apply_state_change] : _buffers)
         {
             auto state_description = buffer->getResourceState();
 
-            if (next_state == state_description)
+            if (next_state == state_description
+                && stateCanMakeChangesOnMemory(state_description.access_flag) == false)
             {
                 continue;
             }
@@ -372,7 +482,7 @@ namespace RenderEngine
             std::optional<uint32_t> current_queue_family_index = state_description.getQueueFamilyIndex();
             std::optional<uint32_t> next_queue_family_index = next_state.getQueueFamilyIndex();
 
-            assert(current_queue_family_index.has_value() == next_queue_family_index.has_value()
+            assert((current_queue_family_index.has_value() == false || next_queue_family_index.has_value())
                    && "During family queue ownership transfer both states need a family queue index");
             if (current_queue_family_index != std::nullopt && next_queue_family_index != std::nullopt)
             {
@@ -382,7 +492,7 @@ namespace RenderEngine
             barrier.offset = 0;
             barrier.size = buffer->getDeviceSize();
             buffer_barriers.emplace_back(barrier);
-            if (apply_state_change_on_buffer)
+            if (apply_state_change_on_buffer && apply_state_change)
             {
                 buffer->overrideResourceState(next_state, {});
             }
@@ -393,25 +503,19 @@ namespace RenderEngine
 
     bool ResourceStateMachine::stateCanMakeChangesOnMemory(VkAccessFlags2 access)
     {
-        switch (access)
-        {
-            case VK_ACCESS_2_SHADER_WRITE_BIT:
-            case VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT:
-            case VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT:
-            case VK_ACCESS_2_TRANSFER_WRITE_BIT:
-            case VK_ACCESS_2_HOST_WRITE_BIT:
-            case VK_ACCESS_2_MEMORY_WRITE_BIT:
-            case VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT:
-            case VK_ACCESS_2_TRANSFORM_FEEDBACK_WRITE_BIT_EXT:
-            case VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT:
-            case VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR:
-            case VK_ACCESS_2_MICROMAP_WRITE_BIT_EXT:
-            case VK_ACCESS_2_OPTICAL_FLOW_WRITE_BIT_NV:
-                return true;
-            default:
-                return false;
-                break;
-        }
+        constexpr VkAccessFlags2 kWriteAccesses = VK_ACCESS_2_SHADER_WRITE_BIT
+            | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT
+            | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+            | VK_ACCESS_2_TRANSFER_WRITE_BIT
+            | VK_ACCESS_2_HOST_WRITE_BIT
+            | VK_ACCESS_2_MEMORY_WRITE_BIT
+            | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT
+            | VK_ACCESS_2_TRANSFORM_FEEDBACK_WRITE_BIT_EXT
+            | VK_ACCESS_2_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT
+            | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR
+            | VK_ACCESS_2_MICROMAP_WRITE_BIT_EXT
+            | VK_ACCESS_2_OPTICAL_FLOW_WRITE_BIT_NV;
+        return (access & kWriteAccesses) != 0;
     }
 
 
@@ -1,87 +1,83 @@
 #include <render_engine/synchronization/SyncObject.h>
 
-#include <ranges>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
 
 namespace RenderEngine
 {
-    void SyncObject::addSignalOperationToGroup(const std::string& group_name, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask)
+    GroupId GroupId::fromName(std::string_view name)
     {
-        auto it = _operation_groups.find(group_name);
-        if (it == _operation_groups.end())
-        {
-            it = _operation_groups.insert({ group_name, SyncOperations{ _primitives.getFence() } }).first;
-        }
-        it->second.addSignalOperation(_primitives, semaphore_name, stage_mask);
+        static std::mutex mutex;
+        static std::unordered_map<std::string, uint32_t> group_ids{ { "InternalGroup", SyncGroups::kInternal.index },
+            { "ExternalGroup", SyncGroups::kExternal.index } };
+
+        std::unique_lock lock(mutex);
+        auto [it, inserted] = group_ids.try_emplace(std::string{ name }, static_cast<uint32_t>(group_ids.size()));
+        return GroupId{ it->second };
     }
 
-    void SyncObject::addSignalOperationToGroup(const std::string& group_name, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value)
+    const SyncOperations& SyncObject::getOperationsGroup(GroupId group) const
     {
-        auto it = _operation_groups.find(group_name);
-        if (it == _operation_groups.end())
+        if (group.index >= _operation_groups.size() || _operation_groups[group.index] == std::nullopt)
         {
-            it = _operation_groups.insert({ group_name, SyncOperations{ _primitives.getFence() } }).first;
+            throw std::out_of_range("Sync object doesn't have the operation group");
         }
-        it->second.addSignalOperation(_primitives, semaphore_name, stage_mask, value);
+        return *_operation_groups[group.index];
     }
-    void SyncObject::addWaitOperationToGroup(const std::string& group_name, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask)
+
+    void SyncObject::addSignalOperationToGroup(GroupId group, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask)
     {
-        auto it = _operation_groups.find(group_name);
-        if (it == _operation_groups.end())
-        {
-            it = _operation_groups.insert({ group_name, SyncOperations{ _primitives.getFence() } }).first;
-        }
-        it->second.addWaitOperation(_primitives, semaphore_name, stage_mask);
+        getOrCreateOperationsGroup(group).addSignalOperation(_primitives, semaphore, stage_mask);
     }
-    void SyncObject::addWaitOperationToGroup(const std::string& group_name, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value)
+
+    void SyncObject::addSignalOperationToGroup(GroupId group, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask, uint64_t value)
     {
-        auto it = _operation_groups.find(group_name);
-        if (it == _operation_groups.end())
-        {
-            it = _operation_groups.insert({ group_name, SyncOperations{ _primitives.getFence() } }).first;
-        }
-        it->second.addWaitOperation(_primitives, semaphore_name, stage_mask, value);
+        getOrCreateOperationsGroup(group).addSignalOperation(_primitives, semaphore, stage_mask, value);
     }
-    void SyncObject::signalSemaphore(const std::string& name, uint64_t value)
+    void SyncObject::addWaitOperationToGroup(GroupId group, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask)
+    {
+        getOrCreateOperationsGroup(group).addWaitOperation(_primitives, semaphore, stage_mask);
+    }
+    void SyncObject::addWaitOperationToGroup(GroupId group, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask, uint64_t value)
+    {
+        getOrCreateOperationsGroup(group).addWaitOperation(_primitives, semaphore, stage_mask, value);
+    }
+    void SyncObject::signalSemaphore(SemaphoreId semaphore, uint64_t value)
     {
-        auto semaphore = _primitives.getSemaphore(name);
-
         VkSemaphoreSignalInfo signal_info{};
         signal_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
-        signal_info.semaphore = semaphore;
-        signal_info.value = _primitives.getTimelineOffset(name) + value;
+        signal_info.semaphore = _primitives.getSemaphore(semaphore);
+        signal_info.value = _primitives.getTimelineOffset(semaphore) + value;
         if (_primitives.getLogicalDevice()->vkSignalSemaphore(*_primitives.getLogicalDevice(), &signal_info) != VK_SUCCESS)
         {
-            throw std::runtime_error("Couldn't signal semaphore: " + name);
+            throw std::runtime_error("Couldn't signal semaphore: " + _primitives.getSemaphoreName(semaphore));
         }
     }
-    void SyncObject::waitSemaphore(const std::string& name, uint64_t value)
+    void SyncObject::waitSemaphore(SemaphoreId semaphore, uint64_t value)
     {
-        auto semaphore = _primitives.getSemaphore(name);
-
-        const uint64_t value_to_wait = _primitives.getTimelineOffset(name) + value;
+        const uint64_t value_to_wait = _primitives.getTimelineOffset(semaphore) + value;
 
         VkSemaphoreWaitInfo wait_info{};
         wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
-        wait_info.pSemaphores = &semaphore;
+        wait_info.pSemaphores = &_primitives.getSemaphore(semaphore);
         wait_info.semaphoreCount = 1;
         wait_info.pValues = &value_to_wait;
         if (_primitives.getLogicalDevice()->vkWaitSemaphores(*_primitives.getLogicalDevice(), &wait_info, UINT64_MAX) != VK_SUCCESS)
         {
-            throw std::runtime_error("Couldn't wait semaphore: " + name);
+            throw std::runtime_error("Couldn't wait semaphore: " + _primitives.getSemaphoreName(semaphore));
         }
     }
 
-    uint64_t RenderEngine::SyncObject::getSemaphoreValue(const std::string& name)
+    uint64_t SyncObject::getSemaphoreValue(SemaphoreId semaphore)
     {
-        auto semaphore = _primitives.getSemaphore(name);
-
         uint64_t value = 0;
-        if (_primitives.getLogicalDevice()->vkGetSemaphoreCounterValue(*_primitives.getLogicalDevice(), semaphore, &value) != VK_SUCCESS)
+        if (_primitives.getLogicalDevice()->vkGetSemaphoreCounterValue(*_primitives.getLogicalDevice(), _primitives.getSemaphore(semaphore), &value) != VK_SUCCESS)
         {
             throw std::runtime_error("Couldn't read semaphore value");
         }
-        return value % _primitives.getTimelineWidth(name);
+        return value % _primitives.getTimelineWidth(semaphore);
     }
 
     void SyncObject::waitFence()
@@ -95,27 +91,44 @@ namespace RenderEngine
     }
 
 
-    void SyncObject::createSemaphore(std::string name)
+    SemaphoreId SyncObject::createSemaphore(std::string name)
     {
-        _primitives.createSemaphore(std::move(name));
+        return _primitives.createSemaphore(std::move(name));
     }
-    void SyncObject::createTimelineSemaphore(std::string name, uint64_t initial_value, uint64_t timeline_width)
+    SemaphoreId SyncObject::createTimelineSemaphore(std::string name, uint64_t initial_value, uint64_t timeline_width)
     {
-        _primitives.createTimelineSemaphore(std::move(name), initial_value, timeline_width);
+        return _primitives.createTimelineSemaphore(std::move(name), initial_value, timeline_width);
     }
-    void SyncObject::stepTimeline(const std::string& name)
+    void SyncObject::stepTimeline(SemaphoreId semaphore)
     {
-        const uint64_t offset = _primitives.stepTimeline(name);
-        for (auto& sync_operation : _operation_groups | std::views::values)
+        const uint64_t offset = _primitives.stepTimeline(semaphore);
+        for (auto& sync_operation : _operation_groups)
         {
-            sync_operation.shiftTimelineSemaphoreValues(offset);
+            if (sync_operation != std::nullopt)
+            {
+                sync_operation->shiftTimelineSemaphoreValues(offset);
+            }
         }
     }
 
     SyncObject::SyncObject(LogicalDevice& logical_device, bool create_with_fence, VkFenceCreateFlags create_flags)
         : _primitives(create_with_fence ? SyncPrimitives::CreateWithFence(logical_device, create_flags)
                       : SyncPrimitives::CreateEmpty(logical_device))
-        , _operation_groups{ { std::string(SyncGroups::kInternal), SyncOperations{_primitives.getFence()} },
-        { std::string(SyncGroups::kExternal), SyncOperations{_primitives.getFence()} } }
-    {}
-}
\ No newline at end of file
+    {
+        getOrCreateOperationsGroup(SyncGroups::kInternal);
+        getOrCreateOperationsGroup(SyncGroups::kExternal);
+    }
+
+    SyncOperations& SyncObject::getOrCreateOperationsGroup(GroupId group)
+    {
+        if (group.index >= _operation_groups.size())
+        {
+            _operation_groups.resize(group.index + 1);
+        }
+        if (_operation_groups[group.index] == std::nullopt)
+        {
+            _operation_groups[group.index].emplace(_primitives.getFence());
+        }
+        return *_operation_groups[group.index];
+    }
+}
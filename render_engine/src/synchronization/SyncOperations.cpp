@@ -7,39 +7,39 @@
 
 namespace RenderEngine
 {
-    void SyncOperations::addWaitOperation(SyncPrimitives& sync_object, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask)
+    void SyncOperations::addWaitOperation(SyncPrimitives& sync_object, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask)
     {
         VkSemaphoreSubmitInfo submit_info{};
         submit_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        submit_info.semaphore = sync_object.getSemaphore(semaphore_name);
+        submit_info.semaphore = sync_object.getSemaphore(semaphore);
         submit_info.stageMask = stage_mask;
-        _wait_semaphore_dependency.emplace_back(std::move(submit_info));
+        _wait_semaphore_dependency.push_back(submit_info);
     }
-    void SyncOperations::addWaitOperation(SyncPrimitives& sync_object, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value)
+    void SyncOperations::addWaitOperation(SyncPrimitives& sync_object, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask, uint64_t value)
     {
         VkSemaphoreSubmitInfo submit_info{};
         submit_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        submit_info.semaphore = sync_object.getSemaphore(semaphore_name);
+        submit_info.semaphore = sync_object.getSemaphore(semaphore);
         submit_info.stageMask = stage_mask;
-        submit_info.value = sync_object.getTimelineOffset(semaphore_name) + value;
-        _wait_semaphore_dependency.emplace_back(std::move(submit_info));
+        submit_info.value = sync_object.getTimelineOffset(semaphore) + value;
+        _wait_semaphore_dependency.push_back(submit_info);
     }
-    void SyncOperations::addSignalOperation(SyncPrimitives& sync_object, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask)
+    void SyncOperations::addSignalOperation(SyncPrimitives& sync_object, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask)
     {
         VkSemaphoreSubmitInfo submit_info{};
         submit_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        submit_info.semaphore = sync_object.getSemaphore(semaphore_name);
+        submit_info.semaphore = sync_object.getSemaphore(semaphore);
         submit_info.stageMask = stage_mask;
-        _signal_semaphore_dependency.emplace_back(std::move(submit_info));
+        _signal_semaphore_dependency.push_back(submit_info);
     }
-    void SyncOperations::addSignalOperation(SyncPrimitives& sync_object, const std::string& semaphore_name, VkPipelineStageFlags2 stage_mask, uint64_t value)
+    void SyncOperations::addSignalOperation(SyncPrimitives& sync_object, SemaphoreId semaphore, VkPipelineStageFlags2 stage_mask, uint64_t value)
     {
         VkSemaphoreSubmitInfo submit_info{};
         submit_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
-        submit_info.semaphore = sync_object.getSemaphore(semaphore_name);
+        submit_info.semaphore = sync_object.getSemaphore(semaphore);
         submit_info.stageMask = stage_mask;
-        submit_info.value = sync_object.getTimelineOffset(semaphore_name) + value;
-        _signal_semaphore_dependency.emplace_back(std::move(submit_info));
+        submit_info.value = sync_object.getTimelineOffset(semaphore) + value;
+        _signal_semaphore_dependency.push_back(submit_info);
     }
     const SyncOperations& SyncOperations::fillInfo(VkSubmitInfo2& submit_info) const
     {
@@ -50,15 +50,25 @@ namespace RenderEngine
         submit_info.pSignalSemaphoreInfos = _signal_semaphore_dependency.data();
         return *this;
     }
-    void SyncOperations::unionWith(const SyncOperations& o)
+    SyncOperations& SyncOperations::unionWith(const SyncOperations& o, int32_t extract_bits)
     {
-        std::ranges::copy(o._wait_semaphore_dependency, std::back_inserter(_wait_semaphore_dependency));
-        std::ranges::copy(o._signal_semaphore_dependency, std::back_inserter(_signal_semaphore_dependency));
-        assert((_fence == VK_NULL_HANDLE || o._fence == VK_NULL_HANDLE) && "fence conflict");
-        if (_fence == VK_NULL_HANDLE)
+        if (extract_bits & ExtractWaitOperations)
         {
-            _fence = o._fence;
+            _wait_semaphore_dependency.append(o._wait_semaphore_dependency);
         }
+        if (extract_bits & ExtractSignalOperations)
+        {
+            _signal_semaphore_dependency.append(o._signal_semaphore_dependency);
+        }
+        if (extract_bits & ExtractFence)
+        {
+            assert((_fence == VK_NULL_HANDLE || o._fence == VK_NULL_HANDLE) && "fence conflict");
+            if (_fence == VK_NULL_HANDLE)
+            {
+                _fence = o._fence;
+            }
+        }
+        return *this;
     }
     void SyncOperations::shiftTimelineSemaphoreValues(uint64_t offset)
     {
@@ -79,18 +89,14 @@ namespace RenderEngine
         _signal_semaphore_dependency.clear();
         _fence = VK_NULL_HANDLE;
     }
-    SyncOperations SyncOperations::restrict(const CommandContext& context) const
+    void SyncOperations::restrictTo(const CommandContext& context)
     {
-        auto result = *this;
-        std::erase_if(result._wait_semaphore_dependency, [&](auto& submit_info)
-                      {
-                          return context.isPipelineStageSupported(submit_info.stageMask) == false;
-                      });
-        std::erase_if(result._signal_semaphore_dependency, [&](auto& submit_info)
-                      {
-                          return context.isPipelineStageSupported(submit_info.stageMask) == false;
-                      });
-        return result;
+        auto is_unsupported = [&](const VkSemaphoreSubmitInfo& submit_info)
+            {
+                return context.isPipelineStageSupported(submit_info.stageMask) == false;
+            };
+        _wait_semaphore_dependency.eraseIf(is_unsupported);
+        _signal_semaphore_dependency.eraseIf(is_unsupported);
     }
 
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include <render_engine/synchronization/SyncPrimitives.h>
 
+#include <algorithm>
 #include <cassert>
-#include <ranges>
 #include <stdexcept>
 
 
@@ -28,31 +28,28 @@ namespace RenderEngine
         {
             getLogicalDevice()->vkDestroyFence(*getLogicalDevice(), _fence, nullptr);
         }
-        for (VkSemaphore semaphore : _semaphore_map | std::views::values)
+        for (const SemaphoreData& semaphore_data : _semaphores)
         {
-            getLogicalDevice()->vkDestroySemaphore(*getLogicalDevice(), semaphore, nullptr);
+            getLogicalDevice()->vkDestroySemaphore(*getLogicalDevice(), semaphore_data.semaphore, nullptr);
         }
     }
     SyncPrimitives::SyncPrimitives(SyncPrimitives&& o)
-        : _semaphore_map(std::move(o._semaphore_map))
-        , _timeline_data(std::move(o._timeline_data))
-        , _logical_device(o._logical_device)
+        : _semaphores(std::move(o._semaphores))
         , _fence(o._fence)
+        , _logical_device(o._logical_device)
     {
         o._logical_device = nullptr;
         o._fence = VK_NULL_HANDLE;
-        o._semaphore_map.clear();
-        o._timeline_data.clear();
+        o._semaphores.clear();
     }
     SyncPrimitives& SyncPrimitives::operator=(SyncPrimitives&& o)
     {
-        std::swap(o._semaphore_map, _semaphore_map);
-        std::swap(o._timeline_data, _timeline_data);
+        std::swap(o._semaphores, _semaphores);
         std::swap(o._logical_device, _logical_device);
         std::swap(o._fence, _fence);
         return *this;
     }
-    void SyncPrimitives::createSemaphore(std::string name)
+    SemaphoreId SyncPrimitives::createSemaphore(std::string name)
     {
         VkSemaphoreCreateInfo create_info{};
         create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -61,9 +58,9 @@ namespace RenderEngine
         {
             throw std::runtime_error("Cannot create semaphore");
         }
-        _semaphore_map.emplace(std::move(name), semaphore);
+        return addSemaphore({ .name = std::move(name), .semaphore = semaphore });
     }
-    void SyncPrimitives::createTimelineSemaphore(std::string name, uint64_t initial_value, uint64_t timeline_width)
+    SemaphoreId SyncPrimitives::createTimelineSemaphore(std::string name, uint64_t initial_value, uint64_t timeline_width)
     {
         VkSemaphoreTypeCreateInfo type_info{};
         type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
@@ -79,13 +76,22 @@ namespace RenderEngine
             throw std::runtime_error("Cannot create semaphore");
         }
 
-        _semaphore_map.emplace(name, semaphore);
-        _timeline_data.emplace(std::move(name),
-                               TimelineSemaphoreData{ .timeline_width = timeline_width, .initial_value = initial_value });
+        return addSemaphore({ .name = std::move(name),
+                            .semaphore = semaphore,
+                            .timeline_data = TimelineSemaphoreData{ .timeline_width = timeline_width, .initial_value = initial_value } });
+    }
+    SemaphoreId SyncPrimitives::getSemaphoreId(std::string_view name) const
+    {
+        const SemaphoreData* semaphore_data = findSemaphore(name);
+        if (semaphore_data == nullptr)
+        {
+            throw std::out_of_range("Semaphore doesn't exist: " + std::string(name));
+        }
+        return SemaphoreId{ static_cast<uint32_t>(semaphore_data - _semaphores.data()) };
     }
-    uint64_t SyncPrimitives::stepTimeline(const std::string& name)
+    uint64_t SyncPrimitives::stepTimeline(SemaphoreId id)
     {
-        auto& timeline_data = _timeline_data.at(name);
+        auto& timeline_data = _semaphores.at(id.index).timeline_data.value();
         // TODO recreate Timeline semaphore when overflow happened. initial value is stored so probably it is a small fix.
         assert(timeline_data.timeline_offset < timeline_data.timeline_offset + timeline_data.timeline_width
                && "Overflow happened. Semaphore needs to be recreated to be able to continue");
@@ -93,4 +99,15 @@ namespace RenderEngine
         timeline_data.timeline_offset += timeline_data.timeline_width;
         return timeline_data.timeline_width;
     }
+    const SyncPrimitives::SemaphoreData* SyncPrimitives::findSemaphore(std::string_view name) const
+    {
+        auto it = std::ranges::find(_semaphores, name, &SemaphoreData::name);
+        return it != _semaphores.end() ? &*it : nullptr;
+    }
+    SemaphoreId SyncPrimitives::addSemaphore(SemaphoreData semaphore_data)
+    {
+        assert(hasSemaphore(semaphore_data.name) == false && "Semaphore names must be unique in an object");
+        _semaphores.push_back(std::move(semaphore_data));
+        return SemaphoreId{ static_cast<uint32_t>(_semaphores.size() - 1) };
+    }
 }
\ No newline at end of file
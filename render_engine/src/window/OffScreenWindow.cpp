@@ -22,13 +22,14 @@ namespace RenderEngine
 {
     namespace SyncGroups
     {
-        constexpr auto kEmpty = "EmptyGroup";
-        constexpr auto kPresent = "PresentGroup";
+        const GroupId kEmpty = GroupId::fromName("EmptyGroup");
+        const GroupId kPresent = GroupId::fromName("PresentGroup");
     }
 
     OffScreenWindow::OffScreenWindow(Device& device,
                                      std::unique_ptr<RenderEngine>&& render_engine,
-                                     std::vector<std::unique_ptr<Texture>>&& textures)
+                                     std::vector<std::unique_ptr<Texture>>&& textures,
+                                     uint32_t readback_frames_in_flight)
         try : _device(device)
         , _render_engine(std::move(render_engine))
         , _back_buffer()
@@ -36,6 +37,7 @@ namespace RenderEngine
         , _image_stream(ImageStream::ImageDescription{ .width = textures.front()->getImage().getWidth(),
                 .height = textures.front()->getImage().getHeight(),
                 .format = textures.front()->getImage().getFormat() })
+        , _readback_worker(std::make_unique<ReadbackWorker>(_image_stream, readback_frames_in_flight))
     {
         _back_buffer.reserve(_back_buffer_size);
         Texture::ImageViewData image_view_data;
@@ -61,10 +63,18 @@ namespace RenderEngine
         destroy();
     }
 
-    void OffScreenWindow::update()
+    void OffScreenWindow::render()
     {
+        const auto frame_start = std::chrono::steady_clock::now();
         RenderContext::context().clearGarbage();
         present();
+        _render_thread_frame_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frame_start);
+    }
+
+    OffScreenWindow::FrameStatistics OffScreenWindow::getFrameStatistics() const
+    {
+        return FrameStatistics{ .render_thread_frame_time = _render_thread_frame_time,
+            .readback_latency = _readback_worker != nullptr ? _readback_worker->getLastLatency() : std::chrono::microseconds{ 0 } };
     }
 
     void OffScreenWindow::registerRenderers(const std::vector<uint32_t>& renderer_ids)
@@ -83,24 +93,24 @@ namespace RenderEngine
     {
         for (FrameData& frame_data : _back_buffer)
         {
-            frame_data.synch_render.createSemaphore("image-available");
-            frame_data.synch_render.createSemaphore("render-finished");
+            const SemaphoreId image_available = frame_data.synch_render.createSemaphore("image-available");
+            const SemaphoreId render_finished = frame_data.synch_render.createSemaphore("render-finished");
 
             frame_data.synch_render.addSignalOperationToGroup(SyncGroups::kPresent,
-                                                              "image-available",
+                                                              image_available,
                                                               VK_PIPELINE_STAGE_2_COPY_BIT);
             frame_data.synch_render.addWaitOperationToGroup(SyncGroups::kInternal,
-                                                            "image-available",
+                                                            image_available,
                                                             VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
 
             frame_data.synch_render.addSignalOperationToGroup(SyncGroups::kInternal,
-                                                              "render-finished",
+                                                              render_finished,
                                                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
             frame_data.synch_render.addSignalOperationToGroup(SyncGroups::kEmpty,
-                                                              "render-finished",
+                                                              render_finished,
                                                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
             frame_data.synch_render.addWaitOperationToGroup(SyncGroups::kPresent,
-                                                            "render-finished",
+                                                            render_finished,
                                                             VK_PIPELINE_STAGE_2_COPY_BIT);
 
 
@@ -122,8 +132,9 @@ namespace RenderEngine
     }
     void OffScreenWindow::destroy()
     {
-        auto& logical_device = _device.getLogicalDevice();
-        logical_device->vkDeviceWaitIdle(*logical_device);
+        _device.getLogicalDevice().waitIdle();
+        // The worker finishes the pending readbacks which refer to the render targets
+        _readback_worker.reset();
         _back_buffer.clear();
         _renderers.clear();
 
@@ -151,14 +162,13 @@ namespace RenderEngine
         if (_renderdoc_api) ((RENDERDOC_API_1_1_2*)_renderdoc_api)->StartFrameCapture(NULL, NULL);
 
         present(_back_buffer[getCurrentImageIndex()]);
-        readBack();
         _current_render_target_index = (_current_render_target_index + 1) % _back_buffer_size;
         if (_renderdoc_api) ((RENDERDOC_API_1_1_2*)_renderdoc_api)->EndFrameCapture(NULL, NULL);
 
         _frame_counter++;
     }
 
-    void OffScreenWindow::present(FrameData& frame_data) const
+    void OffScreenWindow::present(FrameData& frame_data)
     {
         if (_renderers.empty())
         {
@@ -166,41 +176,47 @@ namespace RenderEngine
         }
         auto renderers = _renderers | std::views::transform([](const auto& ptr) { return ptr.get(); });
 
-        _render_engine->onFrameBegin(renderers, getCurrentImageIndex());
-
-        const std::string operation_group_name = frame_data.contains_image ? SyncGroups::kInternal : SyncGroups::kEmpty;
-
-        bool draw_call_submitted = _render_engine->render(frame_data.synch_render.getOperationsGroup(operation_group_name),
-                                                          _renderers | std::views::transform([](const auto& ptr) { return ptr.get(); }),
-                                                          getCurrentImageIndex());
-        frame_data.contains_image = draw_call_submitted;
+        const uint32_t image_index = getCurrentImageIndex();
+        _render_engine->onFrameBegin(renderers, image_index);
+
+        const GroupId operation_group = frame_data.contains_image ? SyncGroups::kInternal : SyncGroups::kEmpty;
+
+        // The download waits for the semaphores of the draw calls, it is scheduled when they are submitted
+        bool draw_call_recorded = _render_engine->render(frame_data.synch_render.getOperationsGroup(operation_group),
+                                                         renderers,
+                                                         image_index,
+                                                         [this, &frame_data, image_index]
+                                                         {
+                                                             frame_data.contains_image = true;
+                                                             readBack(image_index);
+                                                         });
+        if (draw_call_recorded == false)
+        {
+            frame_data.contains_image = false;
+        }
     }
-    void OffScreenWindow::readBack()
+    void OffScreenWindow::readBack(uint32_t image_index)
     {
         {
-            FrameData& frame_to_download = _back_buffer[getCurrentImageIndex()];
+            FrameData& frame_to_download = _back_buffer[image_index];
             // Start reading back the current image
             _device.getStagingArea().getScheduler().download(frame_to_download.render_target_texture.get(),
                                                              frame_to_download.synch_render.getOperationsGroup(SyncGroups::kPresent));
+            frame_to_download.download_request_time = std::chrono::steady_clock::now();
         }
         {
-            FrameData& frame_to_read_back = _back_buffer[getOldestImageIndex()];
+            FrameData& frame_to_read_back = _back_buffer[(image_index + 1) % _back_buffer_size];
 
             if (frame_to_read_back.contains_image == false)
             {
                 return;
             }
 
-            /*
-            * TODO: Current bottleneck: Copying data from a coherent memory is slow. It should be done on a different thread.
-            *
-            * This TODO should be done when the render graph is introduced and parallel rendering is there.
-            */
             auto download_task = frame_to_read_back.render_target_texture->clearDownloadTask();
             assert(download_task != nullptr && "When the frame contains image it should have a download task");
 
-            auto image = download_task->getImage();
-            _image_stream << std::move(std::get<std::vector<uint8_t>>(image.getData()));
+            // Waiting for the download and copying the data from the staging memory is done by the readback thread
+            _readback_worker->push(std::move(download_task), frame_to_read_back.download_request_time);
         }
     }
 
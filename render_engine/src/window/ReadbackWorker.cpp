@@ -0,0 +1,77 @@
+#include <render_engine/window/ReadbackWorker.h>
+
+#include <render_engine/DataTransferTasks.h>
+
+#include <cassert>
+
+namespace RenderEngine
+{
+    ReadbackWorker::ReadbackWorker(ImageStream& image_stream, uint32_t frames_in_flight)
+        : _image_stream(image_stream)
+        , _frames_in_flight(frames_in_flight)
+    {
+        assert(_frames_in_flight > 0 && "At least one frame needs to be allowed in readback");
+        _thread = std::thread([this] { run(); });
+    }
+
+    ReadbackWorker::~ReadbackWorker()
+    {
+        {
+            std::unique_lock lock(_mutex);
+            _stop = true;
+        }
+        _job_available.notify_one();
+        _thread.join();
+    }
+
+    void ReadbackWorker::push(std::shared_ptr<DownloadTask> download_task, std::chrono::steady_clock::time_point request_time)
+    {
+        assert(download_task != nullptr && download_task->isStarted() && "Only started downloads can be read back");
+        {
+            std::unique_lock lock(_mutex);
+            _slot_available.wait(lock, [&] { return _jobs.size() + _jobs_in_progress < _frames_in_flight; });
+            _jobs.push_back(Job{ .download_task = std::move(download_task), .request_time = request_time });
+        }
+        _job_available.notify_one();
+    }
+
+    std::chrono::microseconds ReadbackWorker::getLastLatency() const
+    {
+        std::unique_lock lock(_mutex);
+        return _last_latency;
+    }
+
+    void ReadbackWorker::run()
+    {
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock lock(_mutex);
+                _job_available.wait(lock, [&] { return _stop || _jobs.empty() == false; });
+                // The pending jobs are finished before stopping to not lose any frame
+                if (_jobs.empty())
+                {
+                    return;
+                }
+                job = std::move(_jobs.front());
+                _jobs.pop_front();
+                _jobs_in_progress++;
+            }
+
+            std::vector<uint8_t> image_data = _image_stream.acquireBuffer(job.download_task->getSizeInBytes());
+            job.download_task->getInto(image_data);
+            _image_stream << std::move(image_data);
+            // The staging memory of the download is given back here
+            job.download_task.reset();
+
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - job.request_time);
+            {
+                std::unique_lock lock(_mutex);
+                _jobs_in_progress--;
+                _last_latency = latency;
+            }
+            _slot_available.notify_one();
+        }
+    }
+}
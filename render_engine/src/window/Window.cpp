@@ -11,6 +11,7 @@
 #include <fstream>
 #include <limits>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <backends/imgui_impl_vulkan.h>
@@ -53,16 +54,13 @@ namespace RenderEngine
         destroy();
     }
 
-    void Window::update()
+    void Window::render()
     {
-        RenderContext::context().clearGarbage();
         if (_closed)
         {
-            destroy();
             return;
         }
         present();
-        handleEvents();
     }
 
     void Window::registerRenderers(const std::vector<uint32_t>& renderer_ids)
@@ -102,17 +100,17 @@ namespace RenderEngine
     {
         for (FrameData& frame_data : _back_buffer)
         {
-            frame_data.synch_render.createSemaphore("image-available");
-            frame_data.synch_render.createSemaphore("render-finished");
+            frame_data.image_available = frame_data.synch_render.createSemaphore("image-available");
+            frame_data.render_finished = frame_data.synch_render.createSemaphore("render-finished");
 
             // the signal is sent from swap chain acquire image
             frame_data.synch_render.addWaitOperationToGroup(SyncGroups::kInternal,
-                                                            "image-available",
+                                                            frame_data.image_available,
                                                             VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
 
             // the signal is waited in presentInfo during presen
             frame_data.synch_render.addSignalOperationToGroup(SyncGroups::kInternal,
-                                                              "render-finished",
+                                                              frame_data.render_finished,
                                                               VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
 
         }
@@ -120,6 +118,12 @@ namespace RenderEngine
 
     void Window::handleEvents()
     {
+        RenderContext::context().clearGarbage();
+        if (_closed)
+        {
+            destroy();
+            return;
+        }
         bool should_be_closed = glfwWindowShouldClose(_window);
         if (should_be_closed)
         {
@@ -128,6 +132,15 @@ namespace RenderEngine
             return;
         }
         glfwPollEvents();
+        _iconified = glfwGetWindowAttrib(_window, GLFW_ICONIFIED) == GLFW_TRUE;
+        if (std::exchange(_swap_chain_reinit_required, false))
+        {
+            reinitSwapChain();
+        }
+        for (auto& renderer : _renderers)
+        {
+            renderer->handleEvents();
+        }
     }
 
     void Window::present()
@@ -141,8 +154,7 @@ namespace RenderEngine
     }
     void Window::reinitSwapChain()
     {
-        auto& logical_device = _device.getLogicalDevice();
-        logical_device->vkDeviceWaitIdle(*logical_device);
+        _device.getLogicalDevice().waitIdle();
         std::vector<AbstractRenderer::ReinitializationCommand> commands;
         for (auto& drawer : _renderers)
         {
@@ -161,8 +173,7 @@ namespace RenderEngine
         {
             return;
         }
-        auto& logical_device = _device.getLogicalDevice();
-        logical_device->vkDeviceWaitIdle(*logical_device);
+        _device.getLogicalDevice().waitIdle();
         _back_buffer.clear();
         _swap_chain.reset();
         _renderers.clear();
@@ -175,7 +186,7 @@ namespace RenderEngine
     }
     void Window::present(FrameData& frame_data)
     {
-        if (glfwGetWindowAttrib(_window, GLFW_ICONIFIED) == GLFW_TRUE)
+        if (_iconified)
         {
             return;
         }
@@ -192,14 +203,14 @@ namespace RenderEngine
             auto call_result = logical_device->vkAcquireNextImageKHR(*logical_device,
                                                                      _swap_chain->getDetails().swap_chain,
                                                                      UINT64_MAX,
-                                                                     frame_data.synch_render.getPrimitives().getSemaphore("image-available"),
+                                                                     frame_data.synch_render.getPrimitives().getSemaphore(frame_data.image_available),
                                                                      VK_NULL_HANDLE,
                                                                      &image_index);
             switch (call_result)
             {
                 case VK_ERROR_OUT_OF_DATE_KHR:
                 case VK_SUBOPTIMAL_KHR:
-                    reinitSwapChain();
+                    _swap_chain_reinit_required = true;
                     return;
                 case VK_SUCCESS:
                     break;
@@ -212,23 +223,32 @@ namespace RenderEngine
         _render_engine->onFrameBegin(renderers, *_swap_chain_image_index);
 
 
+        const uint32_t image_index = *_swap_chain_image_index;
+        const VkSemaphore render_finished = frame_data.synch_render.getPrimitives().getSemaphore(frame_data.render_finished);
+        const VkSwapchainKHR swap_chain = _swap_chain->getDetails().swap_chain;
+        // The image is presented when the frame scheduler of the device submitted the draw calls
+        auto present_image = [this, image_index, render_finished, swap_chain]
+            {
+                VkPresentInfoKHR presentInfo{};
+                presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+
+                presentInfo.waitSemaphoreCount = 1;
+                presentInfo.pWaitSemaphores = &render_finished;
+                presentInfo.swapchainCount = 1;
+                presentInfo.pSwapchains = &swap_chain;
+
+                presentInfo.pImageIndices = &image_index;
+
+                auto& present_device = _present_context->getLogicalDevice();
+                auto queue_lock = present_device.lockQueue(_present_context->getQueue());
+                present_device->vkQueuePresentKHR(_present_context->getQueue(), &presentInfo);
+            };
         bool draw_call_recorded = _render_engine->render(frame_data.synch_render.getOperationsGroup(SyncGroups::kInternal),
                                                          renderers,
-                                                         *_swap_chain_image_index);
+                                                         image_index,
+                                                         std::move(present_image));
         if (draw_call_recorded)
         {
-            VkPresentInfoKHR presentInfo{};
-            presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-
-            presentInfo.waitSemaphoreCount = 1;
-            presentInfo.pWaitSemaphores = &frame_data.synch_render.getPrimitives().getSemaphore("render-finished");
-            VkSwapchainKHR swapChains[] = { _swap_chain->getDetails().swap_chain };
-            presentInfo.swapchainCount = 1;
-            presentInfo.pSwapchains = swapChains;
-
-            presentInfo.pImageIndices = &*_swap_chain_image_index;
-
-            _present_context->getLogicalDevice()->vkQueuePresentKHR(_present_context->getQueue(), &presentInfo);
             _swap_chain_image_index = std::nullopt;
             _presented_frame_counter++;
         }
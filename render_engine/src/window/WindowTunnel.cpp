@@ -1,10 +1,22 @@
 #include "render_engine/window/WindowTunnel.h"
 
+#include <render_engine/RenderContext.h>
+
 namespace RenderEngine
 {
+    WindowTunnel::WindowTunnel(std::unique_ptr<OffScreenWindow> origin_window,
+                               std::unique_ptr<IWindow> destination_window)
+        : _origin_window(std::move(origin_window))
+        , _destination_window(std::move(destination_window))
+        , _update_scheduler(std::make_unique<WindowUpdateScheduler>(RenderContext::context().getJobSystem()))
+    {
+        _origin_window->registerTunnel(*this);
+        _destination_window->registerTunnel(*this);
+        _update_scheduler->addTunnel(*this);
+    }
+
     void WindowTunnel::update()
     {
-        _origin_window->update();
-        _destination_window->update();
+        _update_scheduler->update();
     }
 }
\ No newline at end of file
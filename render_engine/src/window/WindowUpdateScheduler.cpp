@@ -0,0 +1,122 @@
+#include <render_engine/window/WindowUpdateScheduler.h>
+
+#include <render_engine/Device.h>
+#include <render_engine/FrameScheduler.h>
+#include <render_engine/window/WindowTunnel.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+
+#include <imgui.h>
+
+namespace RenderEngine
+{
+    void WindowUpdateScheduler::addWindow(IWindow& window)
+    {
+        if (std::ranges::find(_windows, &window) != _windows.end())
+        {
+            throw std::runtime_error("Cannot add window to the update scheduler. It is already added.");
+        }
+        Device* device = &window.getDevice();
+        auto lane_it = std::ranges::find(_lanes, device, &Lane::device);
+        if (lane_it == _lanes.end())
+        {
+            _lanes.push_back(Lane{ .device = device });
+            lane_it = std::prev(_lanes.end());
+        }
+        const uint32_t window_index = static_cast<uint32_t>(_windows.size());
+        _windows.push_back(&window);
+        _statistics.push_back(WindowStatistics{ .window = &window,
+                                                .lane_index = static_cast<uint32_t>(std::distance(_lanes.begin(), lane_it)) });
+        lane_it->windows.push_back(window_index);
+    }
+
+    void WindowUpdateScheduler::addTunnel(WindowTunnel& tunnel)
+    {
+        addWindow(tunnel.getOriginWindow());
+        addWindow(tunnel.getDestinationWindow());
+    }
+
+    void WindowUpdateScheduler::update()
+    {
+        const auto update_start = std::chrono::steady_clock::now();
+
+        // The OS windows are used only here, no lane is running yet
+        for (IWindow* window : _windows)
+        {
+            window->handleEvents();
+        }
+
+        JobSystem::Counter counter;
+        for (const Lane& lane : _lanes)
+        {
+            _job_system.submit([this, &lane] { updateLane(lane); }, &counter);
+        }
+        // This thread renders lanes too while it waits
+        _job_system.wait(counter);
+
+        _update_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - update_start);
+    }
+
+    std::chrono::microseconds WindowUpdateScheduler::getFrameTime(const IWindow& window) const
+    {
+        auto it = std::ranges::find(_statistics, &window, &WindowStatistics::window);
+        assert(it != _statistics.end() && "Window is not added to the update scheduler");
+        return it->frame_time;
+    }
+
+    void WindowUpdateScheduler::onGui() const
+    {
+        ImGui::Begin("Window Updates");
+        ImGui::Text("Update time: %.2f ms", _update_time.count() / 1000.0);
+        if (ImGui::BeginTable("Windows", 3, ImGuiTableFlags_Borders))
+        {
+            ImGui::TableSetupColumn("Window");
+            ImGui::TableSetupColumn("Lane");
+            ImGui::TableSetupColumn("Frame time");
+            ImGui::TableHeadersRow();
+            for (uint32_t i = 0; i < _statistics.size(); ++i)
+            {
+                const WindowStatistics& window = _statistics[i];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", i);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", window.lane_index);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f ms", window.frame_time.count() / 1000.0);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+    }
+
+    void WindowUpdateScheduler::updateLane(const Lane& lane)
+    {
+        // The frames of the lane are submitted together when its last window is updated
+        FrameScheduler::Batch batch = lane.device->getFrameScheduler().createBatch();
+        for (size_t i = 0; i < lane.windows.size(); ++i)
+        {
+            const uint32_t window_index = lane.windows[i];
+            const auto frame_start = std::chrono::steady_clock::now();
+            try
+            {
+                _windows[window_index]->render();
+            }
+            catch (...)
+            {
+                // The next frames of the windows updated before wait for the fences of the frames held by the batch
+                batch.submit();
+                throw;
+            }
+            if (i + 1 == lane.windows.size())
+            {
+                batch.submit();
+            }
+            // Every window has its own statistics, the lanes don't write the same element
+            _statistics[window_index].frame_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - frame_start);
+        }
+    }
+}